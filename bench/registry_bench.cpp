@@ -0,0 +1,86 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Measures registry read throughput with concurrent readers and a single writer publishing new versions.
+// Usage: semver_registry_bench [reader threads] [seconds]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <versioning/semver/2_0_0/registry.h>
+
+using namespace vsn::semver;
+
+int main(int argc, char* argv[]) {
+    const int readers = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 2;
+    const int packages = 1000;
+
+    Registry reg;
+    std::vector<std::string> names;
+    for (int p = 0; p < packages; ++p) {
+        names.push_back("package-" + std::to_string(p));
+        std::vector<Version> versions;
+        for (int i = 0; i < 50; ++i) versions.emplace_back(vsn::VersionData{ i / 10, i % 10, 0, {}, {} });
+        reg.Publish(names.back(), std::move(versions));
+    }
+
+    std::atomic<bool> done{ false };
+    std::atomic<unsigned long long> reads{ 0 }, writes{ 0 };
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            unsigned long long n = 0;
+            size_t p = static_cast<size_t>(r);
+            while (!done.load(std::memory_order_relaxed)) {
+                auto snap = reg.Read();
+                if (!snap.LatestInMajor(names[p], 2)) std::abort();
+                p = (p + 7) % names.size();
+                ++n;
+            }
+            reads += n;
+        });
+    }
+    threads.emplace_back([&] {
+        unsigned long long n = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            reg.Publish(names[n % names.size()], Version(vsn::VersionData{ 5, static_cast<int>(n), 0, {}, {} }));
+            ++n;
+        }
+        writes += n;
+    });
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    done.store(true);
+    for (auto& t : threads) t.join();
+
+    std::cout << "readers: " << readers << "\n"
+              << "reads/s: " << reads.load() / seconds << "\n"
+              << "writes/s: " << writes.load() / seconds << std::endl;
+    return 0;
+}
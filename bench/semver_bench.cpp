@@ -0,0 +1,543 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Micro-benchmarks of library hot paths over several corpora of version strings.
+//
+// Usage: semver_bench [--filter TEXT] [--min-time SECONDS] [--corpus-size N] [--json FILE|-] [--baseline FILE]
+//                     [--max-regression PCT]
+//
+// Corpora (releases, prereleases, versions with build metadata, a realistic mix, and malformed strings) are made
+// by CorpusGenerator with fixed seeds; --corpus-size sets number of versions in each, at least 2.
+//
+// Every benchmark reports time and heap allocations per operation (parsing, comparing, formatting, ... one
+// version; for sorting, per sorted version) and throughput in operations per second.
+// --json writes results in machine-readable form, which can later be passed back as --baseline to print the
+// change against an earlier run; with --json -, results go to standard output and the table to standard error.
+// With --max-regression, exit code is 2 if any benchmark got slower by more than given percentage.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/deduplicator.h>
+#include <versioning/semver/2_0_0/merge.h>
+#include <versioning/semver/2_0_0/packed_version_list.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/top_versions.h>
+#include <versioning/semver/2_0_0/validator.h>
+#include <versioning/semver/2_0_0/version_filter.h>
+#include <versioning/semver/2_0_0/version.h>
+#include <versioning/semver/2_0_0/version_diff.h>
+#include <versioning/semver/2_0_0/wire.h>
+#include <versioning/versioning_c.h>
+#include "../src/exceptions.h"
+#include "alloc_hooks.h"
+
+namespace {
+    using namespace vsn::semver;
+    using Clock = std::chrono::steady_clock;
+
+    // Keep the compiler from optimizing away a value computed by benchmark.
+    template<typename T>
+    void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(&value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    struct Result {
+        std::string name;
+        double ns_per_op;
+        double allocs_per_op;
+        double ops_per_sec;
+    };
+
+    struct Options {
+        std::string filter;
+        double min_time = 0.2;
+        std::string json;
+        std::string baseline;
+        double max_regression = -1;
+        size_t corpus_size = 10000;
+    };
+
+    // Benchmark body processes a whole corpus on every call; results are reported per item.
+    struct Benchmark {
+        std::string name;
+        size_t items;
+        std::function<void()> run;
+    };
+
+    Result measure(const Benchmark& b, double min_time) {
+        b.run(); // warm up caches and lazily initialized statics
+
+        size_t iterations = 1;
+        double best = 0;
+        for (int rep = 0; rep < 3; ++rep) {
+            double elapsed;
+            for (;;) {
+                auto start = Clock::now();
+                for (size_t i = 0; i < iterations; ++i) b.run();
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                if (elapsed >= min_time / 3) break;
+                iterations *= 2;
+            }
+            double ns = elapsed * 1e9 / (iterations * b.items);
+            if (rep == 0 || ns < best) best = ns;
+        }
+
+        size_t before = vsn::bench::Allocations();
+        b.run();
+        double allocs = static_cast<double>(vsn::bench::Allocations() - before) / b.items;
+
+        return Result{ b.name, best, allocs, 1e9 / best };
+    }
+
+    // Corpora of version strings, generated with fixed seed so every run measures the same input.
+    std::map<std::string, std::vector<std::string>> make_corpora(size_t n) {
+        std::map<std::string, CorpusProfile> profiles;
+        CorpusProfile release;
+        release.prerelease_share = 0;
+        release.build_share = 0;
+        profiles["release"] = release;
+
+        CorpusProfile prerelease = release;
+        prerelease.prerelease_share = 1;
+        profiles["prerelease"] = prerelease;
+
+        CorpusProfile build = release;
+        build.build_share = 1;
+        profiles["build"] = build;
+
+        profiles["mixed"] = CorpusProfile();
+
+        CorpusProfile invalid;
+        invalid.malformed_share = 1;
+        profiles["invalid"] = invalid;
+
+        std::map<std::string, std::vector<std::string>> corpora;
+        for (const auto& p : profiles) corpora[p.first] = CorpusGenerator(p.second).Generate(n);
+        return corpora;
+    }
+
+    std::vector<Benchmark> make_benchmarks(const std::map<std::string, std::vector<std::string>>& corpora) {
+        static const Parser parser;
+        static const Comparator comparator;
+        std::vector<Benchmark> res;
+
+        for (const auto& c : corpora) {
+            const auto& strings = c.second;
+            res.push_back({ "validate/" + c.first, strings.size(), [&strings] {
+                size_t valid = 0;
+                for (const auto& s : strings) valid += parser.IsValid(s.data(), s.size());
+                keep(valid);
+            } });
+            auto manifest = std::make_shared<std::string>();
+            for (const auto& s : strings) *manifest += s + "\n";
+            res.push_back({ "validate/bulk/" + c.first, strings.size(), [manifest] {
+                keep(BulkValidator().Validate(manifest->data(), manifest->size()));
+            } });
+            if (c.first == "invalid") {
+                res.push_back({ "parse/invalid", strings.size(), [&strings] {
+                    for (const auto& s : strings) {
+                        try {
+                            keep(parser.Parse(s));
+                        }
+                        catch (const vsn::ParseError&) {}
+                    }
+                } });
+                continue;
+            }
+
+            auto data = std::make_shared<std::vector<vsn::VersionData>>();
+            auto versions = std::make_shared<std::vector<Version>>();
+            for (const auto& s : strings) {
+                data->push_back(parser.Parse(s));
+                versions->emplace_back(s);
+            }
+
+            res.push_back({ "parse/" + c.first, strings.size(), [&strings] {
+                for (const auto& s : strings) keep(parser.Parse(s));
+            } });
+            res.push_back({ "compare/" + c.first, data->size() - 1, [data] {
+                int sum = 0;
+                for (size_t i = 1; i < data->size(); ++i) sum += comparator.Compare((*data)[i - 1], (*data)[i]);
+                keep(sum);
+            } });
+            // Same versions in binary encoding, concatenated into one buffer.
+            auto encoded = std::make_shared<std::vector<uint8_t>>();
+            auto views = std::make_shared<std::vector<vsn::semver::WireVersion>>();
+            for (const auto& d : *data) vsn::semver::Encode(d, *encoded);
+            for (size_t at = 0; at != encoded->size(); at += views->back().Size()) {
+                views->emplace_back(encoded->data() + at, encoded->size() - at);
+            }
+            for (bool reuse : { false, true }) {
+                res.push_back({ std::string(reuse ? "decode/reuse/" : "decode/") + c.first, data->size(),
+                                [encoded, reuse] {
+                    const uint8_t* p = encoded->data();
+                    size_t left = encoded->size();
+                    vsn::VersionData d;
+                    while (left) {
+                        size_t consumed;
+                        if (reuse) vsn::semver::Decode(p, left, d, &consumed);
+                        else d = vsn::semver::Decode(p, left, &consumed);
+                        keep(d);
+                        p += consumed;
+                        left -= consumed;
+                    }
+                } });
+            }
+            res.push_back({ "compare/wire/" + c.first, views->size() - 1, [views] {
+                int sum = 0;
+                for (size_t i = 1; i < views->size(); ++i) {
+                    sum += vsn::semver::WireVersion::Compare((*views)[i - 1], (*views)[i]);
+                }
+                keep(sum);
+            } });
+            // Same through the C interface, one call for the whole corpus.
+            auto cstrings = std::make_shared<std::vector<vsn_string>>();
+            for (const auto& s : strings) cstrings->push_back(vsn_string{ s.data(), s.size() });
+            auto cparsed = std::make_shared<std::vector<vsn_version>>(cstrings->size());
+            res.push_back({ "capi/parse/" + c.first, cstrings->size(), [cstrings, cparsed] {
+                keep(vsn_parse(cstrings->data(), cstrings->size(), cparsed->data(), nullptr));
+            } });
+            auto cresults = std::make_shared<std::vector<int32_t>>(cstrings->size());
+            res.push_back({ "capi/compare/" + c.first, cstrings->size() - 1, [cstrings, cresults] {
+                keep(vsn_compare(cstrings->data(), cstrings->data() + 1, cstrings->size() - 1, cresults->data(),
+                        nullptr));
+            } });
+            // Sorted history in delta-compressed form: sequential decoding and random access through block index.
+            auto packed = std::make_shared<vsn::semver::PackedVersionList>(*data);
+            res.push_back({ "packed/iterate/" + c.first, packed->Size(), [packed] {
+                int sum = 0;
+                for (const auto& v : *packed) sum += v.patch;
+                keep(sum);
+            } });
+            res.push_back({ "packed/at/" + c.first, packed->Size() / 16, [packed] {
+                int sum = 0;
+                for (size_t i = 0; i < packed->Size(); i += 16) sum += packed->At((i * 7919) % packed->Size()).patch;
+                keep(sum);
+            } });
+            // Diff of sorted snapshots differing in every tenth version, per version of the older snapshot.
+            auto before = std::make_shared<std::vector<vsn::VersionData>>(*data);
+            std::sort(before->begin(), before->end(), vsn::semver::VersionOrder());
+            auto after = std::make_shared<std::vector<vsn::VersionData>>();
+            for (size_t i = 0; i < before->size(); ++i) {
+                if (i % 10) after->push_back((*before)[i]);
+            }
+            res.push_back({ "diff/" + c.first, before->size(), [before, after] {
+                size_t changes = 0;
+                auto count = [&changes](const vsn::VersionData&) { ++changes; };
+                vsn::semver::Diff(before->begin(), before->end(), after->begin(), after->end(), count, count);
+                keep(changes);
+            } });
+            res.push_back({ "diff/parallel/" + c.first, before->size(), [before, after] {
+                std::atomic<size_t> changes{ 0 };
+                auto count = [&changes](size_t, const vsn::VersionData&) { ++changes; };
+                vsn::semver::ParallelDiff(*before, *after, count, count);
+                keep(changes.load());
+            } });
+            res.push_back({ "dedup/" + c.first, strings.size(), [&strings] {
+                VersionDeduplicator d;
+                for (const auto& s : strings) d.Add(s);
+                keep(d.Distinct());
+            } });
+            auto seen = std::make_shared<VersionDeduplicator>();
+            for (const auto& s : strings) seen->Add(s);
+            res.push_back({ "dedup/repeat/" + c.first, strings.size(), [&strings, seen] {
+                for (const auto& s : strings) keep(seen->Add(s));
+            } });
+            // Change from each version to the next one, classified by accessors and operator<, or by Diff.
+            res.push_back({ "classify/accessors/" + c.first, versions->size() - 1, [versions] {
+                size_t upgrades = 0;
+                for (size_t i = 1; i < versions->size(); ++i) {
+                    const auto& f = (*versions)[i - 1];
+                    const auto& t = (*versions)[i];
+                    VersionDiff d;
+                    if (t < f) d = VersionDiff::downgrade;
+                    else if (t.Major() != f.Major()) d = VersionDiff::major;
+                    else if (t.Minor() != f.Minor()) d = VersionDiff::minor;
+                    else if (t.Patch() != f.Patch()) d = VersionDiff::patch;
+                    else if (f < t) d = VersionDiff::prerelease;
+                    else d = f.Build() == t.Build() ? VersionDiff::none : VersionDiff::build;
+                    upgrades += d != VersionDiff::downgrade;
+                }
+                keep(upgrades);
+            } });
+            res.push_back({ "classify/" + c.first, data->size() - 1, [data] {
+                size_t upgrades = 0;
+                for (size_t i = 1; i < data->size(); ++i) {
+                    upgrades += Diff((*data)[i - 1], (*data)[i]) != VersionDiff::downgrade;
+                }
+                keep(upgrades);
+            } });
+            auto diffs = std::make_shared<std::vector<VersionDiff>>(data->size());
+            res.push_back({ "classify/batch/" + c.first, data->size() - 1, [data, diffs] {
+                Diff(data->data(), data->data() + 1, data->size() - 1, diffs->data());
+                keep(*diffs);
+            } });
+            // 100 newest versions, selected in one pass or by sorting everything and taking the tail.
+            res.push_back({ "topk/" + c.first, data->size(), [data] {
+                TopVersions top(100);
+                for (const auto& v : *data) top.Add(v);
+                keep(top.Size());
+            } });
+            res.push_back({ "topk/sort/" + c.first, data->size(), [data] {
+                auto all = *data;
+                std::sort(all.begin(), all.end(), [](const vsn::VersionData& l, const vsn::VersionData& r) {
+                    return comparator.Compare(l, r) < 0;
+                });
+                all.erase(all.begin(), all.end() - std::min<size_t>(100, all.size()));
+                keep(all);
+            } });
+            res.push_back({ "sort/" + c.first, versions->size(), [versions] {
+                std::vector<const Version*> order;
+                order.reserve(versions->size());
+                for (const auto& v : *versions) order.push_back(&v);
+                std::sort(order.begin(), order.end(), [](const Version* l, const Version* r) { return *l < *r; });
+                keep(order);
+            } });
+            // Same sort without virtual calls; with VERSIONING_HEADER_ONLY, Comparator is inlined too.
+            auto statics = std::make_shared<std::vector<vsn::semver::StaticVersion>>();
+            for (const auto& d : *data) statics->emplace_back(d);
+            res.push_back({ "sort/static/" + c.first, statics->size(), [statics] {
+                std::vector<const vsn::semver::StaticVersion*> order;
+                order.reserve(statics->size());
+                for (const auto& v : *statics) order.push_back(&v);
+                std::sort(order.begin(), order.end(), [](const vsn::semver::StaticVersion* l,
+                        const vsn::semver::StaticVersion* r) { return *l < *r; });
+                keep(order);
+            } });
+            res.push_back({ "accessors/" + c.first, versions->size(), [versions] {
+                int sum = 0;
+                for (const auto& v : *versions) sum += v.Major() + v.Minor() + v.Patch();
+                keep(sum);
+            } });
+            // Copy of all versions; with VERSIONING_SHARED_PAYLOAD copies share data instead of duplicating it.
+            res.push_back({ "copy/" + c.first, versions->size(), [versions] {
+                std::vector<Version> copies(*versions);
+                keep(copies);
+            } });
+            res.push_back({ "modify/chain/" + c.first, versions->size(), [versions] {
+                for (const auto& v : *versions) keep(v.IncMinor().SetPreRelease("rc.1").SetBuild("ci.7"));
+            } });
+            res.push_back({ "modify/builder/" + c.first, versions->size(), [versions] {
+                for (const auto& v : *versions) keep(VersionBuilder(v).IncMinor().SetPreRelease("rc.1").SetBuild("ci.7").Build());
+            } });
+
+            // Versions built from data have no source text to reuse, so those are formatted from components.
+            auto built = std::make_shared<std::vector<Version>>();
+            for (const auto& d : *data) built->emplace_back(d);
+            for (auto source : { std::make_pair("parsed", versions), std::make_pair("built", built) }) {
+                auto vs = source.second;
+                res.push_back({ std::string("format/") + source.first + "/" + c.first, vs->size(), [vs] {
+                    static std::ostringstream os;
+                    for (const auto& v : *vs) {
+                        os.seekp(0);
+                        os << v;
+                    }
+                    keep(os);
+                } });
+            }
+
+            // Near-semver text, coerced in one pass or through the usual strip-pad-retry loop around Parse.
+            if (c.first != "mixed") continue;
+            static const CoercingParser coercing;
+            auto loose = std::make_shared<std::vector<std::string>>();
+            for (size_t i = 0; i < data->size(); ++i) {
+                const auto& d = (*data)[i];
+                const auto numbers = std::to_string(d.major) + "." + std::to_string(d.minor);
+                const char* forms[] = { "v", "", " ", "release-" };
+                loose->push_back(forms[i % 4] + numbers + (i % 4 == 2 ? "." + std::to_string(d.patch) + " " : ""));
+            }
+            for (auto input : { std::make_pair("mixed", std::make_shared<std::vector<std::string>>(strings)),
+                                std::make_pair("loose", loose) }) {
+                auto texts = input.second;
+                res.push_back({ std::string("coerce/") + input.first, texts->size(), [texts] {
+                    CoercedVersion out;
+                    for (const auto& s : *texts) {
+                        coercing.TryCoerce(s, out);
+                        keep(out);
+                    }
+                } });
+                res.push_back({ std::string("coerce/retry/") + input.first, texts->size(), [texts] {
+                    for (auto s : *texts) {
+                        for (int attempt = 0; attempt < 4; ++attempt) {
+                            try {
+                                keep(parser.Parse(s));
+                                break;
+                            }
+                            catch (const vsn::ParseError&) {
+                                const auto first = s.find_first_of("0123456789");
+                                const auto last = s.find_last_not_of(' ');
+                                if (first != 0 || last + 1 != s.size()) s = s.substr(first, last + 1 - first);
+                                else s += ".0";
+                            }
+                        }
+                    }
+                } });
+            }
+
+            // Membership probes of filter built from half of the versions: half of the probes are misses.
+            VersionFilterBuilder builder;
+            auto packages = std::make_shared<std::vector<std::string>>();
+            auto hashes = std::make_shared<std::vector<uint64_t>>();
+            for (size_t i = 0; i < data->size(); ++i) {
+                packages->push_back("pkg" + std::to_string(i % 100));
+                if (i % 2) builder.Add(packages->back(), (*data)[i]);
+                hashes->push_back(VersionFilter::Hash(packages->back(), (*data)[i]));
+            }
+            auto filter = std::make_shared<VersionFilter>(builder.Build());
+            res.push_back({ "filter/probe/" + c.first, strings.size(), [&strings, packages, filter] {
+                size_t found = 0;
+                for (size_t i = 0; i < strings.size(); ++i) found += filter->MayContain((*packages)[i], strings[i]);
+                keep(found);
+            } });
+            res.push_back({ "filter/hash/" + c.first, hashes->size(), [hashes, filter] {
+                size_t found = 0;
+                for (const uint64_t h : *hashes) found += filter->MayContain(h);
+                keep(found);
+            } });
+            res.push_back({ "filter/batch/" + c.first, hashes->size(), [hashes, filter] {
+                std::unique_ptr<bool[]> found(new bool[hashes->size()]);
+                filter->MayContain(hashes->data(), hashes->size(), found.get());
+                keep(found);
+            } });
+        }
+        return res;
+    }
+
+    void write_json(std::ostream& os, const std::vector<Result>& results) {
+        os.unsetf(std::ios::floatfield);
+        os << std::setprecision(6) << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            os << "    {\"name\": \"" << r.name << "\", \"ns_per_op\": " << r.ns_per_op
+               << ", \"allocs_per_op\": " << r.allocs_per_op << ", \"ops_per_sec\": " << r.ops_per_sec << "}"
+               << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        os << "  ]\n}\n";
+    }
+
+    // Read ns_per_op of every benchmark from a file written by write_json.
+    std::map<std::string, double> read_baseline(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("cannot read baseline " + path);
+        std::stringstream ss;
+        ss << in.rdbuf();
+        const std::string text = ss.str();
+
+        std::map<std::string, double> res;
+        const std::string name_key = "\"name\": \"", ns_key = "\"ns_per_op\": ";
+        for (size_t pos = text.find(name_key); pos != std::string::npos; pos = text.find(name_key, pos)) {
+            pos += name_key.size();
+            size_t end = text.find('"', pos);
+            size_t ns = text.find(ns_key, end);
+            if (end == std::string::npos || ns == std::string::npos) break;
+            res[text.substr(pos, end - pos)] = std::strtod(text.c_str() + ns + ns_key.size(), nullptr);
+        }
+        return res;
+    }
+
+    Options parse_args(int argc, char* argv[]) {
+        Options o;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) throw std::runtime_error("missing value for " + arg);
+            std::string value = argv[++i];
+            if (arg == "--filter") o.filter = value;
+            else if (arg == "--min-time") o.min_time = std::atof(value.c_str());
+            else if (arg == "--json") o.json = value;
+            else if (arg == "--baseline") o.baseline = value;
+            else if (arg == "--max-regression") o.max_regression = std::atof(value.c_str());
+            else if (arg == "--corpus-size") o.corpus_size = std::strtoull(value.c_str(), nullptr, 10);
+            else throw std::runtime_error("unknown option " + arg);
+        }
+        // Several benchmarks work on pairs or halves of a corpus.
+        if (o.corpus_size < 2) throw std::runtime_error("--corpus-size must be at least 2");
+        return o;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    std::map<std::string, double> baseline;
+    try {
+        options = parse_args(argc, argv);
+        if (!options.baseline.empty()) baseline = read_baseline(options.baseline);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    const auto corpora = make_corpora(options.corpus_size);
+    std::vector<Result> results;
+    bool regressed = false;
+
+    // Keep standard output to JSON alone when it is written there.
+    std::ostream& table = options.json == "-" ? std::cerr : std::cout;
+    table << std::left << std::setw(32) << "benchmark" << std::right << std::setw(14) << "ns/op"
+              << std::setw(12) << "allocs/op" << std::setw(14) << "ops/s";
+    if (!baseline.empty()) table << std::setw(14) << "baseline" << std::setw(10) << "change";
+    table << "\n" << std::fixed;
+
+    for (const auto& b : make_benchmarks(corpora)) {
+        if (b.name.find(options.filter) == std::string::npos) continue;
+        auto r = measure(b, options.min_time);
+        results.push_back(r);
+
+        table << std::left << std::setw(32) << r.name << std::right << std::setprecision(1) << std::setw(14)
+                  << r.ns_per_op << std::setprecision(3) << std::setw(12) << r.allocs_per_op
+                  << std::setprecision(0) << std::setw(14) << r.ops_per_sec;
+        auto base = baseline.find(r.name);
+        if (base != baseline.end() && base->second > 0) {
+            double change = (r.ns_per_op / base->second - 1) * 100;
+            if (options.max_regression >= 0 && change > options.max_regression) regressed = true;
+            table << std::setprecision(1) << std::setw(14) << base->second << std::setw(9) << std::showpos
+                      << change << std::noshowpos << "%";
+        }
+        table << std::endl;
+    }
+
+    if (options.json == "-") write_json(std::cout, results);
+    else if (!options.json.empty()) {
+        std::ofstream out(options.json);
+        write_json(out, results);
+    }
+    return regressed ? 2 : 0;
+}
@@ -0,0 +1,357 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+#include <versioning/semver/2_0_0/constexpr_version.h>
+#include <versioning/semver/2_0_0/modifier.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/versioning_c.h>
+#include "../src/canonical.h"
+#include "../src/exceptions.h"
+
+using namespace vsn;
+
+namespace {
+    const semver::Parser parser;
+    const semver::Modifier modifier;
+
+    static_assert(parse_error_reason_count == VSN_ERROR_OVERFLOW, "every ParseErrorReason must have vsn_error");
+
+    inline vsn_error error_of(const ParseErrorReason reason) {
+        return static_cast<vsn_error>(reason) + VSN_ERROR_OTHER;
+    }
+
+    // Run body of an entry point, turning exceptions into status.
+    template<typename F>
+    vsn_status guard(F f) {
+        try {
+            return f();
+        } catch (const std::bad_alloc&) {
+            return VSN_OUT_OF_MEMORY;
+        } catch (...) {
+            return VSN_INTERNAL_ERROR;
+        }
+    }
+
+    inline bool valid_string(const vsn_string& s) {
+        return s.data || !s.size;
+    }
+
+    inline bool valid_strings(const vsn_string* s, const size_t n) {
+        if (n && !s) return false;
+        for (size_t i = 0; i < n; ++i) {
+            if (!valid_string(s[i])) return false;
+        }
+        return true;
+    }
+
+    inline bool validate(const vsn_string& s, vsn_error& error) {
+        ParseErrorReason reason = ParseErrorReason::other;
+        const bool ok = parser.IsValid(s.data, s.size, reason);
+        error = ok ? VSN_ERROR_NONE : error_of(reason);
+        return ok;
+    }
+
+    inline void set_error(vsn_error* errors, const size_t i, const vsn_error error) {
+        if (errors) errors[i] = error;
+    }
+
+    inline int32_t read_number(const char*& p, const char* end) {
+        int32_t v = 0;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) v = v * 10 + (*p - '0');
+        return v;
+    }
+
+    // Split text already validated by Parser into parts.
+    void split(const vsn_string& s, vsn_version& v) {
+        const char* p = s.data;
+        const char* end = s.data + s.size;
+        v.major = read_number(p, end);
+        ++p;
+        v.minor = read_number(p, end);
+        ++p;
+        v.patch = read_number(p, end);
+        const char* plus = std::find(p, end, '+');
+        v.prerelease = vsn_string{ nullptr, 0 };
+        v.build = vsn_string{ nullptr, 0 };
+        if (p != end && *p == '-') v.prerelease = vsn_string{ p + 1, static_cast<size_t>(plus - p - 1) };
+        if (plus != end) v.build = vsn_string{ plus + 1, static_cast<size_t>(end - plus - 1) };
+    }
+
+    // Parse text to view for comparison, storing error of invalid one. ConstexprVersion rejects the same texts as
+    // Parser, for the same reasons, so this scans valid text only once.
+    inline bool view(const vsn_string& s, semver::ConstexprVersion& v, vsn_error& error) {
+        try {
+            v = semver::ConstexprVersion(s.data, s.size);
+        } catch (const ParseError& e) {
+            error = error_of(e.Reason());
+            return false;
+        }
+        error = VSN_ERROR_NONE;
+        return true;
+    }
+
+    // Writes texts one after another to caller's buffer; once one does not fit, no more are written.
+    class Output {
+    public:
+        Output(char* buffer, const size_t capacity, vsn_string* texts)
+                : buffer_{ buffer }, capacity_{ capacity }, texts_{ texts } {}
+
+        void Write(const size_t i, const std::string& s) {
+            if (fits_ && s.size() <= capacity_ - used_) {
+                if (!s.empty()) std::memcpy(buffer_ + used_, s.data(), s.size());
+                texts_[i] = vsn_string{ buffer_ + used_, s.size() };
+            } else {
+                fits_ = false;
+                texts_[i] = vsn_string{ nullptr, 0 };
+            }
+            used_ += s.size();
+        }
+
+        void Skip(const size_t i) {
+            texts_[i] = vsn_string{ nullptr, 0 };
+        }
+
+        vsn_status Finish(size_t* required, const size_t invalid) const {
+            if (required) *required = used_;
+            if (!fits_) return VSN_BUFFER_TOO_SMALL;
+            return invalid ? VSN_INVALID_INPUT : VSN_OK;
+        }
+
+    private:
+        char* buffer_;
+        size_t capacity_;
+        vsn_string* texts_;
+        size_t used_ = 0;
+        bool fits_ = true;
+    };
+
+    inline void append(std::string& s, const char c, const vsn_string& ids) {
+        if (!ids.size) return;
+        s += c;
+        s.append(ids.data, ids.size);
+    }
+
+    // Apply operation to valid version, returning false if the modifier rejects it.
+    bool modify(VersionData& d, const vsn_operation operation, const Prerelease_identifiers& prerelease,
+            const Build_identifiers& build) {
+        try {
+            switch (operation) {
+                case VSN_INC_MAJOR:
+                    if (d.major == INT_MAX) return false;
+                    d = modifier.ResetMajor(std::move(d), d.major + 1);
+                    break;
+                case VSN_INC_MINOR:
+                    if (d.minor == INT_MAX) return false;
+                    d = modifier.ResetMinor(std::move(d), d.minor + 1);
+                    break;
+                case VSN_INC_PATCH:
+                    if (d.patch == INT_MAX) return false;
+                    d = modifier.ResetPatch(std::move(d), d.patch + 1);
+                    break;
+                case VSN_INC_PRERELEASE:
+                    d = modifier.IncPreRelease(std::move(d));
+                    break;
+                case VSN_SET_PRERELEASE:
+                    d = modifier.ResetPreRelease(std::move(d), prerelease);
+                    break;
+                default:
+                    d = modifier.SetBuild(std::move(d), build);
+                    break;
+            }
+        } catch (const ModificationError&) {
+            return false;
+        }
+        return true;
+    }
+}
+
+extern "C" {
+    int32_t vsn_abi_version(void) {
+        return VSN_ABI_VERSION;
+    }
+
+    const char* vsn_status_name(const vsn_status status) {
+        switch (status) {
+            case VSN_OK: return "ok";
+            case VSN_INVALID_INPUT: return "invalid_input";
+            case VSN_BUFFER_TOO_SMALL: return "buffer_too_small";
+            case VSN_INVALID_ARGUMENT: return "invalid_argument";
+            case VSN_OUT_OF_MEMORY: return "out_of_memory";
+            case VSN_INTERNAL_ERROR: return "internal_error";
+            default: return "unknown";
+        }
+    }
+
+    const char* vsn_error_name(const vsn_error error) {
+        if (error == VSN_ERROR_NONE) return "none";
+        if (error == VSN_ERROR_MODIFICATION) return "modification";
+        if (error < VSN_ERROR_OTHER || error > VSN_ERROR_OVERFLOW) return "unknown";
+        return ToString(static_cast<ParseErrorReason>(error - VSN_ERROR_OTHER));
+    }
+
+    vsn_status vsn_parse(const vsn_string* texts, const size_t n, vsn_version* versions, vsn_error* errors) {
+        if (!valid_strings(texts, n)) return VSN_INVALID_ARGUMENT;
+        return guard([&] {
+            size_t invalid = 0;
+            for (size_t i = 0; i < n; ++i) {
+                vsn_error error;
+                if (validate(texts[i], error)) {
+                    if (versions) split(texts[i], versions[i]);
+                } else {
+                    ++invalid;
+                }
+                set_error(errors, i, error);
+            }
+            return invalid ? VSN_INVALID_INPUT : VSN_OK;
+        });
+    }
+
+    vsn_status vsn_compare(const vsn_string* left, const vsn_string* right, const size_t n, int32_t* results,
+            vsn_error* errors) {
+        if (!valid_strings(left, n) || !valid_strings(right, n) || (n && !results)) return VSN_INVALID_ARGUMENT;
+        return guard([&] {
+            size_t invalid = 0;
+            for (size_t i = 0; i < n; ++i) {
+                vsn_error l, r;
+                semver::ConstexprVersion lv = "0.0.0", rv = "0.0.0";
+                const bool lok = view(left[i], lv, l);
+                const bool rok = view(right[i], rv, r);
+                if (lok && rok) {
+                    const int cmp = semver::ConstexprVersion::Compare(lv, rv);
+                    results[i] = (cmp > 0) - (cmp < 0);
+                } else {
+                    results[i] = 0;
+                    ++invalid;
+                }
+                set_error(errors, i, lok ? r : l);
+            }
+            return invalid ? VSN_INVALID_INPUT : VSN_OK;
+        });
+    }
+
+    vsn_status vsn_sort(const vsn_string* texts, const size_t n, size_t* order, vsn_error* errors) {
+        if (!valid_strings(texts, n) || (n && !order)) return VSN_INVALID_ARGUMENT;
+        return guard([&] {
+            std::vector<std::pair<semver::ConstexprVersion, size_t>> valid;
+            std::vector<size_t> invalid;
+            valid.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                vsn_error error;
+                semver::ConstexprVersion v = "0.0.0";
+                if (view(texts[i], v, error)) valid.emplace_back(v, i);
+                else invalid.push_back(i);
+                set_error(errors, i, error);
+            }
+            using Entry = std::pair<semver::ConstexprVersion, size_t>;
+            std::stable_sort(valid.begin(), valid.end(), [](const Entry& l, const Entry& r) {
+                return l.first < r.first;
+            });
+            size_t k = 0;
+            for (const auto& v : valid) order[k++] = v.second;
+            for (const size_t i : invalid) order[k++] = i;
+            return invalid.empty() ? VSN_OK : VSN_INVALID_INPUT;
+        });
+    }
+
+    vsn_status vsn_format(const vsn_version* versions, const size_t n, char* buffer, const size_t capacity,
+            vsn_string* texts, size_t* required, vsn_error* errors) {
+        if ((n && (!versions || !texts)) || (capacity && !buffer)) return VSN_INVALID_ARGUMENT;
+        for (size_t i = 0; i < n; ++i) {
+            if (!valid_string(versions[i].prerelease) || !valid_string(versions[i].build)) return VSN_INVALID_ARGUMENT;
+        }
+        return guard([&] {
+            Output out(buffer, capacity, texts);
+            size_t invalid = 0;
+            std::string s;
+            for (size_t i = 0; i < n; ++i) {
+                const vsn_version& v = versions[i];
+                s = std::to_string(v.major);
+                s += '.';
+                s += std::to_string(v.minor);
+                s += '.';
+                s += std::to_string(v.patch);
+                append(s, '-', v.prerelease);
+                append(s, '+', v.build);
+                vsn_error error;
+                if (validate(vsn_string{ s.data(), s.size() }, error)) {
+                    out.Write(i, s);
+                } else {
+                    out.Skip(i);
+                    ++invalid;
+                }
+                set_error(errors, i, error);
+            }
+            return out.Finish(required, invalid);
+        });
+    }
+
+    vsn_status vsn_modify(const vsn_string* texts, const size_t n, const vsn_operation operation,
+            const vsn_string argument, char* buffer, const size_t capacity, vsn_string* results, size_t* required,
+            vsn_error* errors) {
+        if (!valid_strings(texts, n) || (n && !results) || (capacity && !buffer) || !valid_string(argument)) {
+            return VSN_INVALID_ARGUMENT;
+        }
+        if (operation < VSN_INC_MAJOR || operation > VSN_SET_BUILD) return VSN_INVALID_ARGUMENT;
+        return guard([&] {
+            Prerelease_identifiers prerelease;
+            Build_identifiers build;
+            const std::string arg(argument.data ? argument.data : "", argument.size);
+            try {
+                if (operation == VSN_SET_PRERELEASE && !arg.empty()) prerelease = parser.ParsePreRelease(arg);
+                if (operation == VSN_SET_BUILD && !arg.empty()) build = parser.ParseBuild(arg);
+            } catch (const ParseError&) {
+                return VSN_INVALID_ARGUMENT;
+            }
+
+            Output out(buffer, capacity, results);
+            size_t invalid = 0;
+            std::string s;
+            for (size_t i = 0; i < n; ++i) {
+                vsn_error error;
+                if (validate(texts[i], error)) {
+                    VersionData d = parser.Parse(std::string(texts[i].data, texts[i].size));
+                    if (modify(d, operation, prerelease, build)) {
+                        s.clear();
+                        append_canonical(s, d, true);
+                        out.Write(i, s);
+                    } else {
+                        error = VSN_ERROR_MODIFICATION;
+                    }
+                }
+                if (error != VSN_ERROR_NONE) {
+                    out.Skip(i);
+                    ++invalid;
+                }
+                set_error(errors, i, error);
+            }
+            return out.Finish(required, invalid);
+        });
+    }
+}
@@ -8,8 +8,9 @@ class SemverConan(ConanFile):
     url = "https://github.com/santoro-mariano/semver.git"
     description = "Validating semantic versioning (semver) parser and comparator written in C++"
     settings = "os", "compiler", "build_type", "arch"
-    options = {"shared": [True, False]}
-    default_options = "shared=False"
+    options = {"shared": [True, False], "retain_source": [True, False],
+               "shared_payload": [True, False]}
+    default_options = "shared=False", "retain_source=True", "shared_payload=False"
     generators = "cmake"
 
     def source(self):
@@ -25,11 +26,15 @@ conan_basic_setup()''')
 
     def build(self):
         cmake = CMake(self)
+        cmake.definitions["VERSIONING_RETAIN_SOURCE"] = "ON" if self.options.retain_source else "OFF"
+        cmake.definitions["VERSIONING_SHARED_PAYLOAD"] = "ON" if self.options.shared_payload else "OFF"
         cmake.configure(source_dir="%s/semver" % self.source_folder)
         cmake.build()
         
     def package(self):
 	self.copy("*.*", dst="include", src="semver/include")
+        # Generated by CMake in build folder; records options changing layout of version objects.
+        self.copy("config.h", dst="include/versioning", src="include/versioning")
         self.copy("*versioning.lib", dst="lib", keep_path=False)
         self.copy("*.dll", dst="bin", keep_path=False)
         self.copy("*.so", dst="lib", keep_path=False)
@@ -38,3 +43,8 @@ conan_basic_setup()''')
 
     def package_info(self):
         self.cpp_info.libs = ["versioning"]
+        # Same as generated versioning/config.h, for consumers including headers before it.
+        if self.options.retain_source:
+            self.cpp_info.defines.append("VERSIONING_RETAIN_SOURCE=1")
+        if self.options.shared_payload:
+            self.cpp_info.defines.append("VERSIONING_SHARED_PAYLOAD=1")
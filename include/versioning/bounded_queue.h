@@ -0,0 +1,162 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_BOUNDED_QUEUE_H
+#define VERSIONING_BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace vsn {
+
+    /// Bounded lock-free multi-producer, multi-consumer FIFO queue.
+    /**
+    Ring buffer in which every cell carries a sequence number telling producers and consumers whose turn it is,
+    so pushing and popping each take a single compare-and-swap on the queue position. Works equally well with
+    a single producer and consumer.
+
+    Blocking Push() waits while the queue is full, which gives backpressure to producers; blocking Pop() waits
+    while it is empty until the queue is closed.
+    */
+    template<typename T>
+    class BoundedQueue {
+    public:
+        /// Construct queue holding at most capacity elements; capacity is rounded up to a power of two.
+        explicit BoundedQueue(size_t capacity) : mask_{ round_up(capacity) - 1 }, cells_{ new Cell[mask_ + 1] },
+                                                 enqueue_{ 0 }, dequeue_{ 0 }, closed_{ false } {
+            for (size_t i = 0; i <= mask_; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        /// Add value to the queue, unless it is full. Value is left untouched on failure.
+        bool TryPush(T& value) {
+            size_t pos = enqueue_.value.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (dif == 0) {
+                    if (enqueue_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                }
+                else if (dif < 0) return false;
+                else pos = enqueue_.value.load(std::memory_order_relaxed);
+            }
+            cell->value = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Take oldest value from the queue, unless it is empty.
+        bool TryPop(T& value) {
+            size_t pos = dequeue_.value.load(std::memory_order_relaxed);
+            Cell* cell;
+            for (;;) {
+                cell = &cells_[pos & mask_];
+                size_t seq = cell->sequence.load(std::memory_order_acquire);
+                auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                if (dif == 0) {
+                    if (dequeue_.value.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                }
+                else if (dif < 0) return false;
+                else pos = dequeue_.value.load(std::memory_order_relaxed);
+            }
+            value = std::move(cell->value);
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Add value to the queue, waiting for free space if it is full.
+        void Push(T value) {
+            for (unsigned spins = 0; !TryPush(value); ++spins) backoff(spins);
+        }
+
+        /// Take oldest value from the queue, waiting for one if it is empty. False once queue is closed and drained.
+        bool Pop(T& value) {
+            for (unsigned spins = 0; !TryPop(value); ++spins) {
+                if (closed_.load(std::memory_order_acquire)) return TryPop(value);
+                backoff(spins);
+            }
+            return true;
+        }
+
+        /// Signal there will be no more values; called once all producers are done.
+        void Close() {
+            closed_.store(true, std::memory_order_release);
+        }
+
+        /// Get approximate number of values in the queue.
+        size_t Size() const {
+            size_t head = dequeue_.value.load(std::memory_order_relaxed);
+            size_t tail = enqueue_.value.load(std::memory_order_relaxed);
+            return tail > head ? tail - head : 0;
+        }
+
+        /// Get maximum number of values in the queue.
+        size_t Capacity() const {
+            return mask_ + 1;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        static size_t round_up(size_t capacity) {
+            size_t res = 2;
+            while (res < capacity) res <<= 1;
+            return res;
+        }
+
+        // Stay responsive under short waits, but do not burn a core while a neighbouring stage is stalled.
+        static void backoff(unsigned spins) {
+            if (spins < 64) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+
+        // Queue position, padded so producer and consumer positions are kept on separate cache lines.
+        struct Position {
+            explicit Position(size_t pos) : value{ pos } {}
+
+            char padding[64 - sizeof(std::atomic<size_t>)];
+            std::atomic<size_t> value;
+        };
+
+        const size_t mask_;
+        const std::unique_ptr<Cell[]> cells_;
+        Position enqueue_;
+        Position dequeue_;
+        std::atomic<bool> closed_;
+    };
+}
+
+#endif //VERSIONING_BOUNDED_QUEUE_H
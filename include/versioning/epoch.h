@@ -0,0 +1,103 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_EPOCH_H
+#define VERSIONING_EPOCH_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace vsn {
+
+    /// Epoch-based reclamation domain for read-mostly, copy-on-write data structures.
+    /**
+    Readers pin the current epoch with a Guard for as long as they use shared objects; they take no locks
+    and never write to shared objects. Writers replace shared objects atomically and Retire() the old ones,
+    which are destroyed only after every guard that could still observe them has been released.
+
+    Pinning claims one of a fixed number of reader slots with a single compare-and-swap; slot search starts
+    at a per-thread position, so uncontended readers succeed on first attempt.
+    */
+    class EpochDomain {
+    public:
+        /// Maximum number of concurrently pinned guards; more readers than this spin until a slot frees up.
+        static const size_t slot_count = 128;
+
+        /// Pin of the current epoch; objects retired while a guard is alive are not destroyed before it is released.
+        class Guard {
+        public:
+            explicit Guard(EpochDomain& domain);
+            Guard(Guard&& other) noexcept;
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+            Guard& operator=(Guard&&) = delete;
+            ~Guard();
+
+        private:
+            std::atomic<uint64_t>* slot_;
+        };
+
+        EpochDomain();
+        EpochDomain(const EpochDomain&) = delete;
+        EpochDomain& operator=(const EpochDomain&) = delete;
+
+        /// Destroy all retired objects; no guards may be alive at this point.
+        ~EpochDomain();
+
+        /// Schedule object, already unlinked from shared data structure, for destruction.
+        template<typename T>
+        void Retire(const T* obj) {
+            retire(const_cast<T*>(obj), [](void* p) { delete static_cast<T*>(p); });
+        }
+
+        /// Destroy retired objects which can no longer be observed by any reader.
+        void Reclaim();
+
+    private:
+        struct Retired {
+            void* obj;
+            void (*deleter)(void*);
+            uint64_t epoch;
+        };
+
+        // Reader slot, padded to its own cache line. Holds 0 when free, otherwise the epoch reader pinned.
+        struct Slot {
+            std::atomic<uint64_t> epoch;
+            char padding[64 - sizeof(std::atomic<uint64_t>)];
+        };
+
+        void retire(void* obj, void (*deleter)(void*));
+        void reclaim_locked();
+
+        Slot slots_[slot_count];
+        std::atomic<uint64_t> epoch_;
+        std::mutex retired_mutex_;
+        std::vector<Retired> retired_;
+    };
+}
+
+#endif //VERSIONING_EPOCH_H
@@ -25,132 +25,498 @@ SOFTWARE.
 #ifndef VERSIONING_GENERIC_VERSION_H
 #define VERSIONING_GENERIC_VERSION_H
 
+#include <utility>
 #include "read_only_version.h"
+#include "static_read_only_version.h"
 
 namespace vsn {
 
+    /// Dispatch mode tag: versions share ReadOnlyVersion base and are compared through VersionComparator interface.
+    /**
+    This is the default mode; it allows versions of different, possibly plug-in, schemes to be handled
+    through one base type.
+    */
+    struct DynamicDispatch {};
+
+    /// Dispatch mode tag: versions are compared by calling Comparator type directly.
+    /**
+    Versions carry no comparator pointer and comparisons involve no virtual calls, at the cost of
+    every scheme being a distinct type with no common comparable base.
+    */
+    struct StaticDispatch {};
+
+    namespace detail {
+        /// Selects version base class for given dispatch mode.
+        template<typename Comparator, typename Dispatch>
+        class DispatchBase;
+
+        template<typename Comparator>
+        class DispatchBase<Comparator, DynamicDispatch>: public ReadOnlyVersion {
+        protected:
+            explicit DispatchBase(VersionData data):ReadOnlyVersion(std::move(data), &comparator_)
+            {}
+
+        private:
+            static const Comparator comparator_;
+        };
+
+        template<typename Comparator>
+        const Comparator DispatchBase<Comparator, DynamicDispatch>::comparator_{};
+
+        template<typename Comparator>
+        class DispatchBase<Comparator, StaticDispatch>: public StaticReadOnlyVersion<Comparator> {
+        protected:
+            explicit DispatchBase(VersionData data):StaticReadOnlyVersion<Comparator>(std::move(data))
+            {}
+        };
+    }
+
     /// Base class for various version parsing, precedence ordering and data manipulation schemes.
     /**
     Basic_version class describes general version object without prescribing parsing,
     validation, comparison and modification rules. These rules are implemented by supplied Parser, Comparator
     and Modifier objects.
+
+    Every modification method has two overloads: one for lvalues which leaves the original version untouched,
+    and one for rvalues which moves the original's storage into the result. Chaining modifications on a
+    temporary, e.g. `v.SetMajor(3).SetMinor(1)`, therefore copies identifiers only once.
+
+    Parser and Modifier are always invoked on objects of their concrete types, so those calls are not virtual.
+    Dispatch selects how versions are compared: DynamicDispatch (default) derives from Read_only_version and
+    compares through VersionComparator interface; StaticDispatch drops comparator pointer and calls Comparator
+    directly.
     */
-    template<typename Parser, typename Comparator, typename Modifier>
-    class GenericVersion: public ReadOnlyVersion {
+    template<typename Parser, typename Comparator, typename Modifier, typename Dispatch = DynamicDispatch>
+    class GenericVersion: public detail::DispatchBase<Comparator, Dispatch> {
+        using Base = detail::DispatchBase<Comparator, Dispatch>;
+
     public:
+        class Builder;
+
         /// Construct Basic_version object using Parser object to parse default ("0.0.0") version string, Comparator for comparison and Modifier for modification.
-        GenericVersion():ReadOnlyVersion(parser_.Parse("0.0.0"), &comparator_)
+        GenericVersion():Base(parser_.Parse("0.0.0"))
         {}
 
         /// Construct Basic_version object using Parser to parse supplied version string, Comparator for comparison and Modifier for modification.
-        explicit GenericVersion(const std::string version):ReadOnlyVersion(parser_.Parse(std::move(version)), &comparator_)
-        {}
+        /**
+        When built with VERSIONING_RETAIN_SOURCE, validated version string is kept so that ToString() and stream
+        output can return it without reformatting. Any modification produces a version without source text.
+        */
+        explicit GenericVersion(std::string version):Base(parser_.Parse(version))
+        {
+            this->RetainSource(std::move(version));
+        }
 
         /// Construct Basic_version object using supplied Version_data, Parser, Comparator and Modifier objects.
-        explicit GenericVersion(const VersionData data):ReadOnlyVersion(std::move(data), &comparator_)
+        explicit GenericVersion(VersionData data):Base(std::move(data))
         {}
 
         /// Return a copy of version with major component set to specified value.
-        GenericVersion<Parser, Comparator, Modifier> SetMajor(const int m) const {
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.SetMajor(data_, m));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetMajor(const int m) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.SetMajor(this->Data(), m));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetMajor(const int m) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.SetMajor(std::forward<decltype(d)>(d), m);
+            });
         };
 
         /// Return a copy of version with the minor component set to specified value.
-        GenericVersion<Parser, Comparator, Modifier> SetMinor(const int m) const {
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.SetMinor(data_, m));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetMinor(const int m) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.SetMinor(this->Data(), m));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetMinor(const int m) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.SetMinor(std::forward<decltype(d)>(d), m);
+            });
         };
 
         /// Return a copy of version with the patch component set to specified value.
-        GenericVersion<Parser, Comparator, Modifier> SetPatch(const int p) const {
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.SetPatch(data_, p));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPatch(const int p) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.SetPatch(this->Data(), p));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPatch(const int p) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.SetPatch(std::forward<decltype(d)>(d), p);
+            });
         };
 
         /// Return a copy of version with the pre-release component set to specified value.
-        GenericVersion<Parser, Comparator, Modifier> SetPreRelease(const std::string & pr) const {
-                auto vd = parser_.Parse("0.0.0-" + pr);
-                return GenericVersion<Parser, Comparator, Modifier>(modifier_.SetPreRelease(data_, vd.prerelease_ids));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPreRelease(const std::string & pr) const & {
+            auto ids = parser_.ParsePreRelease(pr);
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.SetPreRelease(this->Data(), ids));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPreRelease(const std::string & pr) && {
+            auto ids = parser_.ParsePreRelease(pr);
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.SetPreRelease(std::forward<decltype(d)>(d), ids);
+            });
         };
 
         /// Return a copy of version with the build component set to specified value.
-        GenericVersion<Parser, Comparator, Modifier> SetBuild(const std::string & b) const {
-            auto vd = parser_.Parse("0.0.0+" + b);
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.SetBuild(data_, vd.build_ids));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetBuild(const std::string & b) const & {
+            auto ids = parser_.ParseBuild(b);
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.SetBuild(this->Data(), ids));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetBuild(const std::string & b) && {
+            auto ids = parser_.ParseBuild(b);
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.SetBuild(std::forward<decltype(d)>(d), ids);
+            });
         };
 
         /// Return a copy of version with the major component reset to specified value.
         /**
         Exact implementation of reset is delegated to Modifier object.
         */
-        GenericVersion<Parser, Comparator, Modifier> ResetMajor(const int m) const {
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.ResetMajor(data_, m));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetMajor(const int m) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.ResetMajor(this->Data(), m));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetMajor(const int m) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.ResetMajor(std::forward<decltype(d)>(d), m);
+            });
         };
 
         /// Return a copy of version with the minor component reset to specified value.
         /**
         Exact implementation of reset is delegated to Modifier object.
         */
-        GenericVersion<Parser, Comparator, Modifier> ResetMinor(const int m) const {
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.ResetMinor(data_, m));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetMinor(const int m) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.ResetMinor(this->Data(), m));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetMinor(const int m) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.ResetMinor(std::forward<decltype(d)>(d), m);
+            });
         };
 
         /// Return a copy of version with the patch component reset to specified value.
         /**
         Exact implementation of reset is delegated to Modifier object.
         */
-        GenericVersion<Parser, Comparator, Modifier> ResetPatch(const int p) const {
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.ResetPatch(data_, p));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPatch(const int p) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.ResetPatch(this->Data(), p));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPatch(const int p) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.ResetPatch(std::forward<decltype(d)>(d), p);
+            });
         };
 
         /// Return a copy of version with the pre-release component reset to specified value.
         /**
         Exact implementation of reset is delegated to Modifier object.
         */
-        GenericVersion<Parser, Comparator, Modifier> ResetPreRelease(const std::string & pr) const {
-            std::string ver = "0.0.0-" + pr;
-            auto vd = parser_.Parse(ver);
-            return GenericVersion<Parser, Comparator, Modifier>(modifier_.ResetPreRelease(data_, vd.prerelease_ids));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPreRelease(const std::string & pr) const & {
+            auto ids = parser_.ParsePreRelease(pr);
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.ResetPreRelease(this->Data(), ids));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPreRelease(const std::string & pr) && {
+            auto ids = parser_.ParsePreRelease(pr);
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.ResetPreRelease(std::forward<decltype(d)>(d), ids);
+            });
         };
 
         /// Return a copy of version with the build component reset to specified value.
         /**
         Exact implementation of reset is delegated to Modifier object.
         */
-        GenericVersion<Parser, Comparator, Modifier> ResetBuild(const std::string & b) const {
-                std::string ver = "0.0.0+" + b;
-                auto vd = parser_.Parse(ver);
-                return GenericVersion<Parser, Comparator, Modifier>(modifier_.ResetBuild(data_, vd.build_ids));
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetBuild(const std::string & b) const & {
+                auto ids = parser_.ParseBuild(b);
+                return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.ResetBuild(this->Data(), ids));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetBuild(const std::string & b) && {
+            auto ids = parser_.ParseBuild(b);
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.ResetBuild(std::forward<decltype(d)>(d), ids);
+            });
+        };
+
+        /// Return a copy of version with the pre-release component set to supplied identifiers.
+        /**
+        Identifiers are validated by Modifier object, without going through the Parser.
+        */
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPreRelease(const Prerelease_identifiers & pr) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.SetPreRelease(this->Data(), pr));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPreRelease(const Prerelease_identifiers & pr) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.SetPreRelease(std::forward<decltype(d)>(d), pr);
+            });
+        };
+
+        /// Return a copy of version with the pre-release component set to identifiers from range [first, last).
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPreRelease(InputIt first, InputIt last) const & {
+            return SetPreRelease(Prerelease_identifiers(first, last));
+        }
+
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetPreRelease(InputIt first, InputIt last) && {
+            return std::move(*this).SetPreRelease(Prerelease_identifiers(first, last));
+        }
+
+        /// Return a copy of version with the build component set to supplied identifiers.
+        /**
+        Identifiers are validated by Modifier object, without going through the Parser.
+        */
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetBuild(const Build_identifiers & b) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.SetBuild(this->Data(), b));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetBuild(const Build_identifiers & b) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.SetBuild(std::forward<decltype(d)>(d), b);
+            });
+        };
+
+        /// Return a copy of version with the build component set to identifiers from range [first, last).
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetBuild(InputIt first, InputIt last) const & {
+            return SetBuild(Build_identifiers(first, last));
+        }
+
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> SetBuild(InputIt first, InputIt last) && {
+            return std::move(*this).SetBuild(Build_identifiers(first, last));
+        }
+
+        /// Return a copy of version with the pre-release component reset to supplied identifiers.
+        /**
+        Identifiers are validated by Modifier object, without going through the Parser.
+        */
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPreRelease(const Prerelease_identifiers & pr) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.ResetPreRelease(this->Data(), pr));
         };
 
-        GenericVersion<Parser, Comparator, Modifier> IncMajor(const int i = 1) const {
-            return ResetMajor(data_.major + i);
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPreRelease(const Prerelease_identifiers & pr) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.ResetPreRelease(std::forward<decltype(d)>(d), pr);
+            });
         };
 
-        GenericVersion<Parser, Comparator, Modifier> IncMinor(const int i = 1) const {
-            return ResetMinor(data_.minor + i);
+        /// Return a copy of version with the pre-release component reset to identifiers from range [first, last).
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPreRelease(InputIt first, InputIt last) const & {
+            return ResetPreRelease(Prerelease_identifiers(first, last));
+        }
+
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetPreRelease(InputIt first, InputIt last) && {
+            return std::move(*this).ResetPreRelease(Prerelease_identifiers(first, last));
+        }
+
+        /// Return a copy of version with the build component reset to supplied identifiers.
+        /**
+        Identifiers are validated by Modifier object, without going through the Parser.
+        */
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetBuild(const Build_identifiers & b) const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.ResetBuild(this->Data(), b));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetBuild(const Build_identifiers & b) && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.ResetBuild(std::forward<decltype(d)>(d), b);
+            });
+        };
+
+        /// Return a copy of version with the build component reset to identifiers from range [first, last).
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetBuild(InputIt first, InputIt last) const & {
+            return ResetBuild(Build_identifiers(first, last));
+        }
+
+        template<typename InputIt>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> ResetBuild(InputIt first, InputIt last) && {
+            return std::move(*this).ResetBuild(Build_identifiers(first, last));
+        }
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncMajor(const int i = 1) const & {
+            return ResetMajor(this->Data().major + i);
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncMajor(const int i = 1) && {
+            return std::move(*this).ResetMajor(this->Data().major + i);
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncMinor(const int i = 1) const & {
+            return ResetMinor(this->Data().minor + i);
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncMinor(const int i = 1) && {
+            return std::move(*this).ResetMinor(this->Data().minor + i);
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncPatch(const int i = 1) const & {
+            return ResetPatch(this->Data().patch + i);
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncPatch(const int i = 1) && {
+            return std::move(*this).ResetPatch(this->Data().patch + i);
         };
 
-        GenericVersion<Parser, Comparator, Modifier> IncPatch(const int i = 1) const {
-            return ResetPatch(data_.patch + i);
+        /// Return a copy of version with the pre-release component incremented.
+        /**
+        Exact implementation of increment is delegated to Modifier object.
+        */
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncPreRelease() const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(modifier_.IncPreRelease(this->Data()));
+        };
+
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> IncPreRelease() && {
+            return std::move(*this).modify([&](auto&& d) {
+                return modifier_.IncPreRelease(std::forward<decltype(d)>(d));
+            });
         };
 
     private:
+        /// Apply modification op to data of this version, which is about to expire.
+        /**
+        Data is moved into op and result stored in place, unless other versions share it; then op reads it the way
+        const& modifications do, so only what the modifier builds is allocated.
+        */
+        template<typename Op>
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> modify(Op op) && {
+            if (this->SharesData()) return GenericVersion<Parser, Comparator, Modifier, Dispatch>(op(this->Data()));
+            this->ResetData(op(this->TakeData()));
+            return std::move(*this);
+        }
+
         static_assert(std::is_base_of<VersionParser, Parser>::value, "Parser parameter must inherit from VersionParser");
         static_assert(std::is_base_of<VersionComparator, Comparator>::value, "Comparator parameter must inherit from VersionComparator");
         static_assert(std::is_base_of<VersionModifier, Modifier>::value, "Modifier parameter must inherit from VersionModifier");
 
-        static const VersionParser& parser_;
-        static const VersionComparator& comparator_;
-        static const VersionModifier& modifier_;
+        static const Parser parser_;
+        static const Modifier modifier_;
     };
 
-    template<typename Parser, typename Comparator, typename Modifier>
-    const VersionParser& GenericVersion<Parser,Comparator,Modifier>::parser_ = Parser();
+    template<typename Parser, typename Comparator, typename Modifier, typename Dispatch>
+    const Parser GenericVersion<Parser, Comparator, Modifier, Dispatch>::parser_{};
+
+    template<typename Parser, typename Comparator, typename Modifier, typename Dispatch>
+    const Modifier GenericVersion<Parser, Comparator, Modifier, Dispatch>::modifier_{};
+
+    /// Mutable version builder which applies modifications in place.
+    /**
+    Builder owns a single Version_data object and every modification is applied directly to it, so a chain of
+    modifications never copies identifiers. Builder is initialized from an existing version (copying or moving
+    it's data) or from default "0.0.0" version; Build() produces final version object.
+    */
+    template<typename Parser, typename Comparator, typename Modifier, typename Dispatch>
+    class GenericVersion<Parser, Comparator, Modifier, Dispatch>::Builder {
+    public:
+        /// Start building from default ("0.0.0") version.
+        Builder():data_(parser_.Parse("0.0.0"))
+        {}
+
+        /// Start building from a copy of supplied version.
+        explicit Builder(const GenericVersion<Parser, Comparator, Modifier, Dispatch>& v):data_(v.Data())
+        {}
+
+        /// Start building from supplied version, taking over it's storage.
+        explicit Builder(GenericVersion<Parser, Comparator, Modifier, Dispatch>&& v):data_(v.TakeData())
+        {}
+
+        /// Start building from supplied Version_data.
+        explicit Builder(VersionData data):data_(std::move(data))
+        {}
+
+        Builder& SetMajor(const int m) & { data_ = modifier_.SetMajor(std::move(data_), m); return *this; }
+        Builder&& SetMajor(const int m) && { return std::move(SetMajor(m)); }
+
+        Builder& SetMinor(const int m) & { data_ = modifier_.SetMinor(std::move(data_), m); return *this; }
+        Builder&& SetMinor(const int m) && { return std::move(SetMinor(m)); }
+
+        Builder& SetPatch(const int p) & { data_ = modifier_.SetPatch(std::move(data_), p); return *this; }
+        Builder&& SetPatch(const int p) && { return std::move(SetPatch(p)); }
+
+        Builder& SetPreRelease(const std::string& pr) & {
+            auto ids = parser_.ParsePreRelease(pr);
+            data_ = modifier_.SetPreRelease(std::move(data_), ids);
+            return *this;
+        }
+        Builder&& SetPreRelease(const std::string& pr) && { return std::move(SetPreRelease(pr)); }
+
+        Builder& SetBuild(const std::string& b) & {
+            auto ids = parser_.ParseBuild(b);
+            data_ = modifier_.SetBuild(std::move(data_), ids);
+            return *this;
+        }
+        Builder&& SetBuild(const std::string& b) && { return std::move(SetBuild(b)); }
+
+        Builder& ResetMajor(const int m) & { data_ = modifier_.ResetMajor(std::move(data_), m); return *this; }
+        Builder&& ResetMajor(const int m) && { return std::move(ResetMajor(m)); }
 
-    template<typename Parser, typename Comparator, typename Modifier>
-    const VersionComparator& GenericVersion<Parser,Comparator,Modifier>::comparator_ = Comparator();
+        Builder& ResetMinor(const int m) & { data_ = modifier_.ResetMinor(std::move(data_), m); return *this; }
+        Builder&& ResetMinor(const int m) && { return std::move(ResetMinor(m)); }
 
-    template<typename Parser, typename Comparator, typename Modifier>
-    const VersionModifier& GenericVersion<Parser,Comparator,Modifier>::modifier_ = Modifier();
+        Builder& ResetPatch(const int p) & { data_ = modifier_.ResetPatch(std::move(data_), p); return *this; }
+        Builder&& ResetPatch(const int p) && { return std::move(ResetPatch(p)); }
+
+        Builder& ResetPreRelease(const std::string& pr) & {
+            auto ids = parser_.ParsePreRelease(pr);
+            data_ = modifier_.ResetPreRelease(std::move(data_), ids);
+            return *this;
+        }
+        Builder&& ResetPreRelease(const std::string& pr) && { return std::move(ResetPreRelease(pr)); }
+
+        Builder& ResetBuild(const std::string& b) & {
+            auto ids = parser_.ParseBuild(b);
+            data_ = modifier_.ResetBuild(std::move(data_), ids);
+            return *this;
+        }
+        Builder&& ResetBuild(const std::string& b) && { return std::move(ResetBuild(b)); }
+
+        Builder& SetPreRelease(const Prerelease_identifiers& pr) & { data_ = modifier_.SetPreRelease(std::move(data_), pr); return *this; }
+        Builder&& SetPreRelease(const Prerelease_identifiers& pr) && { return std::move(SetPreRelease(pr)); }
+
+        Builder& SetBuild(const Build_identifiers& b) & { data_ = modifier_.SetBuild(std::move(data_), b); return *this; }
+        Builder&& SetBuild(const Build_identifiers& b) && { return std::move(SetBuild(b)); }
+
+        Builder& ResetPreRelease(const Prerelease_identifiers& pr) & { data_ = modifier_.ResetPreRelease(std::move(data_), pr); return *this; }
+        Builder&& ResetPreRelease(const Prerelease_identifiers& pr) && { return std::move(ResetPreRelease(pr)); }
+
+        Builder& ResetBuild(const Build_identifiers& b) & { data_ = modifier_.ResetBuild(std::move(data_), b); return *this; }
+        Builder&& ResetBuild(const Build_identifiers& b) && { return std::move(ResetBuild(b)); }
+
+        Builder& IncPreRelease() & { data_ = modifier_.IncPreRelease(std::move(data_)); return *this; }
+        Builder&& IncPreRelease() && { return std::move(IncPreRelease()); }
+
+        Builder& IncMajor(const int i = 1) & { return ResetMajor(data_.major + i); }
+        Builder&& IncMajor(const int i = 1) && { return std::move(IncMajor(i)); }
+
+        Builder& IncMinor(const int i = 1) & { return ResetMinor(data_.minor + i); }
+        Builder&& IncMinor(const int i = 1) && { return std::move(IncMinor(i)); }
+
+        Builder& IncPatch(const int i = 1) & { return ResetPatch(data_.patch + i); }
+        Builder&& IncPatch(const int i = 1) && { return std::move(IncPatch(i)); }
+
+        /// Create version object from a copy of builder's current data.
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> Build() const & {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(data_);
+        }
+
+        /// Create version object, moving builder's data into it.
+        GenericVersion<Parser, Comparator, Modifier, Dispatch> Build() && {
+            return GenericVersion<Parser, Comparator, Modifier, Dispatch>(std::move(data_));
+        }
+
+    private:
+        VersionData data_;
+    };
 }
 
 #endif //VERSIONING_GENERIC_VERSION_H
@@ -0,0 +1,60 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VERSIONING_IMPL_READ_ONLY_VERSION_H
+#define VERSIONING_IMPL_READ_ONLY_VERSION_H
+
+#include <utility>
+#include <versioning/inline.h>
+#include <versioning/read_only_version.h>
+
+namespace vsn {
+    VERSIONING_INLINE ReadOnlyVersion::ReadOnlyVersion(VersionData data, const VersionComparator * comparator)
+            : VersionBase{ std::move(data) }, comparator_{ comparator } {}
+
+    VERSIONING_INLINE bool operator<(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
+        return l.comparator_->Compare(l.Data(), r.Data()) == -1;
+    }
+
+    VERSIONING_INLINE bool operator==(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
+        return l.comparator_->Compare(l.Data(), r.Data()) == 0;
+    }
+
+    VERSIONING_INLINE bool operator!=(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
+        return !(l == r);
+    }
+
+    VERSIONING_INLINE bool operator>(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
+        return r < l;
+    }
+
+    VERSIONING_INLINE bool operator>=(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
+        return !(l < r);
+    }
+
+    VERSIONING_INLINE bool operator<=(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
+        return !(l > r);
+    }
+}
+
+#endif //VERSIONING_IMPL_READ_ONLY_VERSION_H
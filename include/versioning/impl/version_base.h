@@ -0,0 +1,92 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VERSIONING_IMPL_VERSION_BASE_H
+#define VERSIONING_IMPL_VERSION_BASE_H
+
+#include <string>
+#include <utility>
+#include <versioning/inline.h>
+#include <versioning/version_base.h>
+
+namespace vsn {
+#ifdef VERSIONING_SHARED_PAYLOAD
+    VERSIONING_INLINE VersionBase::VersionBase(VersionData data)
+            : payload_{ std::move(data) } {}
+
+    VERSIONING_INLINE void VersionBase::RetainSource(std::string&& source) {
+#ifdef VERSIONING_RETAIN_SOURCE
+        payload_.SetSource(std::move(source));
+#else
+        (void)source;
+#endif
+    }
+
+    VERSIONING_INLINE VersionData VersionBase::TakeData() {
+        return payload_.Take();
+    }
+
+    VERSIONING_INLINE void VersionBase::ResetData(VersionData data) {
+        payload_.Reset(std::move(data));
+    }
+#else
+    VERSIONING_INLINE VersionBase::VersionBase(VersionData data)
+            : data_{ std::move(data) } {}
+
+    VERSIONING_INLINE void VersionBase::RetainSource(std::string&& source) {
+#ifdef VERSIONING_RETAIN_SOURCE
+        source_ = std::move(source);
+#else
+        (void)source;
+#endif
+    }
+
+    VERSIONING_INLINE VersionData VersionBase::TakeData() {
+#ifdef VERSIONING_RETAIN_SOURCE
+        std::string().swap(source_);
+#endif
+        return std::move(data_);
+    }
+
+    VERSIONING_INLINE void VersionBase::ResetData(VersionData data) {
+        data_ = std::move(data);
+#ifdef VERSIONING_RETAIN_SOURCE
+        std::string().swap(source_);
+#endif
+    }
+#endif
+
+    VERSIONING_INLINE int VersionBase::Major() const {
+        return Data().major;
+    }
+
+    VERSIONING_INLINE int VersionBase::Minor() const {
+        return Data().minor;
+    }
+
+    VERSIONING_INLINE int VersionBase::Patch() const {
+        return Data().patch;
+    }
+}
+
+#endif //VERSIONING_IMPL_VERSION_BASE_H
@@ -0,0 +1,41 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VERSIONING_INLINE_H
+#define VERSIONING_INLINE_H
+
+#include <versioning/config.h>
+
+/// Linkage of definitions available in headers with VERSIONING_HEADER_ONLY.
+/**
+With VERSIONING_HEADER_ONLY, version accessors, comparison operators and semver Comparator are defined inline in
+headers, so calls to them can be inlined without link time optimization; otherwise they are compiled once, into the
+versioning library.
+*/
+#ifdef VERSIONING_HEADER_ONLY
+#define VERSIONING_INLINE inline
+#else
+#define VERSIONING_INLINE
+#endif
+
+#endif //VERSIONING_INLINE_H
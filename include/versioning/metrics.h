@@ -0,0 +1,123 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_METRICS_H
+#define VERSIONING_METRICS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <versioning/config.h>
+#include "version_parser.h"
+
+/// Mark the rest of enclosing scope as one call of given metrics::Operation.
+/**
+Expands to nothing unless library is built with VERSIONING_METRICS defined.
+*/
+#ifdef VERSIONING_METRICS
+#define VERSIONING_INSTRUMENT(op) ::vsn::metrics::Timer versioning_metrics_timer_(::vsn::metrics::Operation::op)
+#else
+#define VERSIONING_INSTRUMENT(op) ((void)0)
+#endif
+
+namespace vsn { namespace metrics {
+
+    /// Instrumented library operations.
+    enum class Operation {
+        parse, ///< Parser::Parse
+        compare, ///< Comparator::Compare
+        modify, ///< Any Modifier operation
+        format ///< ToString() and operator<< of versions
+    };
+
+    /// Number of Operation values.
+    const size_t operation_count = 4;
+
+    /// Number of latency histogram buckets; bucket i counts latencies in [2^i, 2^(i+1)) ns, the last one the rest.
+    const size_t histogram_buckets = 32;
+
+    /// Every n-th call of an operation on each thread has its latency measured.
+    const uint64_t sample_period = 256;
+
+    /// Get name of the operation, as used in reports.
+    const char* ToString(Operation op);
+
+    /// Counters of a single operation.
+    struct OperationMetrics {
+        uint64_t calls; ///< Number of calls.
+        uint64_t sampled; ///< Number of calls with measured latency.
+        uint64_t sampled_ns; ///< Total latency of sampled calls.
+        uint64_t latency[histogram_buckets]; ///< Histogram of latencies of sampled calls.
+
+        /// Get mean latency of sampled calls, in nanoseconds.
+        double MeanNs() const;
+
+        /// Get upper bound of latency of given fraction (e.g. 0.99) of sampled calls, in nanoseconds.
+        uint64_t PercentileNs(double fraction) const;
+    };
+
+    /// Totals of all counters over all threads, at a point in time.
+    struct Snapshot {
+        /// Whether library was built with instrumentation; all counters are 0 if it was not.
+        bool enabled;
+        OperationMetrics operations[operation_count];
+        uint64_t parse_failures[parse_error_reason_count];
+
+        const OperationMetrics& operator[](Operation op) const {
+            return operations[static_cast<size_t>(op)];
+        }
+
+        uint64_t ParseFailures(ParseErrorReason reason) const {
+            return parse_failures[static_cast<size_t>(reason)];
+        }
+    };
+
+    /// Sum counters of all threads, including those that have already exited.
+    Snapshot Collect();
+
+    /// Write snapshot as a human readable report.
+    std::ostream& operator<<(std::ostream& os, const Snapshot& s);
+
+    /// Count one call of an operation, and measure its latency if the call is sampled.
+    /**
+    Counters are kept per thread and only ever written by their own thread, so counting needs no
+    synchronization between threads.
+    */
+    class Timer {
+    public:
+        explicit Timer(Operation op);
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        ~Timer();
+
+    private:
+        Operation op_;
+        uint64_t start_;
+    };
+
+    /// Count a failed parse.
+    void CountParseFailure(ParseErrorReason reason);
+}}
+
+#endif //VERSIONING_METRICS_H
@@ -0,0 +1,367 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_PIPELINE_H
+#define VERSIONING_PIPELINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "bounded_queue.h"
+
+namespace vsn {
+
+    /// Settings shared by all stages of a pipeline.
+    struct PipelineOptions {
+        PipelineOptions() : batch_size{ 256 }, queue_capacity{ 64 } {}
+
+        size_t batch_size; ///< Maximum number of items handed from one stage to the next at once.
+        size_t queue_capacity; ///< Number of batches queued in front of a stage before upstream stage waits.
+    };
+
+    /// Counters collected for one stage of a pipeline run.
+    struct StageMetrics {
+        std::string name; ///< Name stage was added with.
+        unsigned threads; ///< Number of worker threads running the stage.
+        uint64_t items_in; ///< Number of items stage consumed.
+        uint64_t items_out; ///< Number of items stage produced.
+        uint64_t batches; ///< Number of batches stage consumed.
+        double busy_seconds; ///< Time spent processing, summed over all workers.
+        double elapsed_seconds; ///< Time from the start of the run until the last worker finished.
+        double mean_queue_depth; ///< Average number of batches waiting in front of the stage, sampled on each batch.
+        size_t max_queue_depth; ///< Highest sampled number of batches waiting in front of the stage.
+        size_t queue_capacity; ///< Capacity of the queue in front of the stage, in batches.
+
+        /// Get number of items consumed per second.
+        double Throughput() const {
+            return elapsed_seconds > 0 ? items_in / elapsed_seconds : 0;
+        }
+    };
+
+    /// Write metrics as a single line of text.
+    std::ostream& operator<<(std::ostream& os, const StageMetrics& m);
+
+    /// Convenience base for pipeline stages.
+    /**
+    A stage is a copyable type with input_type and output_type members, a call operator taking a batch of input
+    items and appending results to output, and Flush() called once when input is exhausted. Each worker thread
+    runs its own copy of the stage; stages keeping state across batches (deduplication, sorting) limit the number
+    of workers through max_threads, where 0 means no limit.
+    */
+    template<typename In, typename Out>
+    struct Stage {
+        using input_type = In;
+        using output_type = Out;
+
+        static const unsigned max_threads = 0;
+
+        /// Emit items held back until the end of input.
+        void Flush(std::vector<Out>&) {}
+    };
+
+    namespace detail {
+        template<typename T>
+        using BatchQueue = BoundedQueue<std::vector<T>>;
+
+        class StageRunner {
+        public:
+            virtual ~StageRunner() = default;
+            virtual void Start() = 0;
+            virtual void Join() = 0;
+            virtual std::exception_ptr Error() const = 0;
+            virtual StageMetrics Metrics() const = 0;
+        };
+
+        template<typename S>
+        class StageWorker : public StageRunner {
+            using In = typename S::input_type;
+            using Out = typename S::output_type;
+            using Clock = std::chrono::steady_clock;
+
+        public:
+            StageWorker(std::string name, const S& stage, unsigned threads, size_t batch_size,
+                        std::shared_ptr<BatchQueue<In>> in, std::shared_ptr<BatchQueue<Out>> out)
+                    : name_(std::move(name)), stage_(stage), thread_count_{ threads }, batch_size_{ batch_size },
+                      in_(std::move(in)), out_(std::move(out)), remaining_{ threads }, failed_{ false },
+                      items_in_{ 0 }, items_out_{ 0 }, batches_{ 0 }, busy_ns_{ 0 }, depth_sum_{ 0 }, depth_max_{ 0 } {}
+
+            void Start() override {
+                start_ = Clock::now();
+                for (unsigned i = 0; i < thread_count_; ++i) threads_.emplace_back([this] { run(); });
+            }
+
+            void Join() override {
+                for (auto& t : threads_) t.join();
+                threads_.clear();
+            }
+
+            std::exception_ptr Error() const override {
+                return error_;
+            }
+
+            StageMetrics Metrics() const override {
+                StageMetrics m;
+                m.name = name_;
+                m.threads = thread_count_;
+                m.items_in = items_in_.load();
+                m.items_out = items_out_.load();
+                m.batches = batches_.load();
+                m.busy_seconds = busy_ns_.load() * 1e-9;
+                m.elapsed_seconds = std::chrono::duration<double>(end_ - start_).count();
+                m.mean_queue_depth = m.batches ? static_cast<double>(depth_sum_.load()) / m.batches : 0;
+                m.max_queue_depth = depth_max_.load();
+                m.queue_capacity = in_->Capacity();
+                return m;
+            }
+
+        private:
+            void run() {
+                S stage(stage_);
+                std::vector<In> batch;
+                std::vector<Out> out;
+                while (in_->Pop(batch)) {
+                    // After a failure keep draining input, so upstream stages are not blocked forever.
+                    if (!failed_.load(std::memory_order_relaxed)) {
+                        sample_depth();
+                        auto size = batch.size();
+                        auto before = out.size();
+                        auto t = Clock::now();
+                        if (guarded([&] { stage(batch, out); })) {
+                            busy_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t).count();
+                            items_in_ += size;
+                            items_out_ += out.size() - before;
+                            ++batches_;
+                            // Hand results on when a batch is full, or when there is no more work waiting here.
+                            if (out.size() >= batch_size_ || (!out.empty() && in_->Size() == 0)) emit(out);
+                        }
+                    }
+                    batch.clear();
+                }
+                if (!failed_.load()) {
+                    auto before = out.size();
+                    if (guarded([&] { stage.Flush(out); })) items_out_ += out.size() - before;
+                }
+                if (!out.empty()) emit(out);
+                if (--remaining_ == 0) {
+                    end_ = Clock::now();
+                    out_->Close();
+                }
+            }
+
+            template<typename F>
+            bool guarded(F f) {
+                try {
+                    f();
+                    return true;
+                }
+                catch (...) {
+                    bool expected = false;
+                    if (failed_.compare_exchange_strong(expected, true)) error_ = std::current_exception();
+                    return false;
+                }
+            }
+
+            void emit(std::vector<Out>& out) {
+                if (out.size() <= batch_size_) out_->Push(std::move(out));
+                else {
+                    for (size_t i = 0; i < out.size(); i += batch_size_) {
+                        auto first = std::make_move_iterator(out.begin() + i);
+                        auto last = std::make_move_iterator(out.begin() + std::min(out.size(), i + batch_size_));
+                        out_->Push(std::vector<Out>(first, last));
+                    }
+                }
+                out.clear();
+                out.reserve(batch_size_);
+            }
+
+            void sample_depth() {
+                size_t depth = in_->Size();
+                depth_sum_ += depth;
+                size_t max = depth_max_.load(std::memory_order_relaxed);
+                while (depth > max && !depth_max_.compare_exchange_weak(max, depth)) {}
+            }
+
+            const std::string name_;
+            const S stage_;
+            const unsigned thread_count_;
+            const size_t batch_size_;
+            const std::shared_ptr<BatchQueue<In>> in_;
+            const std::shared_ptr<BatchQueue<Out>> out_;
+            std::vector<std::thread> threads_;
+            Clock::time_point start_;
+            Clock::time_point end_;
+            std::atomic<unsigned> remaining_;
+            std::atomic<bool> failed_;
+            std::exception_ptr error_;
+            std::atomic<uint64_t> items_in_;
+            std::atomic<uint64_t> items_out_;
+            std::atomic<uint64_t> batches_;
+            std::atomic<uint64_t> busy_ns_;
+            std::atomic<uint64_t> depth_sum_;
+            std::atomic<size_t> depth_max_;
+        };
+    }
+
+    /// Chain of stages transforming a stream of In items into Out items.
+    /**
+    Every stage runs on its own worker threads; neighbouring stages are connected with bounded queues of item
+    batches, so a slow stage makes faster upstream stages wait rather than buffer without limit.
+
+    Pipeline is only a description of stages, so it can be run any number of times.
+    */
+    template<typename In, typename Out = In>
+    class Pipeline {
+    public:
+        /// Create pipeline without stages.
+        /**
+        Throws std::invalid_argument if batch size or queue capacity is 0, since stages could never pass batches on.
+        */
+        explicit Pipeline(PipelineOptions options = PipelineOptions()) : options_(options) {
+            static_assert(std::is_same<In, Out>::value, "Pipeline without stages must have same input and output");
+            if (options_.batch_size == 0) throw std::invalid_argument("pipeline batch size must be positive");
+            if (options_.queue_capacity == 0) throw std::invalid_argument("pipeline queue capacity must be positive");
+        }
+
+        /// Append stage, run by given number of threads.
+        template<typename S>
+        Pipeline<In, typename S::output_type> Then(std::string name, S stage, unsigned threads = 1) const {
+            static_assert(std::is_same<typename S::input_type, Out>::value, "Stage input must match pipeline output");
+            using Next = typename S::output_type;
+
+            unsigned limit = S::max_threads;
+            if (threads == 0) threads = 1;
+            if (limit != 0 && threads > limit) threads = limit;
+
+            auto factories = factories_;
+            factories.push_back([name, stage, threads](std::shared_ptr<void> in, std::shared_ptr<void>& out,
+                                                       const PipelineOptions& options) {
+                auto next = std::make_shared<detail::BatchQueue<Next>>(options.queue_capacity);
+                out = next;
+                return std::unique_ptr<detail::StageRunner>(new detail::StageWorker<S>(
+                        name, stage, threads, options.batch_size,
+                        std::static_pointer_cast<detail::BatchQueue<Out>>(in), next));
+            });
+            return Pipeline<In, Next>(options_, std::move(factories));
+        }
+
+        /// Feed items in range [first, last) through the pipeline, passing each result to sink.
+        /**
+        Input is read on calling thread, and sink is called on a single separate thread. If reading input, a stage
+        or sink throws, items already in flight are drained without processing and the exception is rethrown here.
+        */
+        template<typename InputIt, typename Sink>
+        std::vector<StageMetrics> Run(InputIt first, InputIt last, Sink sink) const {
+            auto input = std::make_shared<detail::BatchQueue<In>>(options_.queue_capacity);
+            std::shared_ptr<void> queue = input;
+            std::vector<std::unique_ptr<detail::StageRunner>> runners;
+            for (const auto& factory : factories_) {
+                std::shared_ptr<void> next;
+                runners.push_back(factory(queue, next, options_));
+                queue = next;
+            }
+            auto output = std::static_pointer_cast<detail::BatchQueue<Out>>(queue);
+
+            for (auto& r : runners) r->Start();
+            std::exception_ptr sink_error;
+            std::thread drain([&] {
+                std::vector<Out> batch;
+                while (output->Pop(batch)) {
+                    if (!sink_error) {
+                        try {
+                            for (auto& item : batch) sink(std::move(item));
+                        }
+                        catch (...) {
+                            sink_error = std::current_exception();
+                        }
+                    }
+                    batch.clear();
+                }
+            });
+
+            std::exception_ptr input_error;
+            try {
+                std::vector<In> batch;
+                batch.reserve(options_.batch_size);
+                for (; first != last; ++first) {
+                    batch.push_back(*first);
+                    if (batch.size() >= options_.batch_size) {
+                        input->Push(std::move(batch));
+                        batch.clear();
+                        batch.reserve(options_.batch_size);
+                    }
+                }
+                if (!batch.empty()) input->Push(std::move(batch));
+            }
+            catch (...) {
+                input_error = std::current_exception();
+            }
+            input->Close();
+
+            for (auto& r : runners) r->Join();
+            drain.join();
+            if (input_error) std::rethrow_exception(input_error);
+
+            std::vector<StageMetrics> metrics;
+            for (auto& r : runners) {
+                if (r->Error()) std::rethrow_exception(r->Error());
+                metrics.push_back(r->Metrics());
+            }
+            if (sink_error) std::rethrow_exception(sink_error);
+            return metrics;
+        }
+
+        /// Feed all input items through the pipeline and collect the results.
+        std::vector<Out> Run(const std::vector<In>& input) const {
+            std::vector<Out> res;
+            Run(input.begin(), input.end(), [&](Out&& item) { res.push_back(std::move(item)); });
+            return res;
+        }
+
+    private:
+        template<typename, typename> friend class Pipeline;
+
+        using Factory = std::function<std::unique_ptr<detail::StageRunner>(
+                std::shared_ptr<void>, std::shared_ptr<void>&, const PipelineOptions&)>;
+
+        Pipeline(PipelineOptions options, std::vector<Factory> factories)
+                : options_(options), factories_(std::move(factories)) {}
+
+        PipelineOptions options_;
+        std::vector<Factory> factories_;
+    };
+}
+
+#endif //VERSIONING_PIPELINE_H
@@ -27,6 +27,8 @@ SOFTWARE.
 
 #include <string>
 #include <vector>
+#include <versioning/config.h>
+#include "version_base.h"
 #include "version_comparator.h"
 #include "version_parser.h"
 #include "version_modifier.h"
@@ -34,22 +36,13 @@ SOFTWARE.
 
 namespace vsn {
 
-    class ReadOnlyVersion {
+    /// Version which is compared through a VersionComparator pointer, so versions of any scheme share one type.
+    class ReadOnlyVersion: public VersionBase {
     public:
         ReadOnlyVersion(VersionData data, const VersionComparator * comparator);
 
-        int Major() const; ///< Get major version.
-        int Minor() const; ///< Get minor version.
-        int Patch() const; ///< Get patch version.
-        const std::string PreRelease() const; ///< Get prerelease version string.
-        const std::string Build() const; ///< Get build version string.
-
         friend bool operator<(const ReadOnlyVersion&, const ReadOnlyVersion&);
         friend bool operator==(const ReadOnlyVersion&, const ReadOnlyVersion&);
-        friend std::ostream& operator<<(std::ostream&s, const ReadOnlyVersion&);
-
-    protected:
-        VersionData data_;
 
     private:
         const VersionComparator * comparator_;
@@ -61,9 +54,6 @@ namespace vsn {
     /// Test if left-hand version operand if of equal precedence as the right-hand version.
     bool operator==(const ReadOnlyVersion&, const ReadOnlyVersion&);
 
-    /// Output version object to stream using standard semver format (X.Y.Z-PR+B).
-    std::ostream& operator<<(std::ostream&, const ReadOnlyVersion&);
-
     /// Test if left-hand version and right-hand version are of different precedence.
     bool operator!=(const ReadOnlyVersion&, const ReadOnlyVersion&);
 
@@ -77,4 +67,8 @@ namespace vsn {
     bool operator<=(const ReadOnlyVersion&, const ReadOnlyVersion&);
 }
 
+#ifdef VERSIONING_HEADER_ONLY
+#include "impl/read_only_version.h"
+#endif
+
 #endif //VERSIONING_READ_ONLY_VERSION_H
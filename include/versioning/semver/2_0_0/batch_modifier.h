@@ -0,0 +1,103 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_BATCH_MODIFIER_H
+#define VERSIONING_BATCH_MODIFIER_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+#include <versioning/version_data.h>
+#include "parser.h"
+#include "modifier.h"
+
+namespace vsn { namespace semver {
+    /// Version component bumped by Batch_modifier.
+    enum class Bump {
+        major, ///< Increment major version, reset minor, patch and pre-release.
+        minor, ///< Increment minor version, reset patch and pre-release.
+        patch, ///< Increment patch version, reset pre-release.
+        prerelease ///< Increment pre-release version, as Modifier::IncPreRelease does.
+    };
+
+    /// Bump policy applied to every version of a batch.
+    struct BumpPolicy {
+        explicit BumpPolicy(const Bump b, const int i = 1, Build_identifiers bld = {})
+                : bump{ b }, increment{ i }, build{ std::move(bld) } {}
+
+        Bump bump; ///< Component to bump.
+        int increment; ///< Increment for major, minor and patch bumps; ignored for pre-release bumps.
+        Build_identifiers build; ///< Build identifiers set on every bumped version; empty for none.
+    };
+
+    /// Failure of a single batch item.
+    struct BatchError {
+        size_t index; ///< Position of failed item in the input array.
+        std::string message; ///< Message of Parse_error/Modification_error that item failed with.
+    };
+
+    /// Apply one bump policy to whole arrays of versions.
+    /**
+    Batch modifier calls semver Modifier directly (no virtual dispatch), modifies each version in place in
+    the output storage and splits large batches between worker threads. Failures are reported per item
+    instead of being thrown, so one bad version does not abort the batch.
+    */
+    class BatchModifier {
+    public:
+        /// Create batch modifier for the policy; threads == 0 uses all hardware threads.
+        /**
+        Policy build identifiers are validated once, here; invalid ones result in Modification_error.
+        */
+        explicit BatchModifier(BumpPolicy policy, unsigned threads = 0);
+
+        /// Bump n versions from in and write them to preallocated out[0, n).
+        /**
+        Output storage may alias input storage. Failed items are copied to output unchanged.
+        Returned errors are ordered by item index.
+        */
+        std::vector<BatchError> Apply(const VersionData* in, size_t n, VersionData* out) const;
+
+        /// Parse n version strings from in, bump them and write formatted results to preallocated out[0, n).
+        /**
+        Output storage may alias input storage. Failed items are written as empty strings.
+        Returned errors are ordered by item index.
+        */
+        std::vector<BatchError> Apply(const std::string* in, size_t n, std::string* out) const;
+
+        /// Bump a single version in place; throws Modification_error on failure.
+        void Apply(VersionData& v) const;
+
+    private:
+        template<typename F>
+        std::vector<BatchError> run(size_t n, F process) const;
+
+        BumpPolicy policy_;
+        unsigned threads_;
+        Parser parser_;
+        Modifier modifier_;
+    };
+}}
+
+#endif //VERSIONING_BATCH_MODIFIER_H
@@ -25,6 +25,7 @@ SOFTWARE.
 #ifndef VERSIONING_COMPARATOR_H
 #define VERSIONING_COMPARATOR_H
 
+#include <versioning/config.h>
 #include <versioning/version_comparator.h>
 
 namespace vsn { namespace semver {
@@ -34,4 +35,8 @@ namespace vsn { namespace semver {
     };
 }}
 
+#ifdef VERSIONING_HEADER_ONLY
+#include "impl/comparator.h"
+#endif
+
 #endif //VERSIONING_COMPARATOR_H
@@ -0,0 +1,382 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VERSIONING_CONSTEXPR_VERSION_H
+#define VERSIONING_CONSTEXPR_VERSION_H
+
+#include <climits>
+#include <cstddef>
+#include <versioning/version_data.h>
+#include <versioning/version_parser.h>
+
+namespace vsn { namespace semver {
+    namespace detail {
+        /// Throw ParseError, as Parser does. Not constexpr, so reaching it in a constant expression fails to compile.
+        [[noreturn]] void constexpr_parse_error(ParseErrorReason reason, const char* message, char c = 0);
+
+        constexpr bool is_digit(const char c) {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr bool is_identifier_char(const char c) {
+            return is_digit(c) || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-';
+        }
+
+        // Compare as std::string::compare does, returning -1, 0 or 1.
+        constexpr int compare_text(const char* l, const size_t lsize, const char* r, const size_t rsize) {
+            for (size_t i = 0; i < lsize && i < rsize; ++i) {
+                if (l[i] != r[i]) return static_cast<unsigned char>(l[i]) < static_cast<unsigned char>(r[i]) ? -1 : 1;
+            }
+            if (lsize == rsize) return 0;
+            return lsize < rsize ? -1 : 1;
+        }
+    }
+
+    /// Version parsed and compared in constant expressions.
+    /**
+    Views version text, typically a string literal, which must outlive it. Text is validated as by Parser, and
+    versions are ordered as by Comparator, so checks between versions known at compile time can be static_asserted:
+
+        constexpr ConstexprVersion plugin_abi = "2.3.0";
+        static_assert(plugin_abi >= "2.1.0", "plugin built against too old ABI");
+
+    Invalid text fails to compile in a constant expression, and throws ParseError otherwise.
+    */
+    class ConstexprVersion {
+    public:
+        template<size_t N>
+        constexpr ConstexprVersion(const char (&s)[N]) : ConstexprVersion(s, N - 1) {}
+
+        constexpr ConstexprVersion(const char* s, const size_t size) : text_{ s }, size_{ size } {
+            parse();
+        }
+
+        constexpr int Major() const { return major_; }
+        constexpr int Minor() const { return minor_; }
+        constexpr int Patch() const { return patch_; }
+
+        constexpr bool IsPrerelease() const { return pre_last_ != pre_first_; }
+
+        /// Get viewed text.
+        constexpr const char* Text() const { return text_; }
+
+        /// Get length of viewed text.
+        constexpr size_t Size() const { return size_; }
+
+        /// Get parts of the version, as Parser would produce them.
+        VersionData Data() const {
+            VersionData data{ major_, minor_, patch_, {}, {} };
+            for_each_identifier(pre_first_, pre_last_, [&](const size_t first, const size_t last) {
+                data.prerelease_ids.emplace_back(std::string(text_ + first, text_ + last),
+                        numeric(first, last) ? Id_type::num : Id_type::alnum);
+            });
+            for_each_identifier(build_first_, size_, [&](const size_t first, const size_t last) {
+                data.build_ids.emplace_back(text_ + first, text_ + last);
+            });
+            return data;
+        }
+
+        /// Compare precedence of versions; returns negative, zero or positive value, as Comparator::Compare.
+        static constexpr int Compare(const ConstexprVersion& l, const ConstexprVersion& r) {
+            if (l.major_ != r.major_) return l.major_ > r.major_ ? 1 : -1;
+            if (l.minor_ != r.minor_) return l.minor_ > r.minor_ ? 1 : -1;
+            if (l.patch_ != r.patch_) return l.patch_ > r.patch_ ? 1 : -1;
+            if (l.IsPrerelease() != r.IsPrerelease()) return l.IsPrerelease() ? -1 : 1;
+            if (!l.IsPrerelease()) return 0;
+            for (size_t lp = l.pre_first_, rp = r.pre_first_;;) {
+                const size_t le = l.identifier_end(lp, l.pre_last_);
+                const size_t re = r.identifier_end(rp, r.pre_last_);
+                const int cmp = compare_identifiers(l, lp, le, r, rp, re);
+                if (cmp != 0) return cmp;
+                const bool lmore = le != l.pre_last_;
+                const bool rmore = re != r.pre_last_;
+                if (!lmore || !rmore) return lmore == rmore ? 0 : (lmore ? 1 : -1);
+                lp = le + 1;
+                rp = re + 1;
+            }
+        }
+
+        friend constexpr bool operator<(const ConstexprVersion& l, const ConstexprVersion& r) {
+            return Compare(l, r) < 0;
+        }
+
+        friend constexpr bool operator==(const ConstexprVersion& l, const ConstexprVersion& r) {
+            return Compare(l, r) == 0;
+        }
+
+        friend constexpr bool operator!=(const ConstexprVersion& l, const ConstexprVersion& r) {
+            return Compare(l, r) != 0;
+        }
+
+        friend constexpr bool operator>(const ConstexprVersion& l, const ConstexprVersion& r) {
+            return Compare(l, r) > 0;
+        }
+
+        friend constexpr bool operator>=(const ConstexprVersion& l, const ConstexprVersion& r) {
+            return Compare(l, r) >= 0;
+        }
+
+        friend constexpr bool operator<=(const ConstexprVersion& l, const ConstexprVersion& r) {
+            return Compare(l, r) <= 0;
+        }
+
+    private:
+        friend class ConstexprConstraint;
+
+        // Lowest version of given major, minor and patch, M.m.p-0, used as exclusive upper bound of ranges.
+        constexpr ConstexprVersion(const int M, const int m, const int p)
+                : text_{ "0" }, size_{ 1 }, major_{ M }, minor_{ m }, patch_{ p }, pre_first_{ 0 }, pre_last_{ 1 },
+                  build_first_{ 1 } {}
+
+        // Scan as Parser does, failing with the same reasons and messages.
+        constexpr void parse() {
+            size_t p = 0;
+            major_ = component(p, false);
+            ++p;
+            minor_ = component(p, false);
+            ++p;
+            patch_ = component(p, true);
+            pre_first_ = pre_last_ = p;
+            if (p != size_ && text_[p] == '-') {
+                pre_first_ = ++p;
+                identifiers(p, true);
+                pre_last_ = p;
+            }
+            build_first_ = size_;
+            if (p != size_ && text_[p] == '+') {
+                build_first_ = ++p;
+                identifiers(p, false);
+            }
+        }
+
+        constexpr int component(size_t& p, const bool last) const {
+            const size_t first = p;
+            int v = 0;
+            for (; p != size_ && detail::is_digit(text_[p]); ++p) {
+                if (p != first && text_[first] == '0') {
+                    detail::constexpr_parse_error(ParseErrorReason::leading_zero, "leading 0 not allowed");
+                }
+                const int digit = text_[p] - '0';
+                if (v > (INT_MAX - digit) / 10) {
+                    detail::constexpr_parse_error(ParseErrorReason::overflow, "version number out of range");
+                }
+                v = v * 10 + digit;
+            }
+            if (p == size_) {
+                if (!last) {
+                    detail::constexpr_parse_error(ParseErrorReason::missing_component, "missing version component");
+                }
+            }
+            else if (last ? (text_[p] != '-' && text_[p] != '+') : text_[p] != '.') {
+                detail::constexpr_parse_error(ParseErrorReason::invalid_character,
+                        "invalid character encountered: ", text_[p]);
+            }
+            if (p == first) {
+                detail::constexpr_parse_error(ParseErrorReason::missing_component, "missing version component");
+            }
+            return v;
+        }
+
+        constexpr void identifiers(size_t& p, const bool prerelease) const {
+            for (;;) {
+                const size_t first = p;
+                for (; p != size_ && detail::is_identifier_char(text_[p]); ++p) {}
+                if (p != size_ && text_[p] != '.' && !(prerelease && text_[p] == '+')) {
+                    detail::constexpr_parse_error(ParseErrorReason::invalid_character,
+                            "invalid character encountered: ", text_[p]);
+                }
+                if (p == first) {
+                    detail::constexpr_parse_error(ParseErrorReason::empty_identifier,
+                            "version identifier cannot be empty");
+                }
+                if (prerelease && p - first > 1 && text_[first] == '0' && numeric(first, p)) {
+                    detail::constexpr_parse_error(ParseErrorReason::leading_zero,
+                            "numeric identifiers cannot have leading 0");
+                }
+                if (p == size_ || text_[p] != '.') return;
+                ++p;
+            }
+        }
+
+        constexpr bool numeric(const size_t first, const size_t last) const {
+            for (size_t i = first; i != last; ++i) {
+                if (!detail::is_digit(text_[i])) return false;
+            }
+            return true;
+        }
+
+        constexpr size_t identifier_end(size_t p, const size_t last) const {
+            for (; p != last && text_[p] != '.'; ++p) {}
+            return p;
+        }
+
+        template<typename F>
+        void for_each_identifier(size_t p, const size_t last, F f) const {
+            while (p < last) {
+                const size_t end = identifier_end(p, last);
+                f(p, end);
+                p = end + 1;
+            }
+        }
+
+        // Numeric identifiers are lower than alphanumeric ones, and compared by number of significant digits first.
+        static constexpr int compare_identifiers(const ConstexprVersion& l, size_t lp, const size_t le,
+                const ConstexprVersion& r, size_t rp, const size_t re) {
+            const bool lnum = l.numeric(lp, le);
+            const bool rnum = r.numeric(rp, re);
+            if (lnum != rnum) return lnum ? -1 : 1;
+            if (lnum) {
+                for (; le - lp > 1 && l.text_[lp] == '0'; ++lp) {}
+                for (; re - rp > 1 && r.text_[rp] == '0'; ++rp) {}
+                if (le - lp != re - rp) return le - lp > re - rp ? 1 : -1;
+            }
+            return detail::compare_text(l.text_ + lp, le - lp, r.text_ + rp, re - rp);
+        }
+
+        const char* text_ = nullptr;
+        size_t size_ = 0;
+        int major_ = 0;
+        int minor_ = 0;
+        int patch_ = 0;
+        size_t pre_first_ = 0; ///< Offset of first prerelease identifier.
+        size_t pre_last_ = 0; ///< Offset past last prerelease identifier; equal to pre_first_ for releases.
+        size_t build_first_ = 0; ///< Offset of first build identifier; equal to size_ without build identifiers.
+    };
+
+    /// Version range, evaluated in constant expressions.
+    /**
+    Range is a set of comparators, "||" separated, each a space separated list of bounds a version must all satisfy:
+
+      * `1.2.3` or `=1.2.3` - versions equal in precedence;
+      * `<1.2.3`, `<=1.2.3`, `>1.2.3` or `>=1.2.3` - versions lower, lower or equal, higher, higher or equal;
+      * `~1.2.3` - at least 1.2.3, but lower than prereleases of 1.3.0;
+      * `^1.2.3` - at least 1.2.3, but lower than prereleases of the next version changing the leftmost nonzero
+        number: 2.0.0 for ^1.2.3, 0.3.0 for ^0.2.3 and 0.0.4 for ^0.0.3;
+      * `*` - any version.
+
+    Bounds are compared by precedence, so unlike in some package managers, prereleases are not treated specially.
+    Text is validated on construction, failing as ConstexprVersion does:
+
+        constexpr ConstexprConstraint host_abi = "^2.1.0 || ~1.9.4";
+        static_assert(host_abi.Contains(plugin_abi), "plugin ABI not supported by host");
+    */
+    class ConstexprConstraint {
+    public:
+        template<size_t N>
+        constexpr ConstexprConstraint(const char (&s)[N]) : ConstexprConstraint(s, N - 1) {}
+
+        constexpr ConstexprConstraint(const char* s, const size_t size) : text_{ s }, size_{ size } {
+            evaluate(nullptr);
+        }
+
+        /// Test if version satisfies the range.
+        constexpr bool Contains(const ConstexprVersion& v) const {
+            return evaluate(&v);
+        }
+
+        /// Get viewed text.
+        constexpr const char* Text() const { return text_; }
+
+        /// Get length of viewed text.
+        constexpr size_t Size() const { return size_; }
+
+    private:
+        static constexpr bool is_space(const char c) {
+            return c == ' ' || c == '\t';
+        }
+
+        // Test if v satisfies any of comparators, or only validate them for null v.
+        constexpr bool evaluate(const ConstexprVersion* v) const {
+            bool any = false;
+            size_t p = 0;
+            for (;;) {
+                bool all = true;
+                size_t bounds = 0;
+                for (;;) {
+                    for (; p != size_ && is_space(text_[p]); ++p) {}
+                    if (p == size_ || text_[p] == '|') break;
+                    all = bound(p, v) && all;
+                    ++bounds;
+                }
+                if (bounds == 0) {
+                    detail::constexpr_parse_error(ParseErrorReason::missing_component, "empty version range");
+                }
+                any = any || all;
+                if (p == size_) return v ? any : true;
+                if (p + 1 == size_ || text_[p + 1] != '|') {
+                    detail::constexpr_parse_error(ParseErrorReason::invalid_character,
+                            "invalid character encountered: ", text_[p]);
+                }
+                p += 2;
+            }
+        }
+
+        // Scan single bound at p, testing if v satisfies it.
+        constexpr bool bound(size_t& p, const ConstexprVersion* v) const {
+            char op = '=';
+            bool inclusive = true;
+            if (text_[p] == '<' || text_[p] == '>' || text_[p] == '=' || text_[p] == '^' || text_[p] == '~') {
+                op = text_[p++];
+                if ((op == '<' || op == '>') && p != size_ && text_[p] == '=') ++p;
+                else inclusive = op != '<' && op != '>';
+            }
+            const size_t first = p;
+            for (; p != size_ && !is_space(text_[p]) && text_[p] != '|'; ++p) {}
+            if (op == '=' && p - first == 1 && text_[first] == '*') return true;
+            const ConstexprVersion b(text_ + first, p - first);
+            if (!v) return true;
+            const int cmp = ConstexprVersion::Compare(*v, b);
+            switch (op) {
+                case '<': return inclusive ? cmp <= 0 : cmp < 0;
+                case '>': return inclusive ? cmp >= 0 : cmp > 0;
+                case '~': return cmp >= 0 && below(*v, b.major_, b.minor_ + 1LL, 0);
+                case '^':
+                    if (cmp < 0) return false;
+                    if (b.major_ != 0) return below(*v, b.major_ + 1LL, 0, 0);
+                    if (b.minor_ != 0) return below(*v, 0, b.minor_ + 1LL, 0);
+                    return below(*v, 0, 0, b.patch_ + 1LL);
+                default: return cmp == 0;
+            }
+        }
+
+        // Test if v is lower than exclusive upper bound M.m.p-0. Numbers past INT_MAX carry to the one on the left;
+        // a bound past INT_MAX major is higher than any version.
+        static constexpr bool below(const ConstexprVersion& v, long long M, long long m, long long p) {
+            if (p > INT_MAX) {
+                p = 0;
+                ++m;
+            }
+            if (m > INT_MAX) {
+                m = 0;
+                ++M;
+            }
+            if (M > INT_MAX) return true;
+            return v < ConstexprVersion(static_cast<int>(M), static_cast<int>(m), static_cast<int>(p));
+        }
+
+        const char* text_ = nullptr;
+        size_t size_ = 0;
+    };
+}}
+
+#endif //VERSIONING_CONSTEXPR_VERSION_H
@@ -0,0 +1,94 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_CORPUS_H
+#define VERSIONING_CORPUS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace vsn { namespace semver {
+
+    /// Shape of a generated corpus of version strings. Shares are probabilities in [0, 1].
+    struct CorpusProfile {
+        /// Construct profile resembling a mix of versions found in package registries.
+        CorpusProfile();
+
+        uint64_t seed; ///< Same seed and profile always produce the same corpus, on every platform.
+
+        int max_major; ///< Highest major version; small values are more likely, as in real registries.
+        int max_minor; ///< Highest minor version.
+        int max_patch; ///< Highest patch version.
+
+        double prerelease_share; ///< Share of versions with prerelease identifiers.
+        int min_prerelease_ids; ///< Minimum number of prerelease identifiers.
+        int max_prerelease_ids; ///< Maximum number of prerelease identifiers.
+        double numeric_id_share; ///< Share of numeric prerelease identifiers; first identifier is never numeric.
+        double common_tag_share; ///< Share of alphanumeric identifiers taken from common tags (alpha, rc, ...).
+        int min_id_length; ///< Minimum length of other alphanumeric identifiers.
+        int max_id_length; ///< Maximum length of other alphanumeric identifiers.
+
+        double build_share; ///< Share of versions with build metadata.
+        double sha_build_share; ///< Share of build metadata carrying a commit hash.
+
+        double malformed_share; ///< Share of strings which are not valid semantic versions.
+    };
+
+    /// Deterministic generator of version strings with distribution given by CorpusProfile.
+    /**
+    Uses its own pseudo-random number generator and integer arithmetic only, so output does not depend on
+    standard library implementation.
+    */
+    class CorpusGenerator {
+    public:
+        explicit CorpusGenerator(const CorpusProfile& profile = CorpusProfile());
+
+        /// Generate next version string into out, reusing its storage; return whether it is a valid version.
+        bool Next(std::string& out);
+
+        /// Generate next version string.
+        std::string Next();
+
+        /// Generate n version strings.
+        std::vector<std::string> Generate(size_t n);
+
+    private:
+        uint64_t next_random();
+        uint64_t below(uint64_t n);
+        bool chance(double share);
+        int skewed(int max);
+        void append_core(std::string& out);
+        void append_prerelease(std::string& out);
+        void append_build(std::string& out);
+        void append_alnum(std::string& out, int min_length, int max_length);
+        void append_hex(std::string& out, int length);
+        void append_malformed(std::string& out);
+
+        CorpusProfile profile_;
+        uint64_t state_;
+    };
+}}
+
+#endif //VERSIONING_CORPUS_H
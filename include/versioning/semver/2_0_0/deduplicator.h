@@ -0,0 +1,128 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_DEDUPLICATOR_H
+#define VERSIONING_DEDUPLICATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "parser.h"
+
+namespace vsn { namespace semver {
+    /// Equality deciding which versions VersionDeduplicator counts as duplicates.
+    enum class VersionEquality {
+        text, ///< Same text, byte for byte.
+        identity, ///< Same version including build metadata, e.g. " 1.0.0+b1" and "1.0.0+b1".
+        precedence ///< Same precedence, as operator== compares, e.g. "1.0.0+b1" and "1.0.0+b2".
+    };
+
+    /// Options of VersionDeduplicator.
+    struct DedupOptions {
+        VersionEquality equality = VersionEquality::identity; ///< Equality of versions.
+        bool coerce = false; ///< Coerce loose text with CoercingParser, instead of rejecting it.
+        size_t max_bytes = size_t{ 64 } << 20; ///< Cap on memory held by distinct versions and the hash table.
+    };
+
+    /// Outcome of VersionDeduplicator::Add.
+    enum class DedupResult {
+        added, ///< First occurrence of the version.
+        duplicate, ///< Version seen before; its count was incremented.
+        rejected, ///< Text is not a valid version.
+        overflow ///< First occurrence of the version, not kept as memory cap was reached.
+    };
+
+    /// Count distinct versions of a stream of version texts, in bounded memory.
+    /**
+    Every text is canonicalised before it is looked up: surrounding whitespace is trimmed and the text is
+    validated, or coerced into a version and formatted if coercion is enabled; build metadata is dropped for
+    precedence equality. Canonical texts are kept once each, in memory blocks, and looked up in an open
+    addressing hash table with linear probing, so duplicates are counted without allocating. Once the memory
+    cap is reached, new versions are no longer kept, but versions already kept are still counted.
+
+    Deduplicator is not thread safe; streams split between threads are deduplicated each on its own.
+    */
+    class VersionDeduplicator {
+    public:
+        explicit VersionDeduplicator(DedupOptions options = DedupOptions());
+
+        VersionDeduplicator(const VersionDeduplicator&) = delete;
+        VersionDeduplicator& operator=(const VersionDeduplicator&) = delete;
+
+        /// Count one occurrence of version text.
+        DedupResult Add(const char* s, size_t size);
+        DedupResult Add(const std::string& s) { return Add(s.data(), s.size()); }
+
+        /// Get number of occurrences of version with this canonical text, 0 if none were kept.
+        uint64_t Count(const std::string& canonical) const;
+
+        /// Get canonical text and number of occurrences of every version kept, in order of first occurrence.
+        std::vector<std::pair<std::string, uint64_t>> Counts() const;
+
+        size_t Distinct() const { return entries_.size(); } ///< Number of distinct versions kept.
+        uint64_t Total() const { return total_; } ///< Number of texts added.
+        uint64_t Duplicates() const { return duplicates_; } ///< Number of texts counted as duplicates.
+        uint64_t Rejected() const { return rejected_; } ///< Number of texts which are not valid versions.
+        uint64_t Overflowed() const { return overflowed_; } ///< Number of texts not counted due to memory cap.
+
+        /// Get memory held by distinct versions and the hash table.
+        size_t MemoryUsage() const;
+
+    private:
+        struct Entry {
+            const char* text;
+            uint32_t size;
+            uint32_t reserved;
+            uint64_t count;
+        };
+
+        bool canonicalise(const char*& s, size_t& size);
+        size_t find(const char* s, size_t size, uint64_t hash) const;
+        bool reserve(size_t size);
+        void rehash(size_t slot_count);
+
+        DedupOptions options_;
+        Parser parser_;
+        CoercingParser coercing_parser_;
+        CoercedVersion coerced_; ///< Storage reused by coercion.
+        std::string formatted_; ///< Canonical text of coerced version.
+
+        std::vector<uint64_t> slots_; ///< Hash tag in high half, entry index + 1 in low half; 0 for empty slot.
+        std::vector<Entry> entries_;
+        std::vector<std::unique_ptr<char[]>> blocks_; ///< Canonical texts.
+        size_t block_used_;
+        size_t block_size_;
+        size_t block_bytes_; ///< Total size of blocks.
+
+        uint64_t total_;
+        uint64_t duplicates_;
+        uint64_t rejected_;
+        uint64_t overflowed_;
+    };
+}}
+
+#endif //VERSIONING_DEDUPLICATOR_H
@@ -0,0 +1,110 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VERSIONING_IMPL_COMPARATOR_H
+#define VERSIONING_IMPL_COMPARATOR_H
+
+#include <string>
+#include <algorithm>
+#include <versioning/inline.h>
+#include <versioning/metrics.h>
+#include <versioning/semver/2_0_0/comparator.h>
+
+namespace vsn { namespace semver {
+    namespace detail {
+        // Compare normal version identifiers.
+        inline int compare_normal(const VersionData& l, const VersionData& r) {
+            if (l.major > r.major) return 1;
+            if (l.major < r.major) return -1;
+            if (l.minor > r.minor) return 1;
+            if (l.minor < r.minor) return -1;
+            if (l.patch > r.patch) return 1;
+            if (l.patch < r.patch) return -1;
+            return 0;
+        }
+
+        // Compare alphanumeric prerelease identifiers.
+        inline int cmp_alnum_prerel_ids(const std::string& l, const std::string& r) {
+            auto cmp = l.compare(r);
+            if (cmp == 0) {
+                return cmp;
+            } else {
+                return cmp > 0 ? 1 : -1;
+            }
+        }
+
+        // Compare numeric prerelease identifiers. Identifiers may be arbitrarily long, so instead of converting them
+        // to numbers, the one with more significant digits is higher and equally long ones compare as text.
+        inline int cmp_num_prerel_ids(const std::string& l, const std::string& r) {
+            auto lz = std::min(l.find_first_not_of('0'), l.size());
+            auto rz = std::min(r.find_first_not_of('0'), r.size());
+            auto llen = l.size() - lz;
+            auto rlen = r.size() - rz;
+            if (llen != rlen) return llen > rlen ? 1 : -1;
+            auto cmp = l.compare(lz, llen, r, rz, rlen);
+            if (cmp == 0) return 0;
+            return cmp > 0 ? 1 : -1;
+        }
+
+        // Compare prerelease identifiers based on their types; numeric identifiers have lower precedence than
+        // alphanumeric ones.
+        inline int compare_prerel_identifiers(const Prerelease_identifier& l, const Prerelease_identifier& r) {
+            if (l.second != r.second) return l.second == Id_type::num ? -1 : 1;
+            if (l.second == Id_type::num) return cmp_num_prerel_ids(l.first, r.first);
+            return cmp_alnum_prerel_ids(l.first, r.first);
+        }
+
+        inline int cmp_rel_prerel(const Prerelease_identifiers& l, const Prerelease_identifiers& r) {
+            if (l.empty() && !r.empty()) return 1;
+            if (r.empty() && !l.empty()) return -1;
+            return 0;
+        }
+    }
+
+    VERSIONING_INLINE int Comparator::Compare(const vsn::VersionData& l, const vsn::VersionData& r) const {
+        VERSIONING_INSTRUMENT(compare);
+
+        // Compare normal version components.
+        int cmp = detail::compare_normal(l, r);
+        if (cmp != 0) return cmp;
+
+        // Compare if one version is release and the other prerelease - release is always higher.
+        cmp = detail::cmp_rel_prerel(l.prerelease_ids, r.prerelease_ids);
+        if (cmp != 0) return cmp;
+
+        // Compare prerelease by looking at each identifier: numeric ones are compared as numbers,
+        // alphanum as ASCII strings.
+        auto shorter = std::min(l.prerelease_ids.size(), r.prerelease_ids.size());
+        for (size_t i = 0; i < shorter; i++) {
+            cmp = detail::compare_prerel_identifiers(l.prerelease_ids[i], r.prerelease_ids[i]);
+            if (cmp != 0) return cmp;
+        }
+
+        // Prerelease identifiers are the same, to the length of the shorter version string;
+        // if they are the same length, then versions are equal, otherwise, longer one wins.
+        if (l.prerelease_ids.size() == r.prerelease_ids.size()) return 0;
+        return l.prerelease_ids.size() > r.prerelease_ids.size() ? 1 : -1;
+    }
+}}
+
+#endif //VERSIONING_IMPL_COMPARATOR_H
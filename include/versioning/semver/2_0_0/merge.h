@@ -0,0 +1,303 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_MERGE_H
+#define VERSIONING_MERGE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <versioning/version_data.h>
+#include <versioning/worker_threads.h>
+#include "comparator.h"
+
+namespace vsn { namespace semver {
+
+    /// How versions differing only in build metadata are treated by merge and set operations.
+    enum class BuildMetadata {
+        ignored, ///< Versions of equal precedence are equal, as semantic versioning specifies.
+        distinct ///< Versions of equal precedence are ordered, and equal, by their build identifiers.
+    };
+
+    /// Version of a package, e.g. an entry of registry snapshot.
+    struct PackageVersion {
+        std::string package;
+        VersionData version;
+    };
+
+    /// Order of sorted version streams: version precedence, after package name for package versions.
+    class VersionOrder {
+    public:
+        explicit VersionOrder(BuildMetadata builds = BuildMetadata::ignored) : builds_{ builds } {}
+
+        /// Compare versions; returns negative, zero or positive value, as Comparator::Compare.
+        int Compare(const VersionData& l, const VersionData& r) const;
+
+        /// Compare package versions by package name, then by version.
+        int Compare(const PackageVersion& l, const PackageVersion& r) const;
+
+        template<typename T>
+        bool operator()(const T& l, const T& r) const {
+            return Compare(l, r) < 0;
+        }
+
+    private:
+        BuildMetadata builds_;
+        Comparator comparator_;
+    };
+
+    /// Merge any number of streams sorted by VersionOrder into one sorted stream, passed to sink item by item.
+    /**
+    Streams are given as pairs of forward iterators and read once, in step; memory use does not depend on their
+    length. Equal items are taken from streams in the order streams are given. If unique is set, only the first
+    of equal items is passed to sink.
+    */
+    template<typename It, typename Sink>
+    void Merge(std::vector<std::pair<It, It>> streams, Sink sink, bool unique = false,
+               BuildMetadata builds = BuildMetadata::ignored) {
+        using T = typename std::iterator_traits<It>::value_type;
+        const VersionOrder order(builds);
+        streams.erase(std::remove_if(streams.begin(), streams.end(),
+                                     [](const std::pair<It, It>& s) { return s.first == s.second; }), streams.end());
+        // Min-heap of stream indices by their current item, ties broken by stream index.
+        auto after = [&streams, &order](size_t l, size_t r) {
+            const int cmp = order.Compare(*streams[l].first, *streams[r].first);
+            return cmp > 0 || (cmp == 0 && l > r);
+        };
+        std::vector<size_t> heap;
+        for (size_t i = 0; i < streams.size(); ++i) heap.push_back(i);
+        std::make_heap(heap.begin(), heap.end(), after);
+
+        T last{};
+        bool any = false;
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), after);
+            auto& s = streams[heap.back()];
+            if (!unique || !any || order.Compare(last, *s.first) != 0) {
+                if (unique) last = *s.first;
+                any = true;
+                sink(*s.first);
+            }
+            if (++s.first == s.second) heap.pop_back();
+            else std::push_heap(heap.begin(), heap.end(), after);
+        }
+    }
+
+    /// Pass items of sorted stream [first1, last1) not present in sorted stream [first2, last2) to sink.
+    /**
+    Streams are read once, in step. As std::set_difference, an item present m times in the first stream and n
+    times in the second is passed max(m - n, 0) times.
+    */
+    template<typename It1, typename It2, typename Sink>
+    void Difference(It1 first1, It1 last1, It2 first2, It2 last2, Sink sink,
+                    BuildMetadata builds = BuildMetadata::ignored) {
+        const VersionOrder order(builds);
+        while (first1 != last1) {
+            if (first2 == last2) {
+                for (; first1 != last1; ++first1) sink(*first1);
+                return;
+            }
+            const int cmp = order.Compare(*first1, *first2);
+            if (cmp < 0) {
+                sink(*first1);
+                ++first1;
+            }
+            else {
+                if (cmp == 0) ++first1;
+                ++first2;
+            }
+        }
+    }
+
+    /// Pass items of sorted stream [first1, last1) also present in sorted stream [first2, last2) to sink.
+    /**
+    Streams are read once, in step. As std::set_intersection, an item present m times in the first stream and n
+    times in the second is passed min(m, n) times, taken from the first stream.
+    */
+    template<typename It1, typename It2, typename Sink>
+    void Intersection(It1 first1, It1 last1, It2 first2, It2 last2, Sink sink,
+                      BuildMetadata builds = BuildMetadata::ignored) {
+        const VersionOrder order(builds);
+        while (first1 != last1 && first2 != last2) {
+            const int cmp = order.Compare(*first1, *first2);
+            if (cmp < 0) ++first1;
+            else if (cmp > 0) ++first2;
+            else {
+                sink(*first1);
+                ++first1;
+                ++first2;
+            }
+        }
+    }
+
+    /// Compare sorted streams of old and new items in one pass; pass items only in old to removed and items
+    /// only in new to added.
+    template<typename It1, typename It2, typename RemovedSink, typename AddedSink>
+    void Diff(It1 old_first, It1 old_last, It2 new_first, It2 new_last, RemovedSink removed, AddedSink added,
+              BuildMetadata builds = BuildMetadata::ignored) {
+        const VersionOrder order(builds);
+        while (old_first != old_last && new_first != new_last) {
+            const int cmp = order.Compare(*old_first, *new_first);
+            if (cmp < 0) {
+                removed(*old_first);
+                ++old_first;
+            }
+            else if (cmp > 0) {
+                added(*new_first);
+                ++new_first;
+            }
+            else {
+                ++old_first;
+                ++new_first;
+            }
+        }
+        for (; old_first != old_last; ++old_first) removed(*old_first);
+        for (; new_first != new_last; ++new_first) added(*new_first);
+    }
+
+namespace detail {
+    template<typename T>
+    using Ranges = std::vector<std::pair<const T*, const T*>>;
+
+    // Key sorted inputs are partitioned on, so that equal items always fall into the same partition.
+    inline bool key_less(const PackageVersion& l, const PackageVersion& r) {
+        return l.package < r.package;
+    }
+
+    inline bool key_less(const VersionData& l, const VersionData& r) {
+        return l.major < r.major;
+    }
+
+    // Partitions smaller than this are not worth handing to another thread.
+    const size_t min_items_per_partition = 4096;
+
+    // Cut sorted inputs into partitions on key boundaries and call process(partition, ranges) for each, on up
+    // to threads worker threads. Cut keys are taken at even intervals of the longest input. Returns number of
+    // partitions; the first exception thrown by process is rethrown once all workers stop.
+    template<typename T, typename F>
+    size_t for_each_partition(const std::vector<const std::vector<T>*>& inputs, unsigned threads, F process) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        const std::vector<T>* longest = inputs.front();
+        for (auto in : inputs) if (in->size() > longest->size()) longest = in;
+
+        // A few partitions per thread even out partitions of different cost.
+        const size_t wanted = std::min<size_t>(threads * 4,
+                                               std::max<size_t>(1, longest->size() / min_items_per_partition));
+        std::vector<std::vector<size_t>> cuts; // cuts[p][i]: start of partition p in input i
+        for (size_t p = 0; p < wanted; ++p) {
+            std::vector<size_t> cut;
+            if (p == 0) cut.assign(inputs.size(), 0);
+            else {
+                const T& key = (*longest)[longest->size() * p / wanted];
+                auto less = [](const T& l, const T& r) { return key_less(l, r); };
+                for (auto in : inputs) {
+                    auto at = std::lower_bound(in->begin(), in->end(), key, less);
+                    cut.push_back(static_cast<size_t>(at - in->begin()));
+                }
+                if (cut == cuts.back()) continue; // key spans the whole previous interval
+            }
+            cuts.push_back(std::move(cut));
+        }
+        std::vector<size_t> end;
+        for (auto in : inputs) end.push_back(in->size());
+        cuts.push_back(std::move(end));
+
+        const size_t partitions = cuts.size() - 1;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<bool> failed{ false };
+        std::exception_ptr error;
+        auto work = [&](size_t) {
+            Ranges<T> ranges(inputs.size());
+            for (size_t p; !failed && (p = next++) < partitions;) {
+                for (size_t i = 0; i < inputs.size(); ++i) {
+                    ranges[i] = { inputs[i]->data() + cuts[p][i], inputs[i]->data() + cuts[p + 1][i] };
+                }
+                try {
+                    process(p, ranges);
+                } catch (...) {
+                    if (!failed.exchange(true)) error = std::current_exception();
+                }
+            }
+        };
+
+        run_workers(std::min<size_t>(threads, partitions), work);
+        if (error) std::rethrow_exception(error);
+        return partitions;
+    }
+}
+
+    /// Merge sorted vectors on multiple threads, partitioned by package name, or by major version for versions.
+    /**
+    Partitions are numbered in stream order; sink(partition, item) receives items of one partition in order
+    and on one thread, while different partitions are merged concurrently. Concatenating partitions in order
+    gives the result of Merge. threads == 0 uses all hardware threads. Returns number of partitions.
+    */
+    template<typename T, typename Sink>
+    size_t ParallelMerge(const std::vector<const std::vector<T>*>& inputs, Sink sink, bool unique = false,
+                         unsigned threads = 0, BuildMetadata builds = BuildMetadata::ignored) {
+        if (inputs.empty()) return 0;
+        return detail::for_each_partition(inputs, threads, [&](size_t p, const detail::Ranges<T>& r) {
+            Merge(r, [&sink, p](const T& item) { sink(p, item); }, unique, builds);
+        });
+    }
+
+    /// Difference of sorted vectors on multiple threads, partitioned as by ParallelMerge.
+    template<typename T, typename Sink>
+    size_t ParallelDifference(const std::vector<T>& first, const std::vector<T>& second, Sink sink,
+                              unsigned threads = 0, BuildMetadata builds = BuildMetadata::ignored) {
+        return detail::for_each_partition<T>({ &first, &second }, threads, [&](size_t p, const detail::Ranges<T>& r) {
+            Difference(r[0].first, r[0].second, r[1].first, r[1].second, [&sink, p](const T& item) { sink(p, item); },
+                       builds);
+        });
+    }
+
+    /// Intersection of sorted vectors on multiple threads, partitioned as by ParallelMerge.
+    template<typename T, typename Sink>
+    size_t ParallelIntersection(const std::vector<T>& first, const std::vector<T>& second, Sink sink,
+                                unsigned threads = 0, BuildMetadata builds = BuildMetadata::ignored) {
+        return detail::for_each_partition<T>({ &first, &second }, threads, [&](size_t p, const detail::Ranges<T>& r) {
+            Intersection(r[0].first, r[0].second, r[1].first, r[1].second, [&sink, p](const T& item) { sink(p, item); },
+                         builds);
+        });
+    }
+
+    /// Diff of sorted vectors on multiple threads, partitioned as by ParallelMerge.
+    template<typename T, typename RemovedSink, typename AddedSink>
+    size_t ParallelDiff(const std::vector<T>& old_items, const std::vector<T>& new_items, RemovedSink removed,
+                        AddedSink added, unsigned threads = 0, BuildMetadata builds = BuildMetadata::ignored) {
+        auto diff = [&](size_t p, const detail::Ranges<T>& r) {
+            Diff(r[0].first, r[0].second, r[1].first, r[1].second, [&removed, p](const T& item) { removed(p, item); },
+                 [&added, p](const T& item) { added(p, item); }, builds);
+        };
+        return detail::for_each_partition<T>({ &old_items, &new_items }, threads, diff);
+    }
+}}
+
+#endif //VERSIONING_MERGE_H
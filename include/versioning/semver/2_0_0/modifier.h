@@ -28,6 +28,12 @@ SOFTWARE.
 #include <versioning/version_modifier.h>
 
 namespace vsn { namespace semver {
+    /// Semver 2.0.0 modification rules.
+    /**
+    Identifiers passed to pre-release and build setters are validated against semver rules (non-empty, made of
+    [0-9A-Za-z-] only, numeric pre-release identifiers without leading zeros and with matching Id_type);
+    invalid identifiers result in Modification_error.
+    */
     class Modifier: public VersionModifier {
     public:
         /// Set major version to specified value leaving all other components unchanged..
@@ -59,6 +65,31 @@ namespace vsn { namespace semver {
 
         /// Set build version to specified value.
         VersionData ResetBuild(const VersionData &, const Build_identifiers &) const override;
+
+        /// Increment last numeric pre-release identifier, or append numeric identifier 0 if there is none.
+        /**
+        Release versions get their patch version incremented and pre-release set to "0", so that the result
+        is always of higher precedence than the source ("1.2.3" -> "1.2.4-0", "1.2.3-rc" -> "1.2.3-rc.0",
+        "1.2.3-rc.4" -> "1.2.3-rc.5"). Build component is reset.
+        */
+        VersionData IncPreRelease(const VersionData &) const override;
+
+        /// Overloads reusing storage of the source object, following rules of the copying overloads above.
+        /**
+        Passed object is left in a valid but unspecified state. Arguments are validated before it is changed,
+        so on Modification_error it is left unchanged.
+        */
+        VersionData SetMajor(VersionData&&, const int) const override;
+        VersionData SetMinor(VersionData&&, const int) const override;
+        VersionData SetPatch(VersionData&&, const int) const override;
+        VersionData SetPreRelease(VersionData&&, const Prerelease_identifiers&) const override;
+        VersionData SetBuild(VersionData&&, const Build_identifiers&) const override;
+        VersionData ResetMajor(VersionData&&, const int) const override;
+        VersionData ResetMinor(VersionData&&, const int) const override;
+        VersionData ResetPatch(VersionData&&, const int) const override;
+        VersionData ResetPreRelease(VersionData&&, const Prerelease_identifiers&) const override;
+        VersionData ResetBuild(VersionData&&, const Build_identifiers&) const override;
+        VersionData IncPreRelease(VersionData&&) const override;
     };
 }}
 
@@ -0,0 +1,136 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_PACKED_VERSION_LIST_H
+#define VERSIONING_PACKED_VERSION_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <versioning/version_data.h>
+
+namespace vsn { namespace semver {
+
+    /// Compact container of versions sorted by precedence, such as release history of a package.
+    /**
+    Each version is stored as a delta against the previous one: only version components from the first one
+    that changed, only prerelease identifiers past the ones shared with the last prerelease, and build
+    identifiers only if they changed. "2.3.14-rc.2" following "2.3.14-rc.1", or "2.3.14" following
+    "2.3.14-rc.2", takes a single byte.
+
+    Versions are grouped in blocks of fixed size whose first version is stored in full, so any version is
+    decoded from at most one block and lookups binary search over blocks. Versions of equal precedence are
+    ordered by build identifiers.
+    */
+    class PackedVersionList {
+    public:
+        /// Default number of versions in a block.
+        static const size_t default_block_size = 64;
+
+        /// Sequential decoder of list, reusing storage of current version for the next one.
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = VersionData;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const VersionData*;
+            using reference = const VersionData&;
+
+            Iterator() : list_{ nullptr }, index_{ 0 }, block_end_{ 0 }, pos_{ nullptr } {}
+
+            reference operator*() const { return current_; }
+            pointer operator->() const { return &current_; }
+            Iterator& operator++();
+            Iterator operator++(int) { Iterator it = *this; ++*this; return it; }
+
+            /// Get index of current version in list.
+            size_t Index() const { return index_; }
+
+            friend bool operator==(const Iterator& l, const Iterator& r) { return l.index_ == r.index_; }
+            friend bool operator!=(const Iterator& l, const Iterator& r) { return l.index_ != r.index_; }
+
+        private:
+            friend class PackedVersionList;
+            Iterator(const PackedVersionList* list, size_t block);
+
+            const PackedVersionList* list_;
+            size_t index_;
+            size_t block_end_; ///< Index of first version of next block.
+            const uint8_t* pos_; ///< Next entry to decode.
+            VersionData current_;
+            Prerelease_identifiers reference_; ///< Last non-empty prerelease identifiers, while current is release.
+        };
+
+        explicit PackedVersionList(size_t block_size = default_block_size);
+
+        /// Build list from versions in any order.
+        explicit PackedVersionList(std::vector<VersionData> versions, size_t block_size = default_block_size);
+
+        /// Append version which does not precede the last one; returns false and leaves list unchanged otherwise.
+        bool Append(const VersionData& v);
+
+        size_t Size() const { return size_; }
+        bool Empty() const { return size_ == 0; }
+        size_t BlockSize() const { return block_size_; }
+        size_t BlockCount() const { return blocks_.size(); }
+
+        /// Get number of bytes taken by encoded versions and block index.
+        size_t Bytes() const { return bytes_.size() + blocks_.size() * sizeof(size_t); }
+
+        /// Decode version at index, which must be less than Size().
+        VersionData At(size_t index) const;
+
+        /// Get iterator to version at index, decoding versions before it in its block.
+        Iterator Seek(size_t index) const;
+
+        /// Get iterator to first version which does not precede v.
+        Iterator LowerBound(const VersionData& v) const;
+
+        /// Get iterator to first version which v precedes.
+        Iterator UpperBound(const VersionData& v) const;
+
+        Iterator begin() const;
+        Iterator end() const;
+
+        /// Decode all versions.
+        std::vector<VersionData> ToVector() const;
+
+        /// Release capacity reserved for further versions.
+        void ShrinkToFit();
+
+    private:
+        friend class Iterator;
+        Iterator bound(const VersionData& v, bool upper) const;
+
+        size_t block_size_;
+        size_t size_;
+        std::vector<uint8_t> bytes_;
+        std::vector<size_t> blocks_; ///< Offset of first version of each block.
+        VersionData last_; ///< Last appended version, base of next delta.
+        Prerelease_identifiers last_prerelease_; ///< Last non-empty prerelease identifiers, while last is release.
+    };
+}}
+
+#endif //VERSIONING_PACKED_VERSION_LIST_H
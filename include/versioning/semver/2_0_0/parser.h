@@ -25,62 +25,59 @@ SOFTWARE.
 #ifndef VERSIONING_PARSER_H
 #define VERSIONING_PARSER_H
 
-#include <map>
-#include <functional>
 #include <versioning/version_parser.h>
 
 namespace vsn { namespace semver {
-    using Validator = std::function<void(const std::string&, const char)>;
-    using State_transition_hook = std::function<void(std::string&)>;
-    /// State transition is described by a character that triggers it, a state to transition to and
-    /// optional hook to be invoked on transition.
-    enum class ParserState {
-        major, minor, patch, prerelease, build
-    };
-    using Transition = std::tuple<const char, ParserState, State_transition_hook>;
-    using Transitions = std::vector<Transition>;
-    using State = std::tuple<Transitions, std::string&, Validator>;
-    using State_machine = std::map<ParserState, State>;
-
     class Parser: public VersionParser {
     public:
         VersionData Parse(const std::string &s) const override;
 
-    private:
+        Prerelease_identifiers ParsePreRelease(const std::string& s) const override;
 
-        // Ranges of characters allowed in prerelease and build identifiers.
-        const static std::vector<std::pair<char, char>> allowed_prerel_id_chars;
+        Build_identifiers ParseBuild(const std::string& s) const override;
 
-        inline Transition mkx(const char c, ParserState p, State_transition_hook pth) const;
+        /// Check whether text is a valid version, in one pass, without allocating or throwing.
+        bool IsValid(const char* s, size_t size) const;
 
-        /// Advance parser state machine by a single step.
-        /**
-        Perform single step of parser state machine: if character matches one from transition tables -
-        trigger transition to next state; otherwise, validate if current token is in legal state
-        (throw Parse_error if not) and then add character to current token; State transition includes
-        preparing various vars for next state and invoking state transition hook (if specified) which is
-        where whole tokens are validated.
-        */
-        inline void process_char(const char c, ParserState& cstate, ParserState& pstate,
-                                  const Transitions& transitions, std::string& target, Validator validate) const;
+        /// Check whether text is a valid version; if not, store the reason Parse would fail with.
+        bool IsValid(const char* s, size_t size, ParseErrorReason& reason) const;
+    };
 
-        /// Validate normal (major, minor, patch) version components.
-        inline static void normal_version_validator(const std::string& tgt, const char c);
+    /// Normalisation applied by CoercingParser to loose version text.
+    enum class Coercion : unsigned {
+        trimmed = 1, ///< Surrounding whitespace removed
+        prefix = 2, ///< Text before the first digit removed, e.g. "v" or "release-"
+        padded = 4, ///< Missing minor or patch version set to 0
+        extra_components = 8, ///< Numbers after patch version moved to build metadata, e.g. "1.2.3.4" to "1.2.3+4"
+        leading_zero = 16, ///< Leading zeros removed from version numbers or numeric prerelease identifiers
+        separator = 32, ///< Missing or other separator before prerelease identifiers replaced with '-'
+        invalid_character = 64, ///< Characters not allowed in identifiers replaced with '-'
+        empty_identifier = 128 ///< Empty identifiers removed
+    };
 
-        /// Validate that prerelease and build version identifiers are comprised of allowed chars only.
-        inline static void prerelease_version_validator(const std::string&, const char c);
+    /// Version coerced from loose text, with normalisations that were applied.
+    struct CoercedVersion {
+        VersionData version;
+        unsigned coercions = 0; ///< Coercion values combined with bitwise or; 0 if text was a valid version.
 
-        /// Validate every individual prerelease identifier, determine it's type and add it to collection.
-        inline bool is_identifier_numeric(const std::string& id) const;
+        bool Has(const Coercion c) const { return (coercions & static_cast<unsigned>(c)) != 0; }
+    };
 
-        inline bool check_for_leading_0(const std::string& str) const;
+    /// Parser of near-semver text, such as "v1.2", "1.2.3.4", " 1.02.3 " or "release-1.4.0".
+    /**
+    Text is normalised into a valid version in a single pass, with no retries; any text holding a version
+    number is accepted. Valid versions come out as Parser would parse them, with no coercions reported.
+    */
+    class CoercingParser : public VersionParser {
+    public:
+        /// Coerce text into version; throws ParseError if it holds no version number, or one out of range.
+        CoercedVersion Coerce(const std::string& s) const;
 
-        /// Validate every individual prerelease identifier, determine it's type and add it to collection.
-        void prerelease_hook_impl(std::string& id, Prerelease_identifiers& prerelease) const;
+        /// Coerce text into out, reusing its storage; returns false instead of throwing ParseError.
+        bool TryCoerce(const std::string& s, CoercedVersion& out) const;
+        bool TryCoerce(const char* s, size_t size, CoercedVersion& out) const;
 
-        /// Validate every individual build identifier and add it to collection.
-        void build_hook_impl(std::string& id, ParserState& pstate, Build_identifiers& build,
-                             std::string& prerelease_id, Prerelease_identifiers& prerelease) const;
+        VersionData Parse(const std::string& s) const override;
     };
 }}
 
@@ -0,0 +1,78 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_PIPELINE_STAGES_H
+#define VERSIONING_PIPELINE_STAGES_H
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <versioning/pipeline.h>
+#include "version.h"
+
+namespace vsn { namespace semver {
+
+    /// Parse version strings, dropping those that are not valid semantic versions.
+    /**
+    Number of dropped strings is the difference between stage's input and output item counts.
+    */
+    class ParseStage : public Stage<std::string, Version> {
+    public:
+        void operator()(std::vector<std::string>& batch, std::vector<Version>& out) const;
+    };
+
+    /// Drop versions equal to one seen before, including build metadata.
+    class DedupeStage : public Stage<Version, Version> {
+    public:
+        static const unsigned max_threads = 1;
+
+        void operator()(std::vector<Version>& batch, std::vector<Version>& out);
+
+    private:
+        std::unordered_set<std::string> seen_;
+    };
+
+    /// Collect all versions and emit them in ascending precedence order, as decided by semver Comparator.
+    /**
+    Versions of equal precedence keep their input order. Nothing is emitted before input is exhausted.
+    */
+    class SortStage : public Stage<Version, Version> {
+    public:
+        static const unsigned max_threads = 1;
+
+        void operator()(std::vector<Version>& batch, std::vector<Version>& out);
+        void Flush(std::vector<Version>& out);
+
+    private:
+        std::vector<Version> held_;
+    };
+
+    /// Format versions as strings.
+    class FormatStage : public Stage<Version, std::string> {
+    public:
+        void operator()(std::vector<Version>& batch, std::vector<std::string>& out) const;
+    };
+}}
+
+#endif //VERSIONING_PIPELINE_STAGES_H
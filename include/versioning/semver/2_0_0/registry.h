@@ -0,0 +1,128 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_REGISTRY_H
+#define VERSIONING_REGISTRY_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <versioning/epoch.h>
+#include "version.h"
+
+namespace vsn { namespace semver {
+    /// Contiguous run of versions, in ascending precedence order.
+    struct VersionRange {
+        const Version* first;
+        const Version* last;
+
+        const Version* begin() const { return first; }
+        const Version* end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+    };
+
+    /// Concurrent map from package name to its versions, sorted by semver precedence.
+    /**
+    Reads never take locks: a Snapshot pins an epoch (see EpochDomain) and reads immutable version lists.
+    Writers are serialized; publishing a version copies affected package's version list, inserts the version
+    and swaps list pointer, retiring the old list once no snapshot can observe it. Adding a new package
+    additionally copies one of the hash shards the package table is split into.
+
+    Versions of equal precedence but different build metadata are kept side by side, ordered by insertion;
+    publishing a version already present with identical build metadata has no effect.
+    */
+    class Registry {
+    public:
+        class Snapshot;
+
+        Registry();
+        Registry(const Registry&) = delete;
+        Registry& operator=(const Registry&) = delete;
+        ~Registry();
+
+        /// Add version to the package, creating the package if needed; return false if it was already present.
+        bool Publish(const std::string& package, const Version& version);
+
+        /// Add several versions to the package with a single copy of it's version list; return number added.
+        size_t Publish(const std::string& package, std::vector<Version> versions);
+
+        /// Pin current state of the registry for reading.
+        Snapshot Read() const;
+
+    private:
+        using Versions = std::vector<Version>;
+
+        struct Package {
+            std::atomic<const Versions*> versions;
+        };
+
+        using Shard = std::unordered_map<std::string, Package*>;
+
+        static const size_t shard_count = 64;
+
+        std::atomic<const Shard*>& shard_for(const std::string& package) const;
+        const Versions* find(const std::string& package) const;
+        Package& get_or_add_locked(const std::string& package);
+        void replace_locked(Package& p, const Versions* list);
+
+        mutable EpochDomain domain_;
+        mutable std::atomic<const Shard*> shards_[shard_count];
+        std::mutex write_mutex_;
+        std::vector<std::unique_ptr<Package>> packages_;
+    };
+
+    /// Lock-free read access to package version lists.
+    /**
+    Each query sees the package's version list as of the time of the query. Pointers and ranges returned by
+    queries stay valid for as long as the snapshot is alive, even if newer versions are published meanwhile.
+    */
+    class Registry::Snapshot {
+    public:
+        /// Get highest version of the package; prereleases are skipped unless requested. Null if there is none.
+        const Version* Latest(const std::string& package, bool prerelease = false) const;
+
+        /// Get highest version of the package with given major version. Null if there is none.
+        const Version* LatestInMajor(const std::string& package, int major, bool prerelease = false) const;
+
+        /// Get all versions of the package in range [low, high).
+        VersionRange Range(const std::string& package, const Version& low, const Version& high) const;
+
+        /// Get all versions of the package.
+        VersionRange All(const std::string& package) const;
+
+    private:
+        friend class Registry;
+
+        explicit Snapshot(const Registry& registry);
+
+        const Registry& registry_;
+        EpochDomain::Guard guard_;
+    };
+}}
+
+#endif //VERSIONING_REGISTRY_H
@@ -0,0 +1,77 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_TOP_VERSIONS_H
+#define VERSIONING_TOP_VERSIONS_H
+
+#include <cstddef>
+#include <vector>
+#include <versioning/version_data.h>
+#include "comparator.h"
+
+namespace vsn { namespace semver {
+    /// Select the K newest versions of a stream, in memory bounded by K.
+    /**
+    Versions are kept in a min-heap ordered by Comparator, so its top is the K-th newest version seen so far.
+    Once the heap is full, most versions are rejected by comparing just major, minor and patch against those
+    of the top, cached as integers; prerelease identifiers are compared only when these are equal.
+
+    Selectors fed on different threads are combined with Merge, once the threads are done.
+    */
+    class TopVersions {
+    public:
+        /// Create selector of k newest versions, skipping prereleases unless requested; with unique, versions
+        /// equal in precedence are kept once.
+        explicit TopVersions(size_t k, bool prerelease = true, bool unique = false);
+
+        /// Offer version; returns true if it is among the k newest seen so far.
+        bool Add(const VersionData& v);
+        bool Add(VersionData&& v);
+
+        /// Offer all versions kept by other selector; merging selector with itself changes nothing.
+        void Merge(const TopVersions& other);
+        void Merge(TopVersions&& other);
+
+        /// Get versions kept, newest first.
+        std::vector<VersionData> Result() const;
+
+        size_t K() const { return k_; }
+        size_t Size() const { return heap_.size(); }
+
+    private:
+        // Check whether version is to be kept, before it is copied or moved in.
+        bool admit(const VersionData& v) const;
+        void push(VersionData&& v);
+        void update_threshold();
+
+        size_t k_;
+        bool prerelease_;
+        bool unique_;
+        Comparator comparator_;
+        std::vector<VersionData> heap_;
+        int threshold_[3]; ///< Major, minor and patch of heap top, once heap is full.
+    };
+}}
+
+#endif //VERSIONING_TOP_VERSIONS_H
@@ -0,0 +1,76 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_VALIDATOR_H
+#define VERSIONING_VALIDATOR_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <versioning/version_parser.h>
+#include "parser.h"
+
+namespace vsn { namespace semver {
+    /// Aggregate result of BulkValidator::Validate.
+    struct ValidationReport {
+        size_t checked = 0; ///< Number of versions checked.
+        size_t invalid = 0; ///< Number of invalid versions.
+        size_t counts[parse_error_reason_count] = {}; ///< Number of invalid versions by ParseErrorReason.
+        std::vector<size_t> samples[parse_error_reason_count]; ///< Lowest positions of invalid versions by reason.
+
+        size_t Count(const ParseErrorReason r) const { return counts[static_cast<size_t>(r)]; }
+        const std::vector<size_t>& Samples(const ParseErrorReason r) const { return samples[static_cast<size_t>(r)]; }
+    };
+
+    /// Lint large numbers of version strings on multiple threads.
+    /**
+    Versions are checked with Parser::IsValid, so nothing is allocated or thrown per version; each worker
+    aggregates its part of the input, and parts are combined in input order, so reports do not depend on the
+    number of threads.
+    */
+    class BulkValidator {
+    public:
+        /// Create validator keeping up to max_samples positions per reason; threads == 0 uses all hardware threads.
+        explicit BulkValidator(unsigned threads = 0, size_t max_samples = 16);
+
+        /// Validate n version strings; positions are indexes into in.
+        ValidationReport Validate(const std::string* in, size_t n) const;
+
+        /// Validate text holding one version per line, e.g. a manifest; positions are line numbers, from 0.
+        /**
+        Lines end with "\n" or "\r\n"; empty lines are skipped.
+        */
+        ValidationReport Validate(const char* text, size_t size) const;
+
+    private:
+        template<typename F>
+        ValidationReport run(size_t workers, F check_part) const;
+
+        unsigned threads_;
+        size_t max_samples_;
+        Parser parser_;
+    };
+}}
+
+#endif //VERSIONING_VALIDATOR_H
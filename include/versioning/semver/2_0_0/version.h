@@ -37,10 +37,16 @@ namespace vsn { namespace semver {
     public:
         Version():GenericVersion(){}
 
-        Version(const std::string& v):GenericVersion(v){}
+        Version(std::string v):GenericVersion(std::move(v)){}
 
-        Version(const VersionData& v):GenericVersion(v){}
+        Version(VersionData v):GenericVersion(std::move(v)){}
     };
+
+    /// Semver 2.0.0 version compared without virtual calls; see StaticDispatch.
+    using StaticVersion = vsn::GenericVersion<Parser, Comparator, Modifier, StaticDispatch>;
+
+    /// Builder applying semver 2.0.0 modifications in place.
+    using VersionBuilder = Version::Builder;
 }}
 
 #endif //SEMVER_VERSION_H
\ No newline at end of file
@@ -0,0 +1,60 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_VERSION_DIFF_H
+#define VERSIONING_VERSION_DIFF_H
+
+#include <cstddef>
+#include <versioning/version_data.h>
+
+namespace vsn { namespace semver {
+    /// Kind of change from one version to another.
+    enum class VersionDiff {
+        none, ///< Same version, including build metadata.
+        major, ///< Upgrade to higher major version.
+        minor, ///< Upgrade to higher minor version of the same major version.
+        patch, ///< Upgrade to higher patch version of the same minor version.
+        prerelease, ///< Upgrade within the same major, minor and patch version, e.g. "1.0.0-rc.1" to "1.0.0".
+        build, ///< Same precedence, different build metadata.
+        downgrade ///< Lower precedence.
+    };
+
+    /// Number of VersionDiff values.
+    const size_t version_diff_count = 7;
+
+    /// Get name of the difference kind, as used in reports.
+    const char* ToString(VersionDiff diff);
+
+    /// Classify change from version from to version to, by Comparator precedence rules.
+    VersionDiff Diff(const VersionData& from, const VersionData& to);
+
+    /// Classify changes from[i] to to[i] for n pairs, storing them to out[0, n).
+    /**
+    Pairs are classified in two passes: the first compares major, minor and patch of all pairs without
+    branches, the second compares identifiers of pairs tied in those only.
+    */
+    void Diff(const VersionData* from, const VersionData* to, size_t n, VersionDiff* out);
+}}
+
+#endif //VERSIONING_VERSION_DIFF_H
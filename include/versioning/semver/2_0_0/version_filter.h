@@ -0,0 +1,134 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_VERSION_FILTER_H
+#define VERSIONING_VERSION_FILTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <versioning/version_data.h>
+#include "merge.h"
+#include "parser.h"
+
+namespace vsn { namespace semver {
+    /// Immutable approximate membership filter of package versions.
+    /**
+    Split block Bloom filter: every key sets one bit in each of the eight 32-bit words of a single 32 byte
+    block, so a probe reads one cache line and its eight word tests map to one 256-bit SIMD operation, which
+    compilers generate from the plain loops used here. A filter never misses a version it was built with;
+    other versions are reported as possibly present at a rate of about 0.15% at the default 16 bits per key,
+    and 3.5% at 8 bits per key.
+
+    Keys are package names with canonical versions, so versions equal in precedence (differing in build
+    metadata or surrounding whitespace) hash the same.
+    */
+    class VersionFilter {
+    public:
+        /// Create empty filter, containing nothing.
+        VersionFilter();
+
+        /// Copy filter; blocks of the copy are aligned for its own storage.
+        VersionFilter(const VersionFilter& other);
+        VersionFilter(VersionFilter&&) = default;
+        VersionFilter& operator=(const VersionFilter& other);
+        VersionFilter& operator=(VersionFilter&&) = default;
+
+        /// Get hash of package version, as used by the filter.
+        static uint64_t Hash(const std::string& package, const VersionData& version);
+
+        /// Get hash of package version text; returns false if text is not a valid version.
+        static bool Hash(const std::string& package, const char* version, size_t size, uint64_t& hash);
+
+        /// Check whether version of the package may be in the filter.
+        bool MayContain(const std::string& package, const VersionData& version) const;
+
+        /// Check whether version text of the package may be in the filter; invalid text is never in the filter.
+        bool MayContain(const std::string& package, const std::string& version) const;
+
+        /// Check whether key with given hash may be in the filter.
+        bool MayContain(uint64_t hash) const;
+
+        /// Check n hashes at once, storing results to out[0, n); blocks are prefetched ahead of probes.
+        void MayContain(const uint64_t* hashes, size_t n, bool* out) const;
+
+        size_t KeyCount() const { return key_count_; } ///< Number of keys filter was built with.
+        size_t Bytes() const { return block_count_ * block_words * sizeof(uint32_t); } ///< Size of filter blocks.
+
+        /// Serialise filter, in native byte order.
+        std::vector<uint8_t> Serialize() const;
+
+        /// Read serialised filter; throws ParseError if data is not a valid filter.
+        static VersionFilter Deserialize(const uint8_t* data, size_t size);
+
+        /// Write serialised filter to file; throws std::system_error on failure.
+        void Write(const std::string& path) const;
+
+        /// Read filter from file; throws std::system_error if it cannot be read, ParseError if it is invalid.
+        static VersionFilter Read(const std::string& path);
+
+    private:
+        friend class VersionFilterBuilder;
+
+        static const size_t block_words = 8;
+
+        VersionFilter(size_t block_count, size_t key_count);
+        uint32_t* blocks() { return words_.data() + offset_; }
+        const uint32_t* blocks() const { return words_.data() + offset_; }
+        size_t block_of(uint64_t hash) const; ///< Get index of first word of block for hash.
+        void insert(uint64_t hash);
+
+        std::vector<uint32_t> words_;
+        size_t offset_; ///< Index of first word of the first block, aligned to block size.
+        size_t block_count_;
+        size_t key_count_;
+    };
+
+    /// Builder of VersionFilter, collecting key hashes only.
+    class VersionFilterBuilder {
+    public:
+        /// Default number of filter bits per key.
+        static constexpr double default_bits_per_key = 16;
+
+        void Add(const std::string& package, const VersionData& version);
+
+        /// Add version text of the package; throws ParseError if version is invalid.
+        void Add(const std::string& package, const std::string& version);
+
+        /// Add all versions of a list.
+        void Add(const std::vector<PackageVersion>& versions);
+
+        /// Get number of versions added.
+        size_t Size() const { return hashes_.size(); }
+
+        /// Build filter sized for bits_per_key bits per version added.
+        VersionFilter Build(double bits_per_key = default_bits_per_key) const;
+
+    private:
+        std::vector<uint64_t> hashes_;
+    };
+}}
+
+#endif //VERSIONING_VERSION_FILTER_H
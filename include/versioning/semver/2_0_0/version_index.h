@@ -0,0 +1,195 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_VERSION_INDEX_H
+#define VERSIONING_VERSION_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <versioning/version_data.h>
+#include "merge.h"
+#include "wire.h"
+
+namespace vsn { namespace semver {
+    class VersionIndex;
+
+    /// Version stored in a VersionIndex: comparable key and original text, both read in place.
+    class IndexedVersion {
+    public:
+        /// Construct null version, returned by queries which found nothing.
+        IndexedVersion() : key_{ nullptr }, key_size_{ 0 }, text_{ nullptr }, text_size_{ 0 } {}
+
+        IndexedVersion(const uint8_t* key, size_t key_size, const char* text, size_t text_size)
+                : key_{ key }, key_size_{ key_size }, text_{ text }, text_size_{ text_size } {}
+
+        explicit operator bool() const { return key_ != nullptr; }
+
+        /// Get key, version in binary encoding; throws ParseError if index is corrupt.
+        WireVersion Key() const { return WireVersion(key_, key_size_); }
+
+        /// Decode key.
+        VersionData Data() const { return Decode(key_, key_size_); }
+
+        /// Get text version was indexed from.
+        std::string Text() const { return std::string(text_, text_size_); }
+        const char* TextData() const { return text_; }
+        size_t TextSize() const { return text_size_; }
+
+    private:
+        const uint8_t* key_;
+        size_t key_size_;
+        const char* text_;
+        size_t text_size_;
+    };
+
+    /// Contiguous run of indexed versions of one package, in ascending precedence order.
+    class IndexRange {
+    public:
+        class Iterator {
+        public:
+            Iterator(const IndexRange* range, size_t i) : range_{ range }, i_{ i } {}
+
+            IndexedVersion operator*() const { return (*range_)[i_]; }
+            Iterator& operator++() { ++i_; return *this; }
+            friend bool operator==(const Iterator& l, const Iterator& r) { return l.i_ == r.i_; }
+            friend bool operator!=(const Iterator& l, const Iterator& r) { return l.i_ != r.i_; }
+
+        private:
+            const IndexRange* range_;
+            size_t i_;
+        };
+
+        IndexRange() : index_{ nullptr }, first_{ 0 }, last_{ 0 } {}
+        IndexRange(const VersionIndex* index, size_t first, size_t last)
+                : index_{ index }, first_{ first }, last_{ last } {}
+
+        IndexedVersion operator[](size_t i) const;
+        Iterator begin() const { return Iterator(this, 0); }
+        Iterator end() const { return Iterator(this, size()); }
+        size_t size() const { return last_ - first_; }
+        bool empty() const { return first_ == last_; }
+
+    private:
+        friend class VersionIndex;
+
+        const VersionIndex* index_;
+        size_t first_; ///< Position of first version in index.
+        size_t last_;
+    };
+
+    /// Read-only index of package versions, queried in place in a memory-mapped file.
+    /**
+    Opening an index maps the file and checks its header; nothing is parsed or copied, so startup time does not
+    depend on index size, and processes mapping the same file share its pages. Queries binary search package
+    names and then versions, comparing precedence on binary encoded keys (see WireVersion); a corrupt index
+    results in ParseError, never in a read outside the file.
+
+    File layout, in native byte order, built by VersionIndexBuilder:
+
+        header: magic, format version, byte order mark, counts and offsets of the tables below
+        package table: name, first version and version count of each package, sorted by name
+        version table: key and text location, major version and flags of each version, grouped by package and
+                       sorted by precedence, then build metadata
+        data: package names, and key followed by text of each version
+    */
+    class VersionIndex {
+    public:
+        /// Map index file; throws std::system_error if it cannot be read, ParseError if it is not a valid index.
+        explicit VersionIndex(const std::string& path);
+
+        /// View index stored in memory, e.g. built by VersionIndexBuilder::Build; data must outlive the index.
+        VersionIndex(const void* data, size_t size);
+
+        VersionIndex(const VersionIndex&) = delete;
+        VersionIndex& operator=(const VersionIndex&) = delete;
+        ~VersionIndex();
+
+        size_t PackageCount() const { return package_count_; }
+        size_t VersionCount() const { return version_count_; }
+
+        /// Get highest version of the package; prereleases are skipped unless requested. Null if there is none.
+        IndexedVersion Latest(const std::string& package, bool prerelease = false) const;
+
+        /// Get highest version of the package with given major version. Null if there is none.
+        IndexedVersion LatestInMajor(const std::string& package, int major, bool prerelease = false) const;
+
+        /// Get all versions of the package in range [low, high).
+        IndexRange Range(const std::string& package, const VersionData& low, const VersionData& high) const;
+
+        /// Get all versions of the package.
+        IndexRange All(const std::string& package) const;
+
+        /// Get version of the package indexed from exactly this text. Null if there is none or text is invalid.
+        IndexedVersion Find(const std::string& package, const std::string& version) const;
+
+    private:
+        friend class IndexRange;
+
+        void attach(const void* data, size_t size);
+        IndexedVersion version_at(size_t i) const;
+        IndexRange package_versions(const std::string& package) const;
+        size_t lower_bound(const IndexRange& versions, const std::vector<uint8_t>& key) const;
+
+        const uint8_t* data_;
+        size_t size_;
+        void* mapping_; ///< Mapped file, null for index viewed in memory.
+        std::vector<uint8_t> buffer_; ///< File contents, where files cannot be mapped.
+        size_t package_count_;
+        size_t version_count_;
+        const uint8_t* packages_;
+        const uint8_t* versions_;
+    };
+
+    /// Offline builder of VersionIndex files.
+    class VersionIndexBuilder {
+    public:
+        /// Add version of the package; throws ParseError if version is invalid.
+        /**
+        Adding a version already present with identical text has no effect.
+        */
+        void Add(const std::string& package, const std::string& version);
+
+        /// Get number of versions added.
+        size_t Size() const { return items_.size(); }
+
+        /// Build index in memory.
+        std::vector<uint8_t> Build();
+
+        /// Build index and write it to path, through a temporary file renamed into place, so processes
+        /// mapping an older index at the same path keep reading it undisturbed.
+        void Write(const std::string& path);
+
+    private:
+        struct Item {
+            PackageVersion version;
+            std::string text;
+        };
+
+        std::vector<Item> items_;
+    };
+}}
+
+#endif //VERSIONING_VERSION_INDEX_H
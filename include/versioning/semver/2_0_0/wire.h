@@ -0,0 +1,123 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_WIRE_H
+#define VERSIONING_WIRE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <versioning/version_data.h>
+
+namespace vsn { namespace semver {
+
+    /// Version of the binary encoding written by Encode; first byte of every encoded version.
+    /**
+    Layout of an encoded version, integers being unsigned LEB128 varints:
+
+        format version (1 byte)
+        major, minor, patch
+        prerelease identifier count N
+        identifier type bitmap, (N + 7) / 8 bytes, bit i set if identifier i is numeric
+        N times: identifier length, identifier bytes
+        build identifier count M
+        M times: identifier length, identifier bytes
+
+    A release version without build metadata takes 6 bytes for small component values.
+    */
+    const uint8_t wire_format_version = 1;
+
+    /// Append binary encoding of version to out.
+    void Encode(const VersionData& v, std::vector<uint8_t>& out);
+
+    /// Get binary encoding of version.
+    std::vector<uint8_t> Encode(const VersionData& v);
+
+    /// Decode version encoded at the start of [data, data + size), validating it as parser validates text.
+    /**
+    Throws ParseError if encoding is malformed or truncated, or describes an invalid version. If consumed is
+    given, it receives number of bytes encoded version took, so concatenated encodings can be decoded in turn.
+    */
+    VersionData Decode(const uint8_t* data, size_t size, size_t* consumed = nullptr);
+
+    /// Decode version encoded at the start of [data, data + size) into out, reusing storage of its identifiers.
+    /**
+    Decoding a stream of versions into the same object allocates only when an identifier outgrows storage of
+    earlier ones. Throws ParseError as Decode above; out is left in an unspecified valid state then.
+    */
+    void Decode(const uint8_t* data, size_t size, VersionData& out, size_t* consumed = nullptr);
+
+    /// Validated view of an encoded version, read in place without copying or allocating.
+    /**
+    Precedence of two views is compared directly on their bytes, following the same rules as Comparator.
+    Viewed bytes must outlive the view.
+    */
+    class WireVersion {
+    public:
+        /// Validate version encoded at the start of [data, data + size) and view it; throws ParseError if invalid.
+        WireVersion(const uint8_t* data, size_t size);
+
+        /// Get number of bytes encoded version takes.
+        size_t Size() const { return size_; }
+
+        /// Get encoded bytes.
+        const uint8_t* Data() const { return data_; }
+
+        int Major() const { return major_; }
+        int Minor() const { return minor_; }
+        int Patch() const { return patch_; }
+
+        /// Get number of prerelease identifiers.
+        size_t PreReleaseCount() const { return prerelease_count_; }
+
+        /// Get number of build identifiers.
+        size_t BuildCount() const { return build_count_; }
+
+        /// Decode viewed version.
+        VersionData ToData() const;
+
+        /// Compare precedence of versions; returns negative, zero or positive value, as Comparator::Compare.
+        static int Compare(const WireVersion& l, const WireVersion& r);
+
+        friend bool operator<(const WireVersion& l, const WireVersion& r) { return Compare(l, r) < 0; }
+        friend bool operator==(const WireVersion& l, const WireVersion& r) { return Compare(l, r) == 0; }
+        friend bool operator!=(const WireVersion& l, const WireVersion& r) { return Compare(l, r) != 0; }
+        friend bool operator>(const WireVersion& l, const WireVersion& r) { return Compare(l, r) > 0; }
+        friend bool operator>=(const WireVersion& l, const WireVersion& r) { return Compare(l, r) >= 0; }
+        friend bool operator<=(const WireVersion& l, const WireVersion& r) { return Compare(l, r) <= 0; }
+
+    private:
+        const uint8_t* data_;
+        size_t size_;
+        int major_;
+        int minor_;
+        int patch_;
+        size_t prerelease_count_;
+        size_t build_count_;
+        size_t bitmap_offset_; ///< Offset of identifier type bitmap.
+        size_t prerelease_offset_; ///< Offset of first prerelease identifier.
+    };
+}}
+
+#endif //VERSIONING_WIRE_H
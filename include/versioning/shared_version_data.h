@@ -0,0 +1,146 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VERSIONING_SHARED_VERSION_DATA_H
+#define VERSIONING_SHARED_VERSION_DATA_H
+
+#include <atomic>
+#include <string>
+#include <utility>
+#include "version_data.h"
+
+namespace vsn {
+
+    /// Immutable reference counted VersionData, together with source text it was parsed from.
+    /**
+    Copies share one block, so copying costs one atomic increment regardless of the number of identifiers. Reference
+    count is atomic, so copies of one block may be made and destroyed on any threads; the block itself is never
+    changed while it is shared. Take() and Reset() reuse the block when this handle is its only owner, and leave
+    other owners' block untouched otherwise (copy on write).
+
+    Block holds complete VersionData rather than identifiers alone, since comparators and modifiers take VersionData
+    by reference. Result of modifying shared data is therefore a new block with copies of all identifiers it keeps,
+    even if only a number changed; sharing pays off for copies only.
+
+    Handle which was moved from, or default constructed, holds no block and views empty data.
+    */
+    class SharedVersionData {
+    public:
+        SharedVersionData() = default;
+
+        explicit SharedVersionData(VersionData data) : block_{ new Block(std::move(data)) } {}
+
+        SharedVersionData(const SharedVersionData& other) noexcept : block_{ other.block_ } {
+            if (block_) block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        SharedVersionData(SharedVersionData&& other) noexcept : block_{ other.block_ } {
+            other.block_ = nullptr;
+        }
+
+        SharedVersionData& operator=(const SharedVersionData& other) noexcept {
+            SharedVersionData(other).Swap(*this);
+            return *this;
+        }
+
+        SharedVersionData& operator=(SharedVersionData&& other) noexcept {
+            SharedVersionData(std::move(other)).Swap(*this);
+            return *this;
+        }
+
+        ~SharedVersionData() {
+            if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete block_;
+        }
+
+        void Swap(SharedVersionData& other) noexcept {
+            std::swap(block_, other.block_);
+        }
+
+        /// Get viewed data.
+        const VersionData& Data() const {
+            return block_ ? block_->data : empty().data;
+        }
+
+        /// Get source text; empty if none was set.
+        const std::string& Source() const {
+            return block_ ? block_->source : empty().source;
+        }
+
+        /// Test if this handle is the only owner of its block.
+        /**
+        Acquire load pairs with release of other owners, so their reads of the block happen before it is reused.
+        */
+        bool Unique() const {
+            return block_ && block_->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        /// Move data out of the block, dropping source text, if this handle is its only owner, or copy it otherwise.
+        /**
+        Handle is left viewing empty or moved-from data, to be replaced by Reset().
+        */
+        VersionData Take() {
+            if (!Unique()) return Data();
+            std::string().swap(block_->source);
+            return std::move(block_->data);
+        }
+
+        /// Replace data, dropping source text; block is reused if this handle is its only owner.
+        void Reset(VersionData data) {
+            if (Unique()) {
+                block_->data = std::move(data);
+                std::string().swap(block_->source);
+            } else {
+                SharedVersionData(std::move(data)).Swap(*this);
+            }
+        }
+
+        /// Set source text; data is copied first if the block is shared.
+        void SetSource(std::string source) {
+            if (!Unique()) SharedVersionData(Data()).Swap(*this);
+            block_->source = std::move(source);
+        }
+
+        /// Get number of owners of the block, for diagnostics; 0 for a handle without block.
+        size_t Owners() const {
+            return block_ ? block_->refs.load(std::memory_order_relaxed) : 0;
+        }
+
+    private:
+        struct Block {
+            explicit Block(VersionData d) : refs{ 1 }, data{ std::move(d) } {}
+
+            std::atomic<size_t> refs;
+            VersionData data;
+            std::string source;
+        };
+
+        static const Block& empty() {
+            static const Block block{ VersionData() };
+            return block;
+        }
+
+        Block* block_ = nullptr;
+    };
+}
+
+#endif //VERSIONING_SHARED_VERSION_DATA_H
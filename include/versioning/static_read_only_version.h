@@ -0,0 +1,83 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_STATIC_READ_ONLY_VERSION_H
+#define VERSIONING_STATIC_READ_ONLY_VERSION_H
+
+#include <utility>
+#include "version_base.h"
+
+namespace vsn {
+
+    /// Version compared by a Comparator type known at compile time.
+    /**
+    Unlike Read_only_version, it holds no comparator pointer and comparison operators call Comparator::Compare
+    directly instead of through the VersionComparator vtable, so the call can be inlined. Versions of different
+    comparison schemes are distinct types.
+    */
+    template<typename Comparator>
+    class StaticReadOnlyVersion: public VersionBase {
+    public:
+        explicit StaticReadOnlyVersion(VersionData data):VersionBase(std::move(data))
+        {}
+
+        /// Test if left-hand version operand is of lower precedence than the right-hand version.
+        friend bool operator<(const StaticReadOnlyVersion& l, const StaticReadOnlyVersion& r) {
+            return compare(l, r) < 0;
+        }
+
+        /// Test if left-hand version operand if of equal precedence as the right-hand version.
+        friend bool operator==(const StaticReadOnlyVersion& l, const StaticReadOnlyVersion& r) {
+            return compare(l, r) == 0;
+        }
+
+        /// Test if left-hand version and right-hand version are of different precedence.
+        friend bool operator!=(const StaticReadOnlyVersion& l, const StaticReadOnlyVersion& r) {
+            return compare(l, r) != 0;
+        }
+
+        /// Test if left-hand version operand is of higher precedence than the right-hand version.
+        friend bool operator>(const StaticReadOnlyVersion& l, const StaticReadOnlyVersion& r) {
+            return compare(l, r) > 0;
+        }
+
+        /// Test if left-hand version operand is of higher or equal precedence as the right-hand version.
+        friend bool operator>=(const StaticReadOnlyVersion& l, const StaticReadOnlyVersion& r) {
+            return compare(l, r) >= 0;
+        }
+
+        /// Test if left-hand version operand is of lower or equal precedence as the right-hand version.
+        friend bool operator<=(const StaticReadOnlyVersion& l, const StaticReadOnlyVersion& r) {
+            return compare(l, r) <= 0;
+        }
+
+    private:
+        // Qualified call suppresses virtual dispatch.
+        static int compare(const StaticReadOnlyVersion& l, const StaticReadOnlyVersion& r) {
+            return Comparator{}.Comparator::Compare(l.Data(), r.Data());
+        }
+    };
+}
+
+#endif //VERSIONING_STATIC_READ_ONLY_VERSION_H
@@ -0,0 +1,125 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_VERSION_BASE_H
+#define VERSIONING_VERSION_BASE_H
+
+#include <ostream>
+#include <string>
+#include <versioning/config.h>
+#include "version_data.h"
+#ifdef VERSIONING_SHARED_PAYLOAD
+#include "shared_version_data.h"
+#endif
+
+namespace vsn {
+
+    /// Storage and read-only accessors shared by all version classes, regardless of how they are compared.
+    class VersionBase {
+    public:
+        explicit VersionBase(VersionData data);
+
+        int Major() const; ///< Get major version.
+        int Minor() const; ///< Get minor version.
+        int Patch() const; ///< Get patch version.
+        const std::string PreRelease() const; ///< Get prerelease version string.
+        const std::string Build() const; ///< Get build version string.
+        std::string ToString() const; ///< Get version string in standard semver format (X.Y.Z-PR+B).
+
+        friend std::ostream& operator<<(std::ostream&s, const VersionBase&);
+
+    protected:
+        /// Keep validated text this version was parsed from, so it can be written out without reformatting.
+        /**
+        Source is retained only when library is built with VERSIONING_RETAIN_SOURCE, otherwise this is a no-op
+        and versions are always formatted from their data.
+        */
+        void RetainSource(std::string&& source);
+
+        /// Get version data.
+        const VersionData& Data() const {
+#ifdef VERSIONING_SHARED_PAYLOAD
+            return payload_.Data();
+#else
+            return data_;
+#endif
+        }
+
+        /// Test if other versions share data of this version; always false without VERSIONING_SHARED_PAYLOAD.
+        bool SharesData() const {
+#ifdef VERSIONING_SHARED_PAYLOAD
+            return !payload_.Unique();
+#else
+            return false;
+#endif
+        }
+
+        /// Move version data out, dropping retained source text, leaving this version to be replaced by ResetData().
+        /**
+        With VERSIONING_SHARED_PAYLOAD data is moved only if no other version shares it, and copied otherwise.
+        */
+        VersionData TakeData();
+
+        /// Replace version data, dropping retained source text.
+        /**
+        With VERSIONING_SHARED_PAYLOAD, storage is reused if no other version shares it.
+        */
+        void ResetData(VersionData data);
+
+    private:
+#ifdef VERSIONING_RETAIN_SOURCE
+        /// Get original version text; empty if version was constructed from data or produced by a modification.
+        const std::string& source() const {
+#ifdef VERSIONING_SHARED_PAYLOAD
+            return payload_.Source();
+#else
+            return source_;
+#endif
+        }
+#endif
+
+#ifdef VERSIONING_SHARED_PAYLOAD
+        /// Data and source text, shared between copies of this version.
+        SharedVersionData payload_;
+#else
+        VersionData data_;
+
+#ifdef VERSIONING_RETAIN_SOURCE
+        std::string source_;
+#endif
+#endif
+    };
+
+    /// Output version object to stream using standard semver format (X.Y.Z-PR+B).
+    /**
+    If version retains it's source text, that text is written as is.
+    */
+    std::ostream& operator<<(std::ostream&, const VersionBase&);
+}
+
+#ifdef VERSIONING_HEADER_ONLY
+#include "impl/version_base.h"
+#endif
+
+#endif //VERSIONING_VERSION_BASE_H
@@ -27,6 +27,7 @@ SOFTWARE.
 
 #include <vector>
 #include <string>
+#include <utility>
 
 namespace vsn {
 
@@ -59,9 +60,11 @@ namespace vsn {
 
     /// Description of version broken into parts, as per semantic versioning specification.
     struct VersionData {
+        /// Construct data of the lowest possible version, 0.0.0, e.g. for preallocated storage.
+        VersionData() : major{ 0 }, minor{ 0 }, patch{ 0 } {}
 
-        VersionData(const int M, const int m, const int p, const Prerelease_identifiers& pr, const Build_identifiers& b)
-                : major{ M }, minor{ m }, patch{ p }, prerelease_ids{ pr }, build_ids{ b } {}
+        VersionData(const int M, const int m, const int p, Prerelease_identifiers pr, Build_identifiers b)
+                : major{ M }, minor{ m }, patch{ p }, prerelease_ids{ std::move(pr) }, build_ids{ std::move(b) } {}
 
         int major; ///< Major version, change only on incompatible API modifications.
         int minor; ///< Minor version, change on backwards-compatible API modifications.
@@ -31,8 +31,22 @@ namespace vsn {
 
     /// Implementation of various version modification methods.
     /**
-    All methods are non-destructive, i.e. they return a new object with modified properties;
+    Overloads taking a const reference are non-destructive, i.e. they return a new object with modified properties;
     original object is never modified.
+
+    Overloads taking an rvalue reference may reuse storage of the passed object instead of copying it, leaving it in
+    a valid but unspecified state. Default implementations simply forward to the copying overloads, so modification
+    schemes only need to override them when they can do better.
+
+    Modification scheme overriding only one overload of a method hides the other one (and -Woverloaded-virtual warns
+    about it); bring it back with a using declaration:
+
+        class MyModifier : public VersionModifier {
+        public:
+            using VersionModifier::SetMajor;
+            VersionData SetMajor(const VersionData&, const int) const override;
+            // ...
+        };
     */
     class VersionModifier {
     public:
@@ -65,6 +79,69 @@ namespace vsn {
 
         /// Set build version to specified value.
         virtual VersionData ResetBuild(const VersionData &, const Build_identifiers &) const = 0;
+
+        /// Increment pre-release version resetting build component to empty value.
+        /**
+        Default implementation follows semver 2.0.0 precedence using ResetPatch() and ResetPreRelease(): the last
+        numeric identifier is incremented, or "0" appended if there is none; version without pre-release moves to
+        pre-release "0" of the next patch version. Modification schemes with other rules should override it.
+        */
+        virtual VersionData IncPreRelease(const VersionData &) const;
+
+        /// Set major version, reusing storage of the source object.
+        virtual VersionData SetMajor(VersionData&& s, const int m) const {
+            return SetMajor(static_cast<const VersionData&>(s), m);
+        }
+
+        /// Set minor version, reusing storage of the source object.
+        virtual VersionData SetMinor(VersionData&& s, const int m) const {
+            return SetMinor(static_cast<const VersionData&>(s), m);
+        }
+
+        /// Set patch version, reusing storage of the source object.
+        virtual VersionData SetPatch(VersionData&& s, const int p) const {
+            return SetPatch(static_cast<const VersionData&>(s), p);
+        }
+
+        /// Set pre-release version, reusing storage of the source object.
+        virtual VersionData SetPreRelease(VersionData&& s, const Prerelease_identifiers& pr) const {
+            return SetPreRelease(static_cast<const VersionData&>(s), pr);
+        }
+
+        /// Set build version, reusing storage of the source object.
+        virtual VersionData SetBuild(VersionData&& s, const Build_identifiers& b) const {
+            return SetBuild(static_cast<const VersionData&>(s), b);
+        }
+
+        /// Reset major version, reusing storage of the source object.
+        virtual VersionData ResetMajor(VersionData&& s, const int m) const {
+            return ResetMajor(static_cast<const VersionData&>(s), m);
+        }
+
+        /// Reset minor version, reusing storage of the source object.
+        virtual VersionData ResetMinor(VersionData&& s, const int m) const {
+            return ResetMinor(static_cast<const VersionData&>(s), m);
+        }
+
+        /// Reset patch version, reusing storage of the source object.
+        virtual VersionData ResetPatch(VersionData&& s, const int p) const {
+            return ResetPatch(static_cast<const VersionData&>(s), p);
+        }
+
+        /// Reset pre-release version, reusing storage of the source object.
+        virtual VersionData ResetPreRelease(VersionData&& s, const Prerelease_identifiers& pr) const {
+            return ResetPreRelease(static_cast<const VersionData&>(s), pr);
+        }
+
+        /// Reset build version, reusing storage of the source object.
+        virtual VersionData ResetBuild(VersionData&& s, const Build_identifiers& b) const {
+            return ResetBuild(static_cast<const VersionData&>(s), b);
+        }
+
+        /// Increment pre-release version, reusing storage of the source object.
+        virtual VersionData IncPreRelease(VersionData&& s) const {
+            return IncPreRelease(static_cast<const VersionData&>(s));
+        }
     };
 }
 
@@ -29,10 +29,36 @@ SOFTWARE.
 
 namespace vsn {
 
+    /// Reason why a version string was rejected.
+    enum class ParseErrorReason {
+        other, ///< Reason not covered by any of the more specific ones
+        missing_component, ///< One of major, minor or patch version is missing or empty
+        empty_identifier, ///< Empty prerelease or build identifier
+        invalid_character, ///< Character not allowed at its position
+        leading_zero, ///< Leading 0 in version number or numeric prerelease identifier
+        overflow ///< Version number too large to be represented
+    };
+
+    /// Number of ParseErrorReason values.
+    const size_t parse_error_reason_count = 6;
+
+    /// Get name of the reason, as used in reports.
+    const char* ToString(ParseErrorReason reason);
+
     /// Parse string into Version_data structure according to semantic versioning 2.0.0 rules.
     class VersionParser {
     public:
         virtual VersionData Parse(const std::string&) const = 0;
+
+        /// Parse dot-separated prerelease identifiers, as found after '-' in a version string.
+        virtual Prerelease_identifiers ParsePreRelease(const std::string& s) const {
+            return Parse("0.0.0-" + s).prerelease_ids;
+        }
+
+        /// Parse dot-separated build identifiers, as found after '+' in a version string.
+        virtual Build_identifiers ParseBuild(const std::string& s) const {
+            return Parse("0.0.0+" + s).build_ids;
+        }
     };
 }
 
@@ -0,0 +1,152 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+#ifndef VERSIONING_VERSIONING_C_H
+#define VERSIONING_VERSIONING_C_H
+
+/// C interface to semantic versioning 2.0.0 functions of the library, for use through FFI.
+/**
+Every function handles an array of versions, so one call crosses language boundary for thousands of versions. All
+memory is owned by the caller: functions read input arrays and write to output arrays of at least n elements. They
+never throw or abort; failures are reported by returned vsn_status, and failures of single versions by vsn_error
+written to optional errors array. Functions hold no state and may be called from any number of threads.
+
+Types have fixed size and layout; additions to this interface increment VSN_ABI_VERSION, changes to existing
+functions or types never happen.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(VERSIONING_C_EXPORTS)
+#    define VSN_API __declspec(dllexport)
+#  else
+#    define VSN_API __declspec(dllimport)
+#  endif
+#else
+#  define VSN_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Version of this interface, as returned by vsn_abi_version().
+#define VSN_ABI_VERSION 1
+
+/// Result of a call.
+typedef int32_t vsn_status;
+
+#define VSN_OK 0 ///< All versions were handled.
+#define VSN_INVALID_INPUT 1 ///< Some versions were invalid or could not be modified; see errors array.
+#define VSN_BUFFER_TOO_SMALL 2 ///< Output did not fit in the buffer; required size was stored.
+#define VSN_INVALID_ARGUMENT 3 ///< Required pointer was null, or operation unknown.
+#define VSN_OUT_OF_MEMORY 4 ///< Memory could not be allocated.
+#define VSN_INTERNAL_ERROR 5 ///< Unexpected failure.
+
+/// Failure of a single version.
+typedef int32_t vsn_error;
+
+#define VSN_ERROR_NONE 0 ///< Version was handled.
+#define VSN_ERROR_OTHER 1 ///< Invalid version, for reason not covered by more specific ones.
+#define VSN_ERROR_MISSING_COMPONENT 2 ///< One of major, minor or patch version is missing or empty.
+#define VSN_ERROR_EMPTY_IDENTIFIER 3 ///< Empty prerelease or build identifier.
+#define VSN_ERROR_INVALID_CHARACTER 4 ///< Character not allowed at its position.
+#define VSN_ERROR_LEADING_ZERO 5 ///< Leading 0 in version number or numeric prerelease identifier.
+#define VSN_ERROR_OVERFLOW 6 ///< Version number too large to be represented.
+#define VSN_ERROR_MODIFICATION 7 ///< Version is valid, but the modification could not be applied to it.
+
+/// Modification applied by vsn_modify.
+typedef int32_t vsn_operation;
+
+#define VSN_INC_MAJOR 0 ///< Increment major version, resetting lower components.
+#define VSN_INC_MINOR 1 ///< Increment minor version, resetting lower components.
+#define VSN_INC_PATCH 2 ///< Increment patch version, resetting lower components.
+#define VSN_INC_PRERELEASE 3 ///< Increment prerelease version, as Modifier::IncPreRelease.
+#define VSN_SET_PRERELEASE 4 ///< Set prerelease identifiers to the argument, removing build identifiers.
+#define VSN_SET_BUILD 5 ///< Set build identifiers to the argument.
+
+/// Text, not necessarily null terminated.
+typedef struct vsn_string {
+    const char* data;
+    size_t size;
+} vsn_string;
+
+/// Parts of a version; prerelease and build are dot-separated identifiers, empty if version has none.
+typedef struct vsn_version {
+    int32_t major;
+    int32_t minor;
+    int32_t patch;
+    vsn_string prerelease;
+    vsn_string build;
+} vsn_version;
+
+/// Get VSN_ABI_VERSION the library was built with.
+VSN_API int32_t vsn_abi_version(void);
+
+/// Get name of the status or error, e.g. "leading_zero"; "unknown" for unknown codes.
+VSN_API const char* vsn_status_name(vsn_status status);
+VSN_API const char* vsn_error_name(vsn_error error);
+
+/// Parse n texts to versions, whose prerelease and build view parsed text.
+/**
+Versions may be null, to only validate texts. Invalid texts leave their versions unchanged.
+*/
+VSN_API vsn_status vsn_parse(const vsn_string* texts, size_t n, vsn_version* versions, vsn_error* errors);
+
+/// Compare precedence of n pairs of version texts, storing -1, 0 or 1 to results.
+/**
+Pairs with an invalid version compare as 0, and get error of the left version if it is invalid, else the right one.
+*/
+VSN_API vsn_status vsn_compare(const vsn_string* left, const vsn_string* right, size_t n, int32_t* results,
+        vsn_error* errors);
+
+/// Store to order indexes of n version texts, sorted by precedence; versions of equal precedence keep input order.
+/**
+Invalid versions are placed after all valid ones.
+*/
+VSN_API vsn_status vsn_sort(const vsn_string* texts, size_t n, size_t* order, vsn_error* errors);
+
+/// Format n versions to buffer of given capacity, storing texts viewing the buffer.
+/**
+Texts are written one after another, without separators. Size of all of them is stored to required, if it is not
+null; if it exceeds capacity, VSN_BUFFER_TOO_SMALL is returned, and texts which did not fit are empty. Versions
+which would not format to valid text get empty texts too.
+*/
+VSN_API vsn_status vsn_format(const vsn_version* versions, size_t n, char* buffer, size_t capacity,
+        vsn_string* texts, size_t* required, vsn_error* errors);
+
+/// Apply operation to n version texts, writing modified versions to buffer as vsn_format does.
+/**
+Argument is used by VSN_SET_PRERELEASE and VSN_SET_BUILD, where empty argument removes the identifiers, and ignored
+by other operations; invalid argument fails the call with VSN_INVALID_ARGUMENT.
+*/
+VSN_API vsn_status vsn_modify(const vsn_string* texts, size_t n, vsn_operation operation, vsn_string argument,
+        char* buffer, size_t capacity, vsn_string* results, size_t* required, vsn_error* errors);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //VERSIONING_VERSIONING_C_H
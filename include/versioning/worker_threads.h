@@ -0,0 +1,74 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_WORKER_THREADS_H
+#define VERSIONING_WORKER_THREADS_H
+
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace vsn {
+    /// Threads joined on destruction, so none is left joinable when starting another one, or the calling thread's own
+    /// work, throws.
+    class ThreadJoiner {
+    public:
+        explicit ThreadJoiner(size_t capacity) {
+            threads_.reserve(capacity);
+        }
+
+        ThreadJoiner(const ThreadJoiner&) = delete;
+        ThreadJoiner& operator=(const ThreadJoiner&) = delete;
+
+        ~ThreadJoiner() {
+            for (auto& t : threads_) {
+                if (t.joinable()) t.join();
+            }
+        }
+
+        template<typename F, typename... Args>
+        void Start(F&& f, Args&&... args) {
+            threads_.emplace_back(std::forward<F>(f), std::forward<Args>(args)...);
+        }
+
+    private:
+        std::vector<std::thread> threads_;
+    };
+
+    /// Call work(w) for every w in [0, workers): w == 0 on the calling thread, others on threads of their own.
+    /**
+    Returns once all calls returned. Exception thrown by the call on the calling thread, or by starting a thread,
+    propagates after the threads already started are joined; work running on other threads must not throw.
+    */
+    template<typename F>
+    void run_workers(const size_t workers, F& work) {
+        ThreadJoiner pool(workers > 0 ? workers - 1 : 0);
+        for (size_t w = 1; w < workers; ++w) pool.Start(std::ref(work), w);
+        work(size_t{ 0 });
+    }
+}
+
+#endif //VERSIONING_WORKER_THREADS_H
@@ -0,0 +1,105 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_CANONICAL_H
+#define VERSIONING_CANONICAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <versioning/version_data.h>
+
+namespace vsn {
+    inline bool is_space(const char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    /// Narrow [first, last) to text without surrounding whitespace.
+    inline void trim(const char*& first, const char*& last) {
+        for (; first != last && is_space(*first); ++first) {}
+        for (; last != first && is_space(last[-1]); --last) {}
+    }
+
+    /// Hash bytes 8 at a time; tail bytes are zero padded, and length is mixed in to tell paddings apart.
+    inline uint64_t hash_bytes(const char* s, size_t size, const uint64_t seed = 0) {
+        const uint64_t m = 0xff51afd7ed558ccdULL;
+        uint64_t h = (0x9e3779b97f4a7c15ULL + seed) ^ size;
+        for (; size >= 8; s += 8, size -= 8) {
+            uint64_t w;
+            std::memcpy(&w, s, 8);
+            h = (h ^ w) * m;
+            h ^= h >> 32;
+        }
+        uint64_t w = 0;
+        std::memcpy(&w, s, size);
+        h = (h ^ w) * m;
+        h ^= h >> 29;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        return h ^ (h >> 32);
+    }
+
+    namespace detail {
+        inline void append_int(std::string& s, int v) {
+            char buf[12];
+            size_t n = 0;
+            do {
+                buf[n++] = static_cast<char>('0' + v % 10);
+                v /= 10;
+            } while (v);
+            while (n) s += buf[--n];
+        }
+
+        inline void append_id(std::string& s, const std::pair<std::string, Id_type>& id) {
+            s += id.first;
+        }
+
+        inline void append_id(std::string& s, const std::string& id) {
+            s += id;
+        }
+
+        template<typename Ids>
+        void append_joined(std::string& s, const char separator, const Ids& ids) {
+            for (size_t i = 0; i < ids.size(); ++i) {
+                s += i ? '.' : separator;
+                append_id(s, ids[i]);
+            }
+        }
+    }
+
+    /// Append version in standard semver format, with or without build metadata; valid text parsed into the
+    /// version is formatted back unchanged.
+    inline void append_canonical(std::string& s, const VersionData& v, const bool build) {
+        detail::append_int(s, v.major);
+        s += '.';
+        detail::append_int(s, v.minor);
+        s += '.';
+        detail::append_int(s, v.patch);
+        detail::append_joined(s, '-', v.prerelease_ids);
+        if (build) detail::append_joined(s, '+', v.build_ids);
+    }
+}
+
+#endif //VERSIONING_CANONICAL_H
@@ -0,0 +1,52 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_CHAR_CLASSES_H
+#define VERSIONING_CHAR_CLASSES_H
+
+#include <cstdint>
+
+namespace vsn {
+    /// Classes of characters allowed in semver identifiers, looked up by a single table read per character.
+    struct CharClasses {
+        enum : uint8_t {
+            identifier_char = 1, ///< Character may appear in an identifier.
+            digit = 2 ///< Character is a decimal digit.
+        };
+
+        constexpr CharClasses() : of{} {
+            for (int c = '0'; c <= '9'; ++c) of[c] = identifier_char | digit;
+            for (int c = 'A'; c <= 'Z'; ++c) of[c] = identifier_char;
+            for (int c = 'a'; c <= 'z'; ++c) of[c] = identifier_char;
+            of['-'] = identifier_char;
+        }
+
+        uint8_t of[256];
+    };
+
+    /// Class table; constant initialized, so it may be used during static initialization of other translation units.
+    constexpr CharClasses char_classes{};
+}
+
+#endif //VERSIONING_CHAR_CLASSES_H
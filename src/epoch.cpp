@@ -0,0 +1,97 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <versioning/epoch.h>
+
+namespace vsn {
+    // Per-thread starting point for reader slot search; spreads threads over slots.
+    inline size_t slot_hint() {
+        static thread_local size_t hint = std::hash<std::thread::id>()(std::this_thread::get_id());
+        return hint;
+    }
+
+    EpochDomain::Guard::Guard(EpochDomain& domain) {
+        for (size_t i = slot_hint();; ++i) {
+            auto& slot = domain.slots_[i % slot_count].epoch;
+            uint64_t free = 0;
+            // Epoch is re-read on every attempt: pinning a stale epoch would be safe, but would delay reclamation.
+            if (slot.load(std::memory_order_relaxed) == 0 && slot.compare_exchange_strong(free, domain.epoch_.load())) {
+                slot_ = &slot;
+                return;
+            }
+            if (i % slot_count == slot_count - 1) std::this_thread::yield();
+        }
+    }
+
+    EpochDomain::Guard::Guard(Guard&& other) noexcept : slot_{ other.slot_ } {
+        other.slot_ = nullptr;
+    }
+
+    EpochDomain::Guard::~Guard() {
+        if (slot_) slot_->store(0, std::memory_order_release);
+    }
+
+    EpochDomain::EpochDomain() : epoch_{ 1 } {
+        for (auto& slot : slots_) {
+            slot.epoch.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    EpochDomain::~EpochDomain() {
+        for (const auto& r : retired_) {
+            r.deleter(r.obj);
+        }
+    }
+
+    void EpochDomain::retire(void* obj, void (*deleter)(void*)) {
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        // Object was unlinked before the epoch advances, so readers pinning any later epoch cannot reach it.
+        retired_.push_back(Retired{ obj, deleter, epoch_.fetch_add(1) });
+        reclaim_locked();
+    }
+
+    void EpochDomain::Reclaim() {
+        std::lock_guard<std::mutex> lock(retired_mutex_);
+        reclaim_locked();
+    }
+
+    void EpochDomain::reclaim_locked() {
+        uint64_t oldest = std::numeric_limits<uint64_t>::max();
+        for (const auto& slot : slots_) {
+            auto e = slot.epoch.load();
+            if (e != 0) oldest = std::min(oldest, e);
+        }
+        auto alive = std::partition(retired_.begin(), retired_.end(), [oldest](const Retired& r) {
+            return r.epoch >= oldest;
+        });
+        for (auto it = alive; it != retired_.end(); ++it) {
+            it->deleter(it->obj);
+        }
+        retired_.erase(alive, retired_.end());
+    }
+}
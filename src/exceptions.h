@@ -25,11 +25,24 @@ SOFTWARE.
 #define VERSIONING_EXCEPTIONS_H
 
 #include <stdexcept>
+#include <versioning/version_parser.h>
 
 namespace vsn {
     /// Any error in parsing or validation of version string will result in Parse_error exception being thrown.
     class ParseError : public std::runtime_error {
+    public:
         using std::runtime_error::runtime_error;
+
+        ParseError(ParseErrorReason reason, const std::string& what)
+                : std::runtime_error(what), reason_{ reason } {}
+
+        /// Get reason of the failure.
+        ParseErrorReason Reason() const {
+            return reason_;
+        }
+
+    private:
+        ParseErrorReason reason_ = ParseErrorReason::other;
     };
 
     /// Any error in manipulating version data will result in Modification_error exception being thrown.
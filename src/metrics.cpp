@@ -0,0 +1,206 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include <versioning/metrics.h>
+
+namespace vsn { namespace metrics {
+namespace {
+    // Counters of one thread. Written by owning thread only, read by anyone collecting a snapshot.
+    struct ThreadCounters {
+        struct Op {
+            std::atomic<uint64_t> calls;
+            std::atomic<uint64_t> sampled;
+            std::atomic<uint64_t> sampled_ns;
+            std::atomic<uint64_t> latency[histogram_buckets];
+        };
+
+        ThreadCounters();
+        ~ThreadCounters();
+
+        Op ops[operation_count];
+        std::atomic<uint64_t> parse_failures[parse_error_reason_count];
+    };
+
+    // Single writer: plain load and store instead of a locked read-modify-write.
+    inline void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    inline uint64_t now_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    inline size_t bucket_of(uint64_t ns) {
+        size_t b = 0;
+        while (ns > 1 && b + 1 < histogram_buckets) {
+            ns >>= 1;
+            ++b;
+        }
+        return b;
+    }
+
+    void add(Snapshot& s, const ThreadCounters& c) {
+        for (size_t i = 0; i < operation_count; ++i) {
+            auto& op = s.operations[i];
+            op.calls += c.ops[i].calls.load(std::memory_order_relaxed);
+            op.sampled += c.ops[i].sampled.load(std::memory_order_relaxed);
+            op.sampled_ns += c.ops[i].sampled_ns.load(std::memory_order_relaxed);
+            for (size_t b = 0; b < histogram_buckets; ++b) op.latency[b] += c.ops[i].latency[b].load(std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < parse_error_reason_count; ++i) {
+            s.parse_failures[i] += c.parse_failures[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Counters of live threads, and totals of those that have exited.
+    struct Registry {
+        std::mutex mutex;
+        std::vector<const ThreadCounters*> threads;
+        Snapshot exited{};
+    };
+
+    Registry& registry() {
+        // Never destroyed, as threads may still exit while static objects are being destroyed.
+        static Registry* r = new Registry();
+        return *r;
+    }
+
+    ThreadCounters::ThreadCounters() {
+        for (auto& op : ops) {
+            op.calls.store(0);
+            op.sampled.store(0);
+            op.sampled_ns.store(0);
+            for (auto& b : op.latency) b.store(0);
+        }
+        for (auto& f : parse_failures) f.store(0);
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(this);
+    }
+
+    ThreadCounters::~ThreadCounters() {
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        add(r.exited, *this);
+        r.threads.erase(std::find(r.threads.begin(), r.threads.end(), this));
+    }
+
+    ThreadCounters& owned() {
+        thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    // Trivially initialized, so access on hot path needs no check whether thread's counters were constructed.
+    thread_local ThreadCounters* current = nullptr;
+
+    inline ThreadCounters& local() {
+        if (current == nullptr) current = &owned();
+        return *current;
+    }
+
+}
+
+    Timer::Timer(Operation op) : op_{ op }, start_{ 0 } {
+        auto& c = local().ops[static_cast<size_t>(op)];
+        uint64_t calls = c.calls.load(std::memory_order_relaxed);
+        c.calls.store(calls + 1, std::memory_order_relaxed);
+        if (calls % sample_period == 0) start_ = now_ns();
+    }
+
+    Timer::~Timer() {
+        if (start_ == 0) return;
+        uint64_t ns = now_ns() - start_;
+        auto& c = local().ops[static_cast<size_t>(op_)];
+        bump(c.sampled);
+        bump(c.sampled_ns, ns);
+        bump(c.latency[bucket_of(ns)]);
+    }
+
+    void CountParseFailure(ParseErrorReason reason) {
+        bump(local().parse_failures[static_cast<size_t>(reason)]);
+    }
+
+    Snapshot Collect() {
+        Snapshot s{};
+#ifdef VERSIONING_METRICS
+        auto& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        s = r.exited;
+        s.enabled = true;
+        for (auto c : r.threads) add(s, *c);
+#endif
+        return s;
+    }
+
+    const char* ToString(Operation op) {
+        switch (op) {
+            case Operation::parse: return "parse";
+            case Operation::compare: return "compare";
+            case Operation::modify: return "modify";
+            default: return "format";
+        }
+    }
+
+    double OperationMetrics::MeanNs() const {
+        return sampled ? static_cast<double>(sampled_ns) / sampled : 0;
+    }
+
+    uint64_t OperationMetrics::PercentileNs(double fraction) const {
+        if (sampled == 0) return 0;
+        auto rank = static_cast<uint64_t>(fraction * sampled);
+        uint64_t seen = 0;
+        for (size_t b = 0; b < histogram_buckets; ++b) {
+            seen += latency[b];
+            if (seen > rank || b + 1 == histogram_buckets) return uint64_t(1) << (b + 1);
+        }
+        return 0;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const Snapshot& s) {
+        if (!s.enabled) return os << "metrics not enabled, build with VERSIONING_METRICS\n";
+        os << std::left << std::setw(10) << "operation" << std::right << std::setw(14) << "calls"
+           << std::setw(12) << "mean ns" << std::setw(10) << "p50 <" << std::setw(10) << "p99 <" << "\n";
+        for (size_t i = 0; i < operation_count; ++i) {
+            const auto& op = s.operations[i];
+            os << std::left << std::setw(10) << ToString(static_cast<Operation>(i)) << std::right
+               << std::setw(14) << op.calls << std::setw(12) << static_cast<uint64_t>(op.MeanNs())
+               << std::setw(10) << op.PercentileNs(0.5) << std::setw(10) << op.PercentileNs(0.99) << "\n";
+        }
+        os << "parse failures:\n";
+        for (size_t i = 0; i < parse_error_reason_count; ++i) {
+            if (s.parse_failures[i] == 0) continue;
+            os << "  " << std::left << std::setw(22) << ToString(static_cast<ParseErrorReason>(i)) << std::right
+               << s.parse_failures[i] << "\n";
+        }
+        return os;
+    }
+}}
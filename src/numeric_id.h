@@ -22,25 +22,24 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#ifndef VERSIONING_VECTOR_UTILS_H
-#define VERSIONING_VECTOR_UTILS_H
+#ifndef VERSIONING_NUMERIC_ID_H
+#define VERSIONING_NUMERIC_ID_H
 
-#include <ostream>
-#include <vector>
+#include <string>
 
 namespace vsn {
-    /// Utility function to splice all vector elements to output stream, using designated separator
-    /// between elements and function object for getting values from vector elements.
-    template<typename T, typename F>
-    std::ostream& splice(std::ostream& os, const std::vector<T>& vec, const std::string& sep, F read) {
-        if (!vec.empty()) {
-            for (auto it = vec.cbegin(); it < vec.cend() - 1; ++it) {
-                os << read(*it) << sep;
+    /// Increment decimal number of numeric identifier in place, digit by digit, so identifiers of any length can be
+    /// incremented.
+    inline void increment_numeric_id(std::string& digits) {
+        for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+            if (*it != '9') {
+                ++*it;
+                return;
             }
-            os << read(*vec.crbegin());
+            *it = '0';
         }
-        return os;
+        digits.insert(digits.begin(), '1');
     }
 }
 
-#endif //VERSIONING_VECTOR_UTILS_H
+#endif //VERSIONING_NUMERIC_ID_H
@@ -0,0 +1,35 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <ostream>
+#include "versioning/pipeline.h"
+
+namespace vsn {
+    std::ostream& operator<<(std::ostream& os, const StageMetrics& m) {
+        return os << m.name << ": threads=" << m.threads << " in=" << m.items_in << " out=" << m.items_out
+                  << " batches=" << m.batches << " items/s=" << static_cast<uint64_t>(m.Throughput())
+                  << " busy=" << m.busy_seconds << "s elapsed=" << m.elapsed_seconds << "s queue_depth(mean/max/cap)="
+                  << m.mean_queue_depth << "/" << m.max_queue_depth << "/" << m.queue_capacity;
+    }
+}
@@ -22,74 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <string>
-#include <sstream>
-#include <utility>
 #include <versioning/read_only_version.h>
-#include "vector_utils.h"
 
-namespace vsn {
-    ReadOnlyVersion::ReadOnlyVersion(VersionData data, const VersionComparator * comparator)
-            : data_{ std::move(data) }, comparator_{ comparator } {}
-
-    int ReadOnlyVersion::Major() const {
-        return data_.major;
-    }
-
-    int ReadOnlyVersion::Minor() const {
-        return data_.minor;
-    }
-
-    int ReadOnlyVersion::Patch() const {
-        return data_.patch;
-    }
-
-    const std::string ReadOnlyVersion::PreRelease() const {
-        std::stringstream ss;
-        splice(ss, data_.prerelease_ids, ".", [](const auto& id) { return id.first;});
-        return ss.str();
-    }
-
-    const std::string ReadOnlyVersion::Build() const {
-        std::stringstream ss;
-        splice(ss, data_.build_ids, ".", [](const auto& id) { return id;});
-        return ss.str();
-    }
-
-    bool operator<(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
-        return l.comparator_->Compare(l.data_, r.data_) == -1;
-    }
-
-    bool operator==(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
-        return l.comparator_->Compare(l.data_, r.data_) == 0;
-    }
-
-    std::ostream& operator<<(std::ostream& os, const ReadOnlyVersion& v) {
-        os << v.data_.major << "." << v.data_.minor << "." << v.data_.patch;
-        std::string prl = v.PreRelease();
-        if (!prl.empty()) {
-            os << "-" << prl;
-        }
-        std::string bld = v.Build();
-        if (!bld.empty()) {
-            os << "+" << bld;
-        }
-        return os;
-    }
-
-    bool operator!=(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
-        return !(l == r);
-    }
-
-    bool operator>(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
-        return r < l;
-    }
-
-    bool operator>=(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
-        return !(l < r);
-    }
-
-    bool operator<=(const ReadOnlyVersion& l, const ReadOnlyVersion& r) {
-        return !(l > r);
-    }
-}
\ No newline at end of file
+#ifndef VERSIONING_HEADER_ONLY
+#include <versioning/impl/read_only_version.h>
+#endif
@@ -0,0 +1,119 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <versioning/worker_threads.h>
+#include "versioning/semver/2_0_0/batch_modifier.h"
+#include "versioning/semver/2_0_0/version.h"
+#include "../../exceptions.h"
+
+namespace vsn { namespace semver {
+    // Batches smaller than this are not worth spawning a thread for.
+    const size_t min_items_per_thread = 2048;
+
+namespace {
+    // Add increment to version component, failing instead of overflowing.
+    int bump(const int v, const int increment, const char* name) {
+        if (increment > 0 && v > INT_MAX - increment) throw ModificationError(std::string(name) + " version overflow");
+        return v + increment;
+    }
+}
+
+    BatchModifier::BatchModifier(BumpPolicy policy, unsigned threads)
+            : policy_{ std::move(policy) }, threads_{ threads ? threads : std::thread::hardware_concurrency() } {
+        if (threads_ == 0) threads_ = 1;
+        // Let the modifier validate build identifiers once for the whole batch.
+        modifier_.SetBuild(VersionData{ 0, 0, 0, Prerelease_identifiers{}, Build_identifiers{} }, policy_.build);
+    }
+
+    void BatchModifier::Apply(VersionData& v) const {
+        switch (policy_.bump) {
+            case semver::Bump::major:
+                v = modifier_.ResetMajor(std::move(v), bump(v.major, policy_.increment, "major"));
+                break;
+            case semver::Bump::minor:
+                v = modifier_.ResetMinor(std::move(v), bump(v.minor, policy_.increment, "minor"));
+                break;
+            case semver::Bump::patch:
+                v = modifier_.ResetPatch(std::move(v), bump(v.patch, policy_.increment, "patch"));
+                break;
+            case semver::Bump::prerelease:
+                v = modifier_.IncPreRelease(std::move(v));
+                break;
+        }
+        // Identifiers were validated in constructor, so they are assigned directly.
+        v.build_ids = policy_.build;
+    }
+
+    // Split [0, n) into contiguous chunks, one per worker, and collect errors of all chunks in index order.
+    template<typename F>
+    std::vector<BatchError> BatchModifier::run(size_t n, F process) const {
+        size_t workers = std::min<size_t>(threads_, std::max<size_t>(1, n / min_items_per_thread));
+        std::vector<std::vector<BatchError>> errors(workers);
+        auto work = [&](size_t w) {
+            size_t first = n * w / workers;
+            size_t last = n * (w + 1) / workers;
+            for (size_t i = first; i < last; ++i) {
+                try {
+                    process(i);
+                } catch (std::exception& ex) {
+                    errors[w].push_back(BatchError{ i, ex.what() });
+                }
+            }
+        };
+
+        run_workers(workers, work);
+
+        std::vector<BatchError> result;
+        for (auto& e : errors) {
+            std::move(e.begin(), e.end(), std::back_inserter(result));
+        }
+        return result;
+    }
+
+    std::vector<BatchError> BatchModifier::Apply(const VersionData* in, size_t n, VersionData* out) const {
+        return run(n, [&](size_t i) {
+            if (out + i != in + i) out[i] = in[i];
+            // Modifier validates before touching the data, so failed items stay unchanged.
+            Apply(out[i]);
+        });
+    }
+
+    std::vector<BatchError> BatchModifier::Apply(const std::string* in, size_t n, std::string* out) const {
+        return run(n, [&](size_t i) {
+            try {
+                auto v = parser_.Parse(in[i]);
+                Apply(v);
+                out[i] = Version(std::move(v)).ToString();
+            } catch (...) {
+                out[i].clear();
+                throw;
+            }
+        });
+    }
+}}
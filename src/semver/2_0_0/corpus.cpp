@@ -0,0 +1,220 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include "versioning/semver/2_0_0/corpus.h"
+
+namespace vsn { namespace semver {
+namespace {
+    const char* const common_tags[] = { "alpha", "beta", "rc", "pre", "dev", "snapshot", "preview", "nightly",
+                                        "canary", "M" };
+    const size_t common_tag_count = sizeof(common_tags) / sizeof(common_tags[0]);
+
+    const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    const char identifier_chars[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-";
+    const char hex_digits[] = "0123456789abcdef";
+
+    void append_number(std::string& out, uint64_t n) {
+        char buf[20];
+        size_t len = 0;
+        do {
+            buf[len++] = static_cast<char>('0' + n % 10);
+            n /= 10;
+        } while (n);
+        while (len) out += buf[--len];
+    }
+
+    // Ways of breaking a valid version string.
+    enum class Defect {
+        leading_zero, missing_patch, empty_identifier, trailing_separator, invalid_character, prefix,
+        extra_component, leading_zero_identifier, overflow, empty, count_
+    };
+}
+
+    CorpusProfile::CorpusProfile()
+            : seed{ 1 }, max_major{ 30 }, max_minor{ 60 }, max_patch{ 200 }, prerelease_share{ 0.25 },
+              min_prerelease_ids{ 1 }, max_prerelease_ids{ 3 }, numeric_id_share{ 0.5 }, common_tag_share{ 0.9 },
+              min_id_length{ 1 }, max_id_length{ 12 }, build_share{ 0.1 }, sha_build_share{ 0.5 },
+              malformed_share{ 0.0 } {}
+
+    CorpusGenerator::CorpusGenerator(const CorpusProfile& profile)
+            : profile_(profile), state_{ profile.seed } {}
+
+    // SplitMix64: tiny, fast and statistically sound enough for test data.
+    uint64_t CorpusGenerator::next_random() {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t CorpusGenerator::below(uint64_t n) {
+        return n ? next_random() % n : 0;
+    }
+
+    bool CorpusGenerator::chance(double share) {
+        if (share <= 0) return false;
+        if (share >= 1) return true;
+        // Scaling by a power of two is exact, so threshold is the same everywhere.
+        return (next_random() >> 32) < static_cast<uint64_t>(share * 4294967296.0);
+    }
+
+    // Number in [0, max], with smaller numbers more likely.
+    int CorpusGenerator::skewed(int max) {
+        if (max <= 0) return 0;
+        return static_cast<int>(below(below(static_cast<uint64_t>(max) + 1) + 1));
+    }
+
+    void CorpusGenerator::append_core(std::string& out) {
+        append_number(out, skewed(profile_.max_major));
+        out += '.';
+        append_number(out, skewed(profile_.max_minor));
+        out += '.';
+        append_number(out, skewed(profile_.max_patch));
+    }
+
+    void CorpusGenerator::append_alnum(std::string& out, int min_length, int max_length) {
+        // Start with a letter, so identifier can never be mistaken for a numeric one.
+        int length = min_length + static_cast<int>(below(static_cast<uint64_t>(std::max(max_length - min_length, 0)) + 1));
+        out += letters[below(sizeof(letters) - 1)];
+        for (int i = 1; i < length; ++i) out += identifier_chars[below(sizeof(identifier_chars) - 1)];
+    }
+
+    void CorpusGenerator::append_hex(std::string& out, int length) {
+        for (int i = 0; i < length; ++i) out += hex_digits[next_random() & 0xf];
+    }
+
+    void CorpusGenerator::append_prerelease(std::string& out) {
+        int min = std::max(profile_.min_prerelease_ids, 1);
+        int count = min + static_cast<int>(below(static_cast<uint64_t>(std::max(profile_.max_prerelease_ids - min, 0)) + 1));
+        for (int i = 0; i < count; ++i) {
+            out += i ? '.' : '-';
+            if (i > 0 && chance(profile_.numeric_id_share)) append_number(out, skewed(50));
+            else if (chance(profile_.common_tag_share)) out += common_tags[below(common_tag_count)];
+            else append_alnum(out, std::max(profile_.min_id_length, 1), profile_.max_id_length);
+        }
+    }
+
+    void CorpusGenerator::append_build(std::string& out) {
+        out += '+';
+        if (chance(profile_.sha_build_share)) {
+            out += "sha.";
+            append_hex(out, chance(0.5) ? 7 : 40);
+            return;
+        }
+        switch (below(3)) {
+            case 0:
+                out += "build.";
+                append_number(out, below(100000));
+                break;
+            case 1:
+                append_number(out, 2010 + below(10));
+                out += "0";
+                append_number(out, 1 + below(9));
+                append_number(out, 10 + below(18));
+                break;
+            default:
+                out += "ci.";
+                append_number(out, below(1000));
+                out += '.';
+                append_hex(out, 7);
+                break;
+        }
+    }
+
+    void CorpusGenerator::append_malformed(std::string& out) {
+        switch (static_cast<Defect>(below(static_cast<uint64_t>(Defect::count_)))) {
+            case Defect::leading_zero:
+                out += '0';
+                append_core(out);
+                break;
+            case Defect::missing_patch:
+                append_number(out, skewed(profile_.max_major));
+                out += '.';
+                append_number(out, skewed(profile_.max_minor));
+                if (chance(profile_.prerelease_share)) append_prerelease(out);
+                break;
+            case Defect::empty_identifier:
+                append_core(out);
+                append_prerelease(out);
+                out += "..1";
+                break;
+            case Defect::trailing_separator:
+                append_core(out);
+                out += chance(0.5) ? '-' : '+';
+                break;
+            case Defect::invalid_character: {
+                append_core(out);
+                if (chance(profile_.prerelease_share)) append_prerelease(out);
+                const char bad[] = "_ !@#/~";
+                out.insert(out.begin() + static_cast<std::ptrdiff_t>(below(out.size() + 1)), bad[below(sizeof(bad) - 1)]);
+                break;
+            }
+            case Defect::prefix:
+                out += chance(0.5) ? "v" : "release-";
+                append_core(out);
+                break;
+            case Defect::extra_component:
+                append_core(out);
+                out += '.';
+                append_number(out, skewed(profile_.max_patch));
+                break;
+            case Defect::leading_zero_identifier:
+                append_core(out);
+                out += "-0";
+                append_number(out, 1 + below(9));
+                break;
+            case Defect::overflow:
+                append_number(out, 2147483648ULL + below(1000000));
+                out += ".0.0";
+                break;
+            default:
+                break;
+        }
+    }
+
+    bool CorpusGenerator::Next(std::string& out) {
+        out.clear();
+        if (chance(profile_.malformed_share)) {
+            append_malformed(out);
+            return false;
+        }
+        append_core(out);
+        if (chance(profile_.prerelease_share)) append_prerelease(out);
+        if (chance(profile_.build_share)) append_build(out);
+        return true;
+    }
+
+    std::string CorpusGenerator::Next() {
+        std::string s;
+        Next(s);
+        return s;
+    }
+
+    std::vector<std::string> CorpusGenerator::Generate(size_t n) {
+        std::vector<std::string> res(n);
+        for (auto& s : res) Next(s);
+        return res;
+    }
+}}
@@ -0,0 +1,159 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include "../../canonical.h"
+#include "versioning/semver/2_0_0/deduplicator.h"
+
+namespace vsn { namespace semver {
+namespace {
+    const size_t initial_slot_count = 64;
+    const size_t min_entry_capacity = 16;
+    const size_t default_block_size = 65536;
+    const uint64_t entry_mask = 0xffffffff;
+}
+
+    VersionDeduplicator::VersionDeduplicator(DedupOptions options)
+            : options_{ options }, slots_(initial_slot_count), block_used_{ 0 }, block_size_{ 0 }, block_bytes_{ 0 },
+              total_{ 0 }, duplicates_{ 0 }, rejected_{ 0 }, overflowed_{ 0 } {}
+
+    // Replace text with its canonical form, or return false if it is not a valid version.
+    bool VersionDeduplicator::canonicalise(const char*& s, size_t& size) {
+        const bool exact = options_.equality == VersionEquality::text;
+        if (options_.coerce) {
+            if (!coercing_parser_.TryCoerce(s, size, coerced_)) return false;
+            if (exact) return true;
+            formatted_.clear();
+            append_canonical(formatted_, coerced_.version, options_.equality == VersionEquality::identity);
+            s = formatted_.data();
+            size = formatted_.size();
+            return true;
+        }
+
+        // Valid text is canonical already, as identifiers are kept verbatim and numbers have no leading zeros.
+        const char* first = s;
+        const char* last = s + size;
+        trim(first, last);
+        if (!parser_.IsValid(first, static_cast<size_t>(last - first))) return false;
+        if (exact) return true;
+        if (options_.equality == VersionEquality::precedence) {
+            const void* plus = std::memchr(first, '+', static_cast<size_t>(last - first));
+            if (plus) last = static_cast<const char*>(plus);
+        }
+        s = first;
+        size = static_cast<size_t>(last - first);
+        return true;
+    }
+
+    // Get slot holding text, or empty slot where it belongs.
+    size_t VersionDeduplicator::find(const char* s, const size_t size, const uint64_t hash) const {
+        const size_t mask = slots_.size() - 1;
+        const uint64_t tag = hash & ~entry_mask;
+        for (size_t i = static_cast<size_t>(hash) & mask;; i = (i + 1) & mask) {
+            const uint64_t slot = slots_[i];
+            if (!slot) return i;
+            if ((slot & ~entry_mask) != tag) continue;
+            const Entry& e = entries_[(slot & entry_mask) - 1];
+            if (e.size == size && std::memcmp(e.text, s, size) == 0) return i;
+        }
+    }
+
+    // Make room for one more entry with text of given size, unless it would exceed the memory cap.
+    bool VersionDeduplicator::reserve(const size_t size) {
+        if (size > UINT32_MAX || entries_.size() >= entry_mask - 1) return false;
+        // Keep load factor below 0.7, so probe sequences stay short.
+        const size_t slot_count = (entries_.size() + 1) * 10 > slots_.size() * 7 ? slots_.size() * 2 : slots_.size();
+        const size_t block = block_used_ + size > block_size_ ? std::max(default_block_size, size) : 0;
+        const size_t fixed = slot_count * sizeof(uint64_t) + block_bytes_ + block;
+        if (fixed + (entries_.size() + 1) * sizeof(Entry) > options_.max_bytes) return false;
+        if (entries_.size() == entries_.capacity()) {
+            // Grow entries geometrically while that fits, then by as much as does.
+            const size_t fit = (options_.max_bytes - fixed) / sizeof(Entry);
+            entries_.reserve(std::min(fit, std::max(min_entry_capacity, entries_.capacity() * 2)));
+        }
+        if (slot_count != slots_.size()) rehash(slot_count);
+        if (block) {
+            blocks_.emplace_back(new char[block]);
+            block_size_ = block;
+            block_used_ = 0;
+            block_bytes_ += block;
+        }
+        return true;
+    }
+
+    void VersionDeduplicator::rehash(const size_t slot_count) {
+        slots_.assign(slot_count, 0);
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            const Entry& e = entries_[i];
+            const uint64_t hash = hash_bytes(e.text, e.size);
+            slots_[find(e.text, e.size, hash)] = (hash & ~entry_mask) | (i + 1);
+        }
+    }
+
+    DedupResult VersionDeduplicator::Add(const char* s, size_t size) {
+        ++total_;
+        if (!canonicalise(s, size)) {
+            ++rejected_;
+            return DedupResult::rejected;
+        }
+        const uint64_t hash = hash_bytes(s, size);
+        size_t slot = find(s, size, hash);
+        if (slots_[slot]) {
+            ++entries_[(slots_[slot] & entry_mask) - 1].count;
+            ++duplicates_;
+            return DedupResult::duplicate;
+        }
+        if (!reserve(size)) {
+            ++overflowed_;
+            return DedupResult::overflow;
+        }
+
+        char* text = blocks_.back().get() + block_used_;
+        std::memcpy(text, s, size);
+        block_used_ += size;
+        entries_.push_back(Entry{ text, static_cast<uint32_t>(size), 0, 1 });
+        slot = find(s, size, hash); // table may have been rehashed
+        slots_[slot] = (hash & ~entry_mask) | entries_.size();
+        return DedupResult::added;
+    }
+
+    uint64_t VersionDeduplicator::Count(const std::string& canonical) const {
+        const uint64_t hash = hash_bytes(canonical.data(), canonical.size());
+        const uint64_t slot = slots_[find(canonical.data(), canonical.size(), hash)];
+        return slot ? entries_[(slot & entry_mask) - 1].count : 0;
+    }
+
+    std::vector<std::pair<std::string, uint64_t>> VersionDeduplicator::Counts() const {
+        std::vector<std::pair<std::string, uint64_t>> res;
+        res.reserve(entries_.size());
+        for (const auto& e : entries_) res.emplace_back(std::string(e.text, e.size), e.count);
+        return res;
+    }
+
+    size_t VersionDeduplicator::MemoryUsage() const {
+        return slots_.size() * sizeof(uint64_t) + entries_.capacity() * sizeof(Entry) + block_bytes_;
+    }
+}}
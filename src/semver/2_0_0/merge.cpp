@@ -0,0 +1,40 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "versioning/semver/2_0_0/merge.h"
+
+namespace vsn { namespace semver {
+    int VersionOrder::Compare(const VersionData& l, const VersionData& r) const {
+        const int cmp = comparator_.Compare(l, r);
+        if (cmp != 0 || builds_ == BuildMetadata::ignored) return cmp;
+        if (l.build_ids < r.build_ids) return -1;
+        return r.build_ids < l.build_ids ? 1 : 0;
+    }
+
+    int VersionOrder::Compare(const PackageVersion& l, const PackageVersion& r) const {
+        const int cmp = l.package.compare(r.package);
+        if (cmp != 0) return cmp > 0 ? 1 : -1;
+        return Compare(l.version, r.version);
+    }
+}}
@@ -23,53 +23,228 @@ SOFTWARE.
 */
 
 #include <climits>
+#include <string>
+#include <utility>
+#include <versioning/metrics.h>
 #include "versioning/semver/2_0_0/modifier.h"
 #include "../../exceptions.h"
+#include "../../numeric_id.h"
 
 namespace vsn {	namespace semver {
+namespace {
+	// Validate that normal version component is not negative.
+	inline void check_component(const int v, const char* name) {
+		if (v < 0) throw ModificationError(std::string(name) + " version cannot be less than 0");
+	}
+
+	inline bool is_digit(const char c) {
+		return c >= '0' && c <= '9';
+	}
+
+	inline bool is_identifier_char(const char c) {
+		return is_digit(c) || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '-';
+	}
+
+	// Validate that identifier is non-empty and made of allowed characters only; return if it is all digits.
+	bool check_identifier(const std::string& id) {
+		if (id.empty()) throw ModificationError("version identifier cannot be empty");
+		bool numeric = true;
+		for (const auto c : id) {
+			if (!is_identifier_char(c)) throw ModificationError("invalid character in identifier: " + id);
+			numeric &= is_digit(c);
+		}
+		return numeric;
+	}
+
+	void check_prerelease(const Prerelease_identifiers& pr) {
+		for (const auto& id : pr) {
+			bool numeric = check_identifier(id.first);
+			if (numeric != (id.second == Id_type::num))
+				throw ModificationError("identifier type does not match its value: " + id.first);
+			if (numeric && id.first.length() > 1 && id.first[0] == '0')
+				throw ModificationError("numeric identifiers cannot have leading 0");
+		}
+	}
+
+	void check_build(const Build_identifiers& b) {
+		for (const auto& id : b) {
+			check_identifier(id);
+		}
+	}
+
+	// Increment pre-release identifiers of the version as described in Modifier::IncPreRelease.
+	void inc_prerelease(VersionData& s) {
+		if (s.prerelease_ids.empty()) {
+			if (s.patch == INT_MAX) throw ModificationError("patch version overflow");
+			s.build_ids.clear();
+			++s.patch;
+			s.prerelease_ids.emplace_back("0", Id_type::num);
+			return;
+		}
+		s.build_ids.clear();
+		for (auto it = s.prerelease_ids.rbegin(); it != s.prerelease_ids.rend(); ++it) {
+			if (it->second == Id_type::num) {
+				increment_numeric_id(it->first);
+				return;
+			}
+		}
+		s.prerelease_ids.emplace_back("0", Id_type::num);
+	}
+}
+
 	VersionData Modifier::SetMajor(const VersionData & s, const int m) const {
-		if (m < 0) throw ModificationError("major version cannot be less than 0");
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "major");
 		return VersionData{ m, s.minor, s.patch, s.prerelease_ids, s.build_ids };
 	}
 
 	VersionData Modifier::SetMinor(const VersionData &s, const int m) const {
-		if (m < 0) throw ModificationError("minor version cannot be less than 0");
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "minor");
 		return VersionData{ s.major, m, s.patch, s.prerelease_ids, s.build_ids };
 	}
 
 	VersionData Modifier::SetPatch(const VersionData &s, const int p) const {
-		if (p < 0) throw ModificationError("patch version cannot be less than 0");
+		VERSIONING_INSTRUMENT(modify);
+		check_component(p, "patch");
 		return VersionData{ s.major, s.minor, p, s.prerelease_ids, s.build_ids };
 	}
 
 	VersionData Modifier::SetPreRelease(const VersionData &s, const Prerelease_identifiers &pr) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_prerelease(pr);
 		return VersionData{ s.major, s.minor, s.patch, pr, s.build_ids };
 	}
 
 	VersionData Modifier::SetBuild(const VersionData &s, const Build_identifiers &b) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_build(b);
 		return VersionData{ s.major, s.minor, s.patch, s.prerelease_ids, b };
 	}
 
 	VersionData Modifier::ResetMajor(const VersionData &, const int m) const {
-		if (m < 0) throw ModificationError("major version cannot be less than 0");
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "major");
 		return VersionData{ m, 0, 0, Prerelease_identifiers{}, Build_identifiers{} };
 	}
 
 	VersionData Modifier::ResetMinor(const VersionData &s, const int m) const {
-		if (m < 0) throw ModificationError("minor version cannot be less than 0");
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "minor");
 		return VersionData{ s.major, m, 0, Prerelease_identifiers{}, Build_identifiers{} };
 	}
 
 	VersionData Modifier::ResetPatch(const VersionData &s, const int p) const {
-		if (p < 0) throw ModificationError("patch version cannot be less than 0");
+		VERSIONING_INSTRUMENT(modify);
+		check_component(p, "patch");
 		return VersionData{ s.major, s.minor, p, Prerelease_identifiers{}, Build_identifiers{} };
 	}
 
 	VersionData Modifier::ResetPreRelease(const VersionData &s, const Prerelease_identifiers &pr) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_prerelease(pr);
 		return VersionData{ s.major, s.minor, s.patch, pr, Build_identifiers{} };
 	}
 
 	VersionData Modifier::ResetBuild(const VersionData &s, const Build_identifiers &b) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_build(b);
 		return VersionData{ s.major, s.minor, s.patch, s.prerelease_ids, b };
 	}
+
+	VersionData Modifier::IncPreRelease(const VersionData &s) const {
+		VERSIONING_INSTRUMENT(modify);
+		VersionData d{ s.major, s.minor, s.patch, s.prerelease_ids, Build_identifiers{} };
+		inc_prerelease(d);
+		return d;
+	}
+
+	// Rvalue overloads modify source object in place and move it out, so identifier storage
+	// travels along modification chains instead of being copied at every step.
+
+	VersionData Modifier::SetMajor(VersionData&& s, const int m) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "major");
+		s.major = m;
+		return std::move(s);
+	}
+
+	VersionData Modifier::SetMinor(VersionData&& s, const int m) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "minor");
+		s.minor = m;
+		return std::move(s);
+	}
+
+	VersionData Modifier::SetPatch(VersionData&& s, const int p) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_component(p, "patch");
+		s.patch = p;
+		return std::move(s);
+	}
+
+	VersionData Modifier::SetPreRelease(VersionData&& s, const Prerelease_identifiers& pr) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_prerelease(pr);
+		s.prerelease_ids = pr;
+		return std::move(s);
+	}
+
+	VersionData Modifier::SetBuild(VersionData&& s, const Build_identifiers& b) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_build(b);
+		s.build_ids = b;
+		return std::move(s);
+	}
+
+	VersionData Modifier::ResetMajor(VersionData&& s, const int m) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "major");
+		s.major = m;
+		s.minor = 0;
+		s.patch = 0;
+		s.prerelease_ids.clear();
+		s.build_ids.clear();
+		return std::move(s);
+	}
+
+	VersionData Modifier::ResetMinor(VersionData&& s, const int m) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_component(m, "minor");
+		s.minor = m;
+		s.patch = 0;
+		s.prerelease_ids.clear();
+		s.build_ids.clear();
+		return std::move(s);
+	}
+
+	VersionData Modifier::ResetPatch(VersionData&& s, const int p) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_component(p, "patch");
+		s.patch = p;
+		s.prerelease_ids.clear();
+		s.build_ids.clear();
+		return std::move(s);
+	}
+
+	VersionData Modifier::ResetPreRelease(VersionData&& s, const Prerelease_identifiers& pr) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_prerelease(pr);
+		s.prerelease_ids = pr;
+		s.build_ids.clear();
+		return std::move(s);
+	}
+
+	VersionData Modifier::ResetBuild(VersionData&& s, const Build_identifiers& b) const {
+		VERSIONING_INSTRUMENT(modify);
+		check_build(b);
+		s.build_ids = b;
+		return std::move(s);
+	}
+
+	VersionData Modifier::IncPreRelease(VersionData&& s) const {
+		VERSIONING_INSTRUMENT(modify);
+		inc_prerelease(s);
+		return std::move(s);
+	}
 }}
\ No newline at end of file
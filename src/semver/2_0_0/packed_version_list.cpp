@@ -0,0 +1,296 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <versioning/semver/2_0_0/comparator.h>
+#include "../../numeric_id.h"
+#include "../../varint.h"
+#include "versioning/semver/2_0_0/packed_version_list.h"
+
+namespace vsn { namespace semver {
+namespace {
+    // First byte of an entry. Two low bits tell which version component changed first: 0 - none, 1 - patch,
+    // 2 - minor, 3 - major. Next two bits tell how prerelease identifiers changed, the bit after them whether
+    // build identifiers changed.
+    const uint8_t level_mask = 3;
+    const int prerelease_shift = 2;
+    const uint8_t build_changed = 16;
+
+    enum PrereleaseChange : uint8_t {
+        same, ///< Identifiers are same as in previous version.
+        cleared, ///< Version is a release.
+        incremented, ///< Last numeric identifier of reference identifiers is incremented by one.
+        replaced ///< Identifiers past shared prefix of reference identifiers follow.
+    };
+
+    const Comparator comparator;
+
+    // Order of versions in list: by precedence, versions of equal precedence by build identifiers.
+    bool precedes(const VersionData& l, const VersionData& r) {
+        const int cmp = comparator.Compare(l, r);
+        return cmp < 0 || (cmp == 0 && l.build_ids < r.build_ids);
+    }
+
+    void reset(VersionData& v, Prerelease_identifiers& reference) {
+        v.major = v.minor = v.patch = 0;
+        v.prerelease_ids.clear();
+        v.build_ids.clear();
+        reference.clear();
+    }
+
+    bool is_increment(const Prerelease_identifiers& from, const Prerelease_identifiers& to) {
+        if (from.empty() || from.size() != to.size()) return false;
+        if (from.back().second != Id_type::num || to.back().second != Id_type::num) return false;
+        if (!std::equal(from.begin(), from.end() - 1, to.begin())) return false;
+        std::string next = from.back().first;
+        increment_numeric_id(next);
+        return next == to.back().first;
+    }
+
+    inline void put_bytes(std::vector<uint8_t>& out, const std::string& s) {
+        out.insert(out.end(), s.begin(), s.end());
+    }
+
+    // Append delta of v against base, which v does not precede. Prerelease identifiers are shared with reference,
+    // the last non-empty prerelease identifiers of the block.
+    void encode(const VersionData& base, const Prerelease_identifiers& reference, const VersionData& v,
+                std::vector<uint8_t>& out) {
+        const uint8_t level = v.major != base.major ? 3 : v.minor != base.minor ? 2 : v.patch != base.patch ? 1 : 0;
+        const auto& ids = v.prerelease_ids;
+        const PrereleaseChange change = ids == base.prerelease_ids ? same : ids.empty() ? cleared
+                : is_increment(reference, ids) ? incremented : replaced;
+        const bool build = v.build_ids != base.build_ids;
+        out.push_back(static_cast<uint8_t>(level | change << prerelease_shift | (build ? build_changed : 0)));
+
+        // Versions are sorted, so the first changed component only grows and is stored as a difference.
+        switch (level) {
+            case 3:
+                put_varint(out, static_cast<uint64_t>(v.major - base.major));
+                put_varint(out, static_cast<uint64_t>(v.minor));
+                put_varint(out, static_cast<uint64_t>(v.patch));
+                break;
+            case 2:
+                put_varint(out, static_cast<uint64_t>(v.minor - base.minor));
+                put_varint(out, static_cast<uint64_t>(v.patch));
+                break;
+            case 1:
+                put_varint(out, static_cast<uint64_t>(v.patch - base.patch));
+                break;
+        }
+
+        if (change == replaced) {
+            size_t shared = 0;
+            while (shared < ids.size() && shared < reference.size() && ids[shared] == reference[shared]) ++shared;
+            put_varint(out, shared);
+            put_varint(out, ids.size() - shared);
+            for (size_t i = shared; i < ids.size(); ++i) {
+                put_varint(out, ids[i].first.size() << 1 | (ids[i].second == Id_type::num ? 1 : 0));
+                put_bytes(out, ids[i].first);
+            }
+        }
+
+        if (build) {
+            put_varint(out, v.build_ids.size());
+            for (const auto& id : v.build_ids) {
+                put_varint(out, id.size());
+                put_bytes(out, id);
+            }
+        }
+    }
+
+    inline int get_int(const uint8_t*& p) {
+        return static_cast<int>(get_varint(p));
+    }
+
+    // Apply entry at p to previous version v, reusing storage of its identifiers; returns position of next entry.
+    // While v is a release, reference keeps the last non-empty prerelease identifiers; they are swapped in and
+    // out rather than copied.
+    const uint8_t* apply(const uint8_t* p, VersionData& v, Prerelease_identifiers& reference) {
+        const uint8_t flags = *p++;
+        switch (flags & level_mask) {
+            case 3:
+                v.major += get_int(p);
+                v.minor = get_int(p);
+                v.patch = get_int(p);
+                break;
+            case 2:
+                v.minor += get_int(p);
+                v.patch = get_int(p);
+                break;
+            case 1:
+                v.patch += get_int(p);
+                break;
+        }
+
+        auto& ids = v.prerelease_ids;
+        switch (static_cast<PrereleaseChange>(flags >> prerelease_shift & 3)) {
+            case same:
+                break;
+            case cleared:
+                ids.swap(reference);
+                ids.clear();
+                break;
+            case incremented:
+                if (ids.empty()) ids.swap(reference);
+                increment_numeric_id(ids.back().first);
+                break;
+            case replaced: {
+                if (ids.empty()) ids.swap(reference);
+                const size_t shared = static_cast<size_t>(get_varint(p));
+                const size_t added = static_cast<size_t>(get_varint(p));
+                ids.resize(shared + added);
+                for (size_t i = shared; i < shared + added; ++i) {
+                    const uint64_t tag = get_varint(p);
+                    const size_t length = static_cast<size_t>(tag >> 1);
+                    ids[i].first.assign(reinterpret_cast<const char*>(p), length);
+                    ids[i].second = tag & 1 ? Id_type::num : Id_type::alnum;
+                    p += length;
+                }
+                break;
+            }
+        }
+
+        if (flags & build_changed) {
+            v.build_ids.resize(static_cast<size_t>(get_varint(p)));
+            for (auto& id : v.build_ids) {
+                const size_t length = static_cast<size_t>(get_varint(p));
+                id.assign(reinterpret_cast<const char*>(p), length);
+                p += length;
+            }
+        }
+        return p;
+    }
+}
+
+    PackedVersionList::Iterator::Iterator(const PackedVersionList* list, const size_t block)
+            : list_{ list }, index_{ block * list->block_size_ }, block_end_{ index_ + list->block_size_ },
+              pos_{ nullptr } {
+        if (index_ < list_->size_) pos_ = apply(list_->bytes_.data() + list_->blocks_[block], current_, reference_);
+    }
+
+    PackedVersionList::Iterator& PackedVersionList::Iterator::operator++() {
+        if (++index_ < list_->size_) {
+            // Blocks are stored back to back; only the first version of a block is not a delta.
+            if (index_ == block_end_) {
+                reset(current_, reference_);
+                block_end_ += list_->block_size_;
+            }
+            pos_ = apply(pos_, current_, reference_);
+        }
+        return *this;
+    }
+
+    PackedVersionList::PackedVersionList(const size_t block_size)
+            : block_size_{ block_size ? block_size : 1 }, size_{ 0 } {}
+
+    /// Build list from versions in any order.
+    /**
+    Versions are sorted first, so building takes O(n log n) comparisons; appending already sorted versions one
+    by one is linear.
+    */
+    PackedVersionList::PackedVersionList(std::vector<VersionData> versions, const size_t block_size)
+            : PackedVersionList(block_size) {
+        std::sort(versions.begin(), versions.end(), precedes);
+        for (const auto& v : versions) Append(v);
+        ShrinkToFit();
+    }
+
+    bool PackedVersionList::Append(const VersionData& v) {
+        if (v.major < 0 || v.minor < 0 || v.patch < 0) return false;
+        if (size_ && precedes(v, last_)) return false;
+        if (size_ % block_size_ == 0) {
+            blocks_.push_back(bytes_.size());
+            reset(last_, last_prerelease_);
+        }
+        encode(last_, last_.prerelease_ids.empty() ? last_prerelease_ : last_.prerelease_ids, v, bytes_);
+        if (v.prerelease_ids.empty() && !last_.prerelease_ids.empty()) last_prerelease_.swap(last_.prerelease_ids);
+        last_ = v;
+        ++size_;
+        return true;
+    }
+
+    VersionData PackedVersionList::At(const size_t index) const {
+        return *Seek(index);
+    }
+
+    PackedVersionList::Iterator PackedVersionList::Seek(const size_t index) const {
+        if (index >= size_) return end();
+        Iterator it(this, index / block_size_);
+        while (it.index_ < index) ++it;
+        return it;
+    }
+
+    PackedVersionList::Iterator PackedVersionList::LowerBound(const VersionData& v) const {
+        return bound(v, false);
+    }
+
+    PackedVersionList::Iterator PackedVersionList::UpperBound(const VersionData& v) const {
+        return bound(v, true);
+    }
+
+    // Binary search for the first block whose first version is past the bound, then scan the block before it.
+    PackedVersionList::Iterator PackedVersionList::bound(const VersionData& v, const bool upper) const {
+        auto past = [&v, upper](const VersionData& x) {
+            const int cmp = comparator.Compare(x, v);
+            return upper ? cmp > 0 : cmp >= 0;
+        };
+        VersionData head;
+        Prerelease_identifiers reference;
+        size_t low = 0, high = blocks_.size();
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            reset(head, reference);
+            apply(bytes_.data() + blocks_[mid], head, reference);
+            if (past(head)) high = mid;
+            else low = mid + 1;
+        }
+        if (low == 0) return begin();
+        Iterator it(this, low - 1);
+        while (it.index_ < size_ && !past(*it)) ++it;
+        return it;
+    }
+
+    PackedVersionList::Iterator PackedVersionList::begin() const {
+        return Iterator(this, 0);
+    }
+
+    PackedVersionList::Iterator PackedVersionList::end() const {
+        Iterator it;
+        it.list_ = this;
+        it.index_ = size_;
+        return it;
+    }
+
+    std::vector<VersionData> PackedVersionList::ToVector() const {
+        std::vector<VersionData> res;
+        res.reserve(size_);
+        for (const auto& v : *this) res.push_back(v);
+        return res;
+    }
+
+    void PackedVersionList::ShrinkToFit() {
+        bytes_.shrink_to_fit();
+        blocks_.shrink_to_fit();
+    }
+}}
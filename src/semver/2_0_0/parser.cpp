@@ -22,156 +22,319 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-#include <functional>
+#include <climits>
+#include <cstdint>
+#include <string>
+#include <versioning/metrics.h>
 #include <versioning/version_data.h>
+#include "../../char_classes.h"
 #include "../../exceptions.h"
 #include "versioning/semver/2_0_0/parser.h"
-
-#ifdef _MSC_VER
-// disable symbol name too long warning
-#pragma warning(disable:4503)
-#endif
+#include "versioning/semver/2_0_0/constexpr_version.h"
 
 namespace vsn {	namespace semver {
-    const std::vector<std::pair<char, char>> Parser::allowed_prerel_id_chars = {
-            { '0', '9' },{ 'A','Z' },{ 'a','z' },{ '-','-' }
+namespace {
+    // First problem found in version text.
+    struct Failure {
+        ParseErrorReason reason;
+        const char* message;
+        char c; // offending character, for invalid_character
     };
 
-    inline Transition Parser::mkx(const char c, ParserState p, State_transition_hook pth) const {
-        return std::make_tuple(c, p, pth);
+    inline bool fail(Failure& f, ParseErrorReason reason, const char* message, char c = 0) {
+        f = Failure{ reason, message, c };
+        return false;
+    }
+
+    [[noreturn]] void raise(const Failure& f) {
+#ifdef VERSIONING_METRICS
+        metrics::CountParseFailure(f.reason);
+#endif
+        if (f.reason == ParseErrorReason::invalid_character) {
+            throw ParseError(f.reason, std::string(f.message) + std::string(1, f.c));
+        }
+        throw ParseError(f.reason, f.message);
+    }
+
+    inline bool is_digit(const char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    inline uint8_t class_of(const char c) {
+        return char_classes.of[static_cast<unsigned char>(c)];
+    }
+
+    inline bool is_identifier_char(const char c) {
+        return (class_of(c) & CharClasses::identifier_char) != 0;
+    }
+
+    inline bool invalid_character(Failure& f, const char c) {
+        return fail(f, ParseErrorReason::invalid_character, "invalid character encountered: ", c);
+    }
+
+    // Scan normal version component (major, minor or patch). Every component but the last one must be followed
+    // by '.'; the last one may be followed by prerelease or build identifiers.
+    bool scan_component(const char*& p, const char* end, const bool last, int& value, Failure& f) {
+        const char* first = p;
+        int v = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            if (p != first && *first == '0') return fail(f, ParseErrorReason::leading_zero, "leading 0 not allowed");
+            int digit = *p - '0';
+            if (v > (INT_MAX - digit) / 10) return fail(f, ParseErrorReason::overflow, "version number out of range");
+            v = v * 10 + digit;
+        }
+        if (p == end) {
+            if (!last) return fail(f, ParseErrorReason::missing_component, "missing version component");
+        }
+        else if (last ? (*p != '-' && *p != '+') : *p != '.') {
+            return invalid_character(f, *p);
+        }
+        if (p == first) return fail(f, ParseErrorReason::missing_component, "missing version component");
+        value = v;
+        return true;
+    }
+
+    inline void add_identifier(Prerelease_identifiers& ids, const char* first, const char* last, bool numeric) {
+        ids.emplace_back(std::string(first, last), numeric ? Id_type::num : Id_type::alnum);
+    }
+
+    inline void add_identifier(Build_identifiers& ids, const char* first, const char* last, bool) {
+        ids.emplace_back(first, last);
     }
 
-    inline void Parser::process_char(const char c, ParserState& cstate, ParserState& pstate,
-                             const Transitions& transitions, std::string& target, Validator validate) const {
-        for (const auto& transition : transitions) {
-            if (c == std::get<0>(transition)) {
-                if (std::get<2>(transition)) std::get<2>(transition)(target);
-                pstate = cstate;
-                cstate = std::get<1>(transition);
-                return;
+    // Scan dot-separated identifiers. Prerelease identifiers end at '+' or end of text, build identifiers at end of
+    // text. Identifiers are added to out, unless it is null; storage for all of them is reserved up front.
+    template<typename Ids>
+    bool scan_identifiers(const char*& p, const char* end, const bool prerelease, Ids* out, Failure& f) {
+        if (out) {
+            size_t count = 1;
+            for (const char* q = p; q != end && !(prerelease && *q == '+'); ++q) count += *q == '.';
+            out->reserve(out->size() + count);
+        }
+        for (;;) {
+            const char* first = p;
+            bool numeric = true;
+            for (uint8_t c; p != end && ((c = class_of(*p)) & CharClasses::identifier_char); ++p) {
+                numeric &= (c & CharClasses::digit) != 0;
             }
+            if (p != end && *p != '.' && !(prerelease && *p == '+')) return invalid_character(f, *p);
+            if (p == first) return fail(f, ParseErrorReason::empty_identifier, "version identifier cannot be empty");
+            if (prerelease && numeric && p - first > 1 && *first == '0') {
+                return fail(f, ParseErrorReason::leading_zero, "numeric identifiers cannot have leading 0");
+            }
+            if (out) add_identifier(*out, first, p, numeric);
+            if (p == end || *p != '.') return true;
+            ++p;
+        }
+    }
+
+    // Scan complete version text, storing its parts to out unless it is null.
+    bool scan(const char* p, const char* end, VersionData* out, Failure& f) {
+        int major, minor, patch;
+        if (!scan_component(p, end, false, major, f)) return false;
+        ++p;
+        if (!scan_component(p, end, false, minor, f)) return false;
+        ++p;
+        if (!scan_component(p, end, true, patch, f)) return false;
+        if (out) {
+            out->major = major;
+            out->minor = minor;
+            out->patch = patch;
         }
-        validate(target, c);
-        target.push_back(c);
+        if (p != end && *p == '-') {
+            ++p;
+            if (!scan_identifiers(p, end, true, out ? &out->prerelease_ids : nullptr, f)) return false;
+        }
+        if (p != end && *p == '+') {
+            ++p;
+            if (!scan_identifiers(p, end, false, out ? &out->build_ids : nullptr, f)) return false;
+        }
+        return true;
+    }
+
+    inline bool is_space(const char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
     }
 
-    inline void Parser::normal_version_validator(const std::string& tgt, const char c) {
-        if (c < '0' || c > '9') throw ParseError("invalid character encountered: " + std::string(1, c));
-        if (tgt.compare(0, 1, "0") == 0) throw ParseError("leading 0 not allowed");
+    inline void apply(unsigned& coercions, const Coercion c) {
+        coercions |= static_cast<unsigned>(c);
     }
 
-    inline void Parser::prerelease_version_validator(const std::string&, const char c) {
-        bool res = false;
-        for (const auto& r : allowed_prerel_id_chars) {
-            res |= (c >= r.first && c <= r.second);
+    // Scan version number, dropping leading zeros.
+    bool coerce_number(const char*& p, const char* end, int& value, unsigned& coercions, Failure& f) {
+        for (; *p == '0' && p + 1 != end && is_digit(p[1]); ++p) apply(coercions, Coercion::leading_zero);
+        int v = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            int digit = *p - '0';
+            if (v > (INT_MAX - digit) / 10) return fail(f, ParseErrorReason::overflow, "version number out of range");
+            v = v * 10 + digit;
         }
-        if (!res)
-            throw ParseError("invalid character encountered: " + std::string(1, c));
+        value = v;
+        return true;
     }
 
-    inline bool Parser::is_identifier_numeric(const std::string& id) const {
-        return id.find_first_not_of("0123456789") == std::string::npos;
+    inline bool numeric_follows(const char* p, const char* end) {
+        return p != end && *p == '.' && p + 1 != end && is_digit(p[1]);
     }
 
-    inline bool Parser::check_for_leading_0(const std::string& str) const {
-        return str.length() > 1 && str[0] == '0';
+    // Coerce dot-separated identifiers, ending like in scan_identifiers. Empty identifiers are dropped, invalid
+    // characters replaced and leading zeros removed from numeric prerelease identifiers.
+    template<typename Ids>
+    void coerce_identifiers(const char*& p, const char* end, const bool prerelease, Ids& out, unsigned& coercions) {
+        for (;;) {
+            const char* first = p;
+            bool numeric = true, valid = true;
+            for (; p != end && *p != '.' && !(prerelease && *p == '+'); ++p) {
+                numeric &= is_digit(*p);
+                valid &= is_identifier_char(*p);
+            }
+            if (p == first) {
+                apply(coercions, Coercion::empty_identifier);
+            }
+            else if (!valid) {
+                apply(coercions, Coercion::invalid_character);
+                std::string id(first, p);
+                for (auto& c : id) {
+                    if (!is_identifier_char(c)) c = '-';
+                }
+                add_identifier(out, id.data(), id.data() + id.size(), false);
+            }
+            else {
+                if (prerelease && numeric) {
+                    for (; *first == '0' && p - first > 1; ++first) apply(coercions, Coercion::leading_zero);
+                }
+                add_identifier(out, first, p, numeric);
+            }
+            if (p == end || *p != '.') return;
+            ++p;
+        }
     }
 
-    void Parser::prerelease_hook_impl(std::string& id, Prerelease_identifiers& prerelease) const {
-        if (id.empty()) throw ParseError("version identifier cannot be empty");
-        Id_type t = Id_type::alnum;
-        if (is_identifier_numeric(id)) {
-            t = Id_type::num;
-            if (check_for_leading_0(id)) {
-                throw ParseError("numeric identifiers cannot have leading 0");
+    bool coerce(const char* p, const char* end, CoercedVersion& out, Failure& f) {
+        auto& v = out.version;
+        v.major = v.minor = v.patch = 0;
+        v.prerelease_ids.clear();
+        v.build_ids.clear();
+        out.coercions = 0;
+
+        const char* first = p;
+        const char* last = end;
+        for (; p != end && is_space(*p); ++p) {}
+        for (; end != p && is_space(end[-1]); --end) {}
+        if (p != first || end != last) apply(out.coercions, Coercion::trimmed);
+        first = p;
+        for (; p != end && !is_digit(*p); ++p) {}
+        if (p == end) return fail(f, ParseErrorReason::missing_component, "no version number found");
+        if (p != first) apply(out.coercions, Coercion::prefix);
+
+        if (!coerce_number(p, end, v.major, out.coercions, f)) return false;
+        int* next[] = { &v.minor, &v.patch };
+        for (int* component : next) {
+            if (!numeric_follows(p, end)) {
+                apply(out.coercions, Coercion::padded);
+                continue;
             }
+            ++p;
+            if (!coerce_number(p, end, *component, out.coercions, f)) return false;
+        }
+        while (numeric_follows(p, end)) {
+            apply(out.coercions, Coercion::extra_components);
+            first = ++p;
+            for (; p != end && is_digit(*p); ++p) {}
+            add_identifier(v.build_ids, first, p, true);
         }
-        prerelease.push_back({id, t});
-        id.clear();
+
+        bool prerelease = p != end && *p == '-';
+        if (prerelease) {
+            ++p;
+        }
+        else if (p != end && *p != '+') {
+            // Anything else starts prerelease identifiers: "1.0rc1", "1.0_beta", "1.0.beta".
+            apply(out.coercions, Coercion::separator);
+            if (*p == '.' || *p == '_' || *p == '~' || is_space(*p)) ++p;
+            prerelease = p != end;
+        }
+        if (prerelease) coerce_identifiers(p, end, true, v.prerelease_ids, out.coercions);
+        if (p != end && *p == '+') {
+            ++p;
+            coerce_identifiers(p, end, false, v.build_ids, out.coercions);
+        }
+        return true;
     }
 
-    void Parser::build_hook_impl(std::string& id, ParserState & pstate, Build_identifiers& build,
-                         std::string& prerelease_id, Prerelease_identifiers& prerelease) const {
-        // process last token left from parsing prerelease data
-        if (pstate == ParserState::prerelease) prerelease_hook_impl(prerelease_id, prerelease);
-        if (id.empty()) throw ParseError("version identifier cannot be empty");
-        build.push_back(id);
-        id.clear();
+    // Scan identifiers making up whole text.
+    template<typename Ids>
+    Ids parse_identifiers(const std::string& s, const bool prerelease) {
+        Ids ids;
+        Failure f;
+        const char* p = s.data();
+        const char* end = p + s.size();
+        bool ok = scan_identifiers(p, end, prerelease, &ids, f);
+        if (ok && p != end) ok = invalid_character(f, *p);
+        if (!ok) raise(f);
+        return ids;
+    }
+}
+
+    // Report failure of constexpr parsing the same way Parse() does, counting it with metrics.
+    void detail::constexpr_parse_error(const ParseErrorReason reason, const char* message, const char c) {
+        raise(Failure{ reason, message, c });
     }
 
     /// Parse semver 2.0.0-compatible string to Version_data structure.
     /**
-    Version text parser is implemented as a state machine. In each step one successive character from version
-    string is consumed and is either added to current token or triggers state transition. Hooks can be
-    injected into state transitions for validation/customization purposes.
+    Version text is scanned in a single pass, component by component; identifiers are copied straight from the
+    text into reserved storage, so parsing a release version does not allocate.
     */
     VersionData Parser::Parse(const std::string &s) const {
-        std::string major;
-        std::string minor;
-        std::string patch;
-        std::string prerelease_id;
-        std::string build_id;
-        Prerelease_identifiers prerelease;
-        Build_identifiers build;
-        ParserState cstate{ ParserState::major };
-        ParserState pstate;
-
-        auto prerelease_hook = [&](std::string& id) {
-            prerelease_hook_impl(id, prerelease);
-        };
-
-        auto build_hook = [&](std::string& id) {
-            build_hook_impl(id, pstate, build, prerelease_id, prerelease);
-        };
-
-        // State transition tables
-        auto major_trans = {
-                mkx('.', ParserState::minor, {})
-        };
-        auto minor_trans = {
-                mkx('.', ParserState::patch, {})
-        };
-        auto patch_trans = {
-                mkx('-', ParserState::prerelease, {}),
-                mkx('+', ParserState::build, {})
-        };
-        auto prerelease_trans = {
-                // When identifier separator (.) is found, stay in the same state but invoke hook
-                // in order to process each individual identifier separately.
-                mkx('.', ParserState::prerelease, prerelease_hook),
-                mkx('+', ParserState::build, {})
-        };
-        auto build_trans = {
-                // Same stay-in-the-same-state-but-invoke-hook trick from above.
-                mkx('.', ParserState::build, build_hook)
-        };
-
-        State_machine state_machine = {
-                {ParserState::major, State{major_trans, major, normal_version_validator}},
-                {ParserState::minor, State{minor_trans, minor, normal_version_validator}},
-                {ParserState::patch, State{patch_trans, patch, normal_version_validator}},
-                {ParserState::prerelease, State{prerelease_trans, prerelease_id, prerelease_version_validator}},
-                {ParserState::build, State{build_trans, build_id, prerelease_version_validator}}
-        };
-
-        // Main loop.
-        for (const auto& c : s) {
-            auto state = state_machine.at(cstate);
-            process_char(c, cstate, pstate, std::get<0>(state), std::get<1>(state), std::get<2>(state));
-        }
-
-        // Trigger appropriate hooks in order to process last token, because no state transition was
-        // triggered for it.
-        if (cstate == ParserState::prerelease) {
-            prerelease_hook(prerelease_id);
-        } else if (cstate == ParserState::build) {
-            build_hook(build_id);
-        }
-
-        try {
-            return VersionData{ stoi(major), stoi(minor), stoi(patch), prerelease, build };
-        } catch (std::invalid_argument& ex) {
-            throw ParseError(ex.what());
-        }
+        VERSIONING_INSTRUMENT(parse);
+        VersionData data;
+        Failure f;
+        if (!scan(s.data(), s.data() + s.size(), &data, f)) raise(f);
+        return data;
+    }
+
+    Prerelease_identifiers Parser::ParsePreRelease(const std::string& s) const {
+        VERSIONING_INSTRUMENT(parse);
+        return parse_identifiers<Prerelease_identifiers>(s, true);
+    }
+
+    Build_identifiers Parser::ParseBuild(const std::string& s) const {
+        VERSIONING_INSTRUMENT(parse);
+        return parse_identifiers<Build_identifiers>(s, false);
+    }
+
+    bool Parser::IsValid(const char* s, const size_t size) const {
+        Failure f;
+        return scan(s, s + size, nullptr, f);
+    }
+
+    bool Parser::IsValid(const char* s, const size_t size, ParseErrorReason& reason) const {
+        Failure f;
+        if (scan(s, s + size, nullptr, f)) return true;
+        reason = f.reason;
+        return false;
+    }
+
+    CoercedVersion CoercingParser::Coerce(const std::string& s) const {
+        VERSIONING_INSTRUMENT(parse);
+        CoercedVersion res;
+        Failure f;
+        if (!coerce(s.data(), s.data() + s.size(), res, f)) raise(f);
+        return res;
+    }
+
+    bool CoercingParser::TryCoerce(const std::string& s, CoercedVersion& out) const {
+        return TryCoerce(s.data(), s.size(), out);
+    }
+
+    bool CoercingParser::TryCoerce(const char* s, const size_t size, CoercedVersion& out) const {
+        VERSIONING_INSTRUMENT(parse);
+        Failure f;
+        return coerce(s, s + size, out, f);
+    }
+
+    VersionData CoercingParser::Parse(const std::string& s) const {
+        return Coerce(s).version;
     }
 }}
@@ -0,0 +1,59 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <iterator>
+#include "versioning/semver/2_0_0/pipeline_stages.h"
+#include "exceptions.h"
+
+namespace vsn { namespace semver {
+    void ParseStage::operator()(std::vector<std::string>& batch, std::vector<Version>& out) const {
+        for (auto& s : batch) {
+            try {
+                out.emplace_back(std::move(s));
+            }
+            catch (const ParseError&) {}
+        }
+    }
+
+    void DedupeStage::operator()(std::vector<Version>& batch, std::vector<Version>& out) {
+        for (auto& v : batch) {
+            if (seen_.insert(v.ToString()).second) out.push_back(std::move(v));
+        }
+    }
+
+    void SortStage::operator()(std::vector<Version>& batch, std::vector<Version>&) {
+        held_.insert(held_.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    }
+
+    void SortStage::Flush(std::vector<Version>& out) {
+        std::stable_sort(held_.begin(), held_.end());
+        out.insert(out.end(), std::make_move_iterator(held_.begin()), std::make_move_iterator(held_.end()));
+        held_.clear();
+    }
+
+    void FormatStage::operator()(std::vector<Version>& batch, std::vector<std::string>& out) const {
+        for (const auto& v : batch) out.push_back(v.ToString());
+    }
+}}
@@ -0,0 +1,180 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "versioning/semver/2_0_0/registry.h"
+
+namespace vsn { namespace semver {
+    // Versions of equal precedence are told apart by build metadata only.
+    inline bool same_version(const Version& l, const Version& r) {
+        return l == r && l.Build() == r.Build();
+    }
+
+    // Find the last release (or any version if prereleases are allowed) in [first, last).
+    inline const Version* last_matching(const Version* first, const Version* last, bool prerelease) {
+        while (last != first) {
+            --last;
+            if (prerelease || last->PreRelease().empty()) return last;
+        }
+        return nullptr;
+    }
+
+    Registry::Registry() {
+        for (auto& shard : shards_) {
+            shard.store(new Shard{});
+        }
+    }
+
+    Registry::~Registry() {
+        for (auto& shard : shards_) {
+            delete shard.load();
+        }
+        for (auto& p : packages_) {
+            delete p->versions.load();
+        }
+    }
+
+    std::atomic<const Registry::Shard*>& Registry::shard_for(const std::string& package) const {
+        return shards_[std::hash<std::string>()(package) % shard_count];
+    }
+
+    const Registry::Versions* Registry::find(const std::string& package) const {
+        const Shard* shard = shard_for(package).load();
+        auto it = shard->find(package);
+        if (it == shard->end()) return nullptr;
+        return it->second->versions.load();
+    }
+
+    Registry::Package& Registry::get_or_add_locked(const std::string& package) {
+        auto& slot = shard_for(package);
+        const Shard* shard = slot.load();
+        auto it = shard->find(package);
+        if (it != shard->end()) return *it->second;
+
+        packages_.emplace_back(new Package{});
+        Package* p = packages_.back().get();
+        p->versions.store(new Versions{});
+        auto copy = new Shard(*shard);
+        copy->emplace(package, p);
+        slot.store(copy);
+        domain_.Retire(shard);
+        return *p;
+    }
+
+    void Registry::replace_locked(Package& p, const Versions* list) {
+        const Versions* old = p.versions.exchange(list);
+        domain_.Retire(old);
+    }
+
+    bool Registry::Publish(const std::string& package, const Version& version) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        Package& p = get_or_add_locked(package);
+        const Versions* current = p.versions.load();
+
+        // Insert after all versions of equal precedence, so equal versions keep insertion order.
+        auto lo = std::lower_bound(current->begin(), current->end(), version);
+        auto pos = std::upper_bound(lo, current->end(), version);
+        if (std::any_of(lo, pos, [&](const Version& v) { return same_version(v, version); })) return false;
+
+        auto list = new Versions();
+        list->reserve(current->size() + 1);
+        list->insert(list->end(), current->begin(), pos);
+        list->push_back(version);
+        list->insert(list->end(), pos, current->end());
+        replace_locked(p, list);
+        return true;
+    }
+
+    size_t Registry::Publish(const std::string& package, std::vector<Version> versions) {
+        std::stable_sort(versions.begin(), versions.end());
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        Package& p = get_or_add_locked(package);
+        const Versions* current = p.versions.load();
+
+        std::unique_ptr<Versions> list(new Versions());
+        list->reserve(current->size() + versions.size());
+        std::merge(current->begin(), current->end(), std::make_move_iterator(versions.begin()),
+                   std::make_move_iterator(versions.end()), std::back_inserter(*list));
+
+        // Drop duplicates, which are always within a run of equal precedence. Merge keeps already
+        // published versions first in each run, so those are the ones retained.
+        auto out = list->begin();
+        for (auto run = list->begin(); run != list->end();) {
+            auto run_end = std::upper_bound(run, list->end(), *run);
+            auto kept = out;
+            for (auto it = run; it != run_end; ++it) {
+                if (std::none_of(kept, out, [&](const Version& v) { return same_version(v, *it); })) {
+                    if (out != it) *out = std::move(*it);
+                    ++out;
+                }
+            }
+            run = run_end;
+        }
+        list->erase(out, list->end());
+
+        size_t added = list->size() - current->size();
+        replace_locked(p, list.release());
+        return added;
+    }
+
+    Registry::Snapshot Registry::Read() const {
+        return Snapshot(*this);
+    }
+
+    Registry::Snapshot::Snapshot(const Registry& registry)
+            : registry_(registry), guard_(registry.domain_) {}
+
+    const Version* Registry::Snapshot::Latest(const std::string& package, bool prerelease) const {
+        const Versions* list = registry_.find(package);
+        if (!list) return nullptr;
+        return last_matching(list->data(), list->data() + list->size(), prerelease);
+    }
+
+    const Version* Registry::Snapshot::LatestInMajor(const std::string& package, int major, bool prerelease) const {
+        const Versions* list = registry_.find(package);
+        if (!list || major < 0) return nullptr;
+        // Major version never decreases along the list, so versions up to given major one form its prefix.
+        const Version* first = list->data();
+        const Version* last = std::partition_point(first, list->data() + list->size(),
+                                                   [major](const Version& v) { return v.Major() <= major; });
+        const Version* v = last_matching(first, last, prerelease);
+        return v && v->Major() == major ? v : nullptr;
+    }
+
+    VersionRange Registry::Snapshot::Range(const std::string& package, const Version& low, const Version& high) const {
+        const Versions* list = registry_.find(package);
+        if (!list) return VersionRange{ nullptr, nullptr };
+        const Version* first = std::lower_bound(list->data(), list->data() + list->size(), low);
+        const Version* last = std::lower_bound(first, list->data() + list->size(), high);
+        return VersionRange{ first, std::max(first, last) };
+    }
+
+    VersionRange Registry::Snapshot::All(const std::string& package) const {
+        const Versions* list = registry_.find(package);
+        if (!list) return VersionRange{ nullptr, nullptr };
+        return VersionRange{ list->data(), list->data() + list->size() };
+    }
+}}
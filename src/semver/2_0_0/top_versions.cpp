@@ -0,0 +1,114 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <utility>
+#include "versioning/semver/2_0_0/top_versions.h"
+
+namespace vsn { namespace semver {
+namespace {
+    // Compare major, minor and patch of version to those given.
+    inline int compare_core(const VersionData& v, const int* core) {
+        if (v.major != core[0]) return v.major < core[0] ? -1 : 1;
+        if (v.minor != core[1]) return v.minor < core[1] ? -1 : 1;
+        if (v.patch != core[2]) return v.patch < core[2] ? -1 : 1;
+        return 0;
+    }
+}
+
+    TopVersions::TopVersions(const size_t k, const bool prerelease, const bool unique)
+            : k_{ k }, prerelease_{ prerelease }, unique_{ unique }, threshold_{ 0, 0, 0 } {
+        heap_.reserve(k);
+    }
+
+    bool TopVersions::admit(const VersionData& v) const {
+        if (k_ == 0 || (!prerelease_ && !v.prerelease_ids.empty())) return false;
+        if (heap_.size() == k_) {
+            const int cmp = compare_core(v, threshold_);
+            if (cmp < 0) return false;
+            if (cmp == 0 && comparator_.Compare(v, heap_.front()) <= 0) return false;
+        }
+        if (unique_) {
+            const int core[] = { v.major, v.minor, v.patch };
+            for (const auto& kept : heap_) {
+                if (compare_core(kept, core) == 0 && comparator_.Compare(kept, v) == 0) return false;
+            }
+        }
+        return true;
+    }
+
+    void TopVersions::push(VersionData&& v) {
+        const auto newer = [this](const VersionData& l, const VersionData& r) {
+            return comparator_.Compare(l, r) > 0;
+        };
+        if (heap_.size() == k_) {
+            std::pop_heap(heap_.begin(), heap_.end(), newer);
+            heap_.back() = std::move(v);
+        }
+        else {
+            heap_.push_back(std::move(v));
+        }
+        std::push_heap(heap_.begin(), heap_.end(), newer);
+        if (heap_.size() == k_) update_threshold();
+    }
+
+    void TopVersions::update_threshold() {
+        const auto& top = heap_.front();
+        threshold_[0] = top.major;
+        threshold_[1] = top.minor;
+        threshold_[2] = top.patch;
+    }
+
+    bool TopVersions::Add(const VersionData& v) {
+        if (!admit(v)) return false;
+        push(VersionData(v));
+        return true;
+    }
+
+    bool TopVersions::Add(VersionData&& v) {
+        if (!admit(v)) return false;
+        push(std::move(v));
+        return true;
+    }
+
+    void TopVersions::Merge(const TopVersions& other) {
+        // Selector already holds all its versions; adding them would also grow the heap being iterated.
+        if (&other == this) return;
+        for (const auto& v : other.heap_) Add(v);
+    }
+
+    void TopVersions::Merge(TopVersions&& other) {
+        if (&other == this) return;
+        for (auto& v : other.heap_) Add(std::move(v));
+        other.heap_.clear();
+    }
+
+    std::vector<VersionData> TopVersions::Result() const {
+        std::vector<VersionData> res = heap_;
+        std::sort(res.begin(), res.end(), [this](const VersionData& l, const VersionData& r) {
+            return comparator_.Compare(l, r) > 0;
+        });
+        return res;
+    }
+}}
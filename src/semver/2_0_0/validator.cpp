@@ -0,0 +1,122 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <versioning/worker_threads.h>
+#include "versioning/semver/2_0_0/validator.h"
+
+namespace vsn { namespace semver {
+    // Inputs smaller than these are not worth spawning a thread for.
+    const size_t min_items_per_thread = 2048;
+    const size_t min_bytes_per_thread = 65536;
+
+    BulkValidator::BulkValidator(unsigned threads, size_t max_samples)
+            : threads_{ threads ? threads : std::thread::hardware_concurrency() }, max_samples_{ max_samples } {
+        if (threads_ == 0) threads_ = 1;
+    }
+
+    // Let every worker check its part into a report of its own, with positions relative to the part, and combine
+    // reports in part order. check_part(w, workers, report) returns the number of positions the part spans.
+    template<typename F>
+    ValidationReport BulkValidator::run(const size_t workers, F check_part) const {
+        std::vector<ValidationReport> parts(workers);
+        std::vector<size_t> spans(workers);
+        auto work = [&](size_t w) { spans[w] = check_part(w, workers, parts[w]); };
+
+        run_workers(workers, work);
+
+        ValidationReport res;
+        size_t base = 0;
+        for (size_t w = 0; w < workers; ++w) {
+            const auto& part = parts[w];
+            res.checked += part.checked;
+            res.invalid += part.invalid;
+            for (size_t r = 0; r < parse_error_reason_count; ++r) {
+                res.counts[r] += part.counts[r];
+                for (size_t i = 0; i < part.samples[r].size() && res.samples[r].size() < max_samples_; ++i) {
+                    res.samples[r].push_back(base + part.samples[r][i]);
+                }
+            }
+            base += spans[w];
+        }
+        return res;
+    }
+
+    ValidationReport BulkValidator::Validate(const std::string* in, const size_t n) const {
+        const size_t workers = std::min<size_t>(threads_, std::max<size_t>(1, n / min_items_per_thread));
+        const size_t max_samples = max_samples_;
+        const Parser& parser = parser_;
+        return run(workers, [=, &parser](size_t w, size_t workers, ValidationReport& report) {
+            const size_t first = n * w / workers;
+            const size_t last = n * (w + 1) / workers;
+            ParseErrorReason reason;
+            for (size_t i = first; i < last; ++i) {
+                if (parser.IsValid(in[i].data(), in[i].size(), reason)) continue;
+                const auto r = static_cast<size_t>(reason);
+                ++report.invalid;
+                if (report.counts[r]++ < max_samples) report.samples[r].push_back(i - first);
+            }
+            report.checked = last - first;
+            return last - first;
+        });
+    }
+
+    ValidationReport BulkValidator::Validate(const char* text, const size_t size) const {
+        const size_t workers = std::min<size_t>(threads_, std::max<size_t>(1, size / min_bytes_per_thread));
+        const size_t max_samples = max_samples_;
+        const Parser& parser = parser_;
+        const char* end = text + size;
+        // Every part starts at the beginning of a line; its first line belongs to the previous part otherwise.
+        auto line_start = [=](size_t w, size_t workers) {
+            if (w == 0) return text;
+            if (w == workers) return end;
+            const char* p = text + size * w / workers - 1;
+            const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+            return nl ? static_cast<const char*>(nl) + 1 : end;
+        };
+        return run(workers, [=, &parser](size_t w, size_t workers, ValidationReport& report) {
+            const char* last = line_start(w + 1, workers);
+            size_t line = 0;
+            ParseErrorReason reason;
+            for (const char* p = line_start(w, workers); p < last; ++line) {
+                const void* nl = std::memchr(p, '\n', static_cast<size_t>(last - p));
+                const char* eol = nl ? static_cast<const char*>(nl) : last;
+                const char* next = nl ? eol + 1 : last;
+                if (eol != p && eol[-1] == '\r') --eol;
+                if (eol != p) {
+                    ++report.checked;
+                    if (!parser.IsValid(p, static_cast<size_t>(eol - p), reason)) {
+                        const auto r = static_cast<size_t>(reason);
+                        ++report.invalid;
+                        if (report.counts[r]++ < max_samples) report.samples[r].push_back(line);
+                    }
+                }
+                p = next;
+            }
+            return line;
+        });
+    }
+}}
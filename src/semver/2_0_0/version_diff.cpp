@@ -0,0 +1,74 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "versioning/semver/2_0_0/comparator.h"
+#include "versioning/semver/2_0_0/version_diff.h"
+
+namespace vsn { namespace semver {
+namespace {
+    // Classify change by major, minor and patch alone; ties are reported as none, to be resolved by identifiers.
+    inline VersionDiff diff_core(const VersionData& from, const VersionData& to) {
+        const int major = (to.major > from.major) - (to.major < from.major);
+        const int minor = (to.minor > from.minor) - (to.minor < from.minor);
+        const int patch = (to.patch > from.patch) - (to.patch < from.patch);
+        const int sign = major ? major : minor ? minor : patch;
+        const VersionDiff upgrade = major ? VersionDiff::major : minor ? VersionDiff::minor : VersionDiff::patch;
+        return sign > 0 ? upgrade : sign < 0 ? VersionDiff::downgrade : VersionDiff::none;
+    }
+
+    // Classify change of versions tied in major, minor and patch.
+    inline VersionDiff diff_identifiers(const Comparator& comparator, const VersionData& from, const VersionData& to) {
+        const int cmp = comparator.Compare(from, to);
+        if (cmp < 0) return VersionDiff::prerelease;
+        if (cmp > 0) return VersionDiff::downgrade;
+        return from.build_ids == to.build_ids ? VersionDiff::none : VersionDiff::build;
+    }
+}
+
+    const char* ToString(const VersionDiff diff) {
+        switch (diff) {
+            case VersionDiff::none: return "none";
+            case VersionDiff::major: return "major";
+            case VersionDiff::minor: return "minor";
+            case VersionDiff::patch: return "patch";
+            case VersionDiff::prerelease: return "prerelease";
+            case VersionDiff::build: return "build";
+            case VersionDiff::downgrade: return "downgrade";
+        }
+        return "unknown";
+    }
+
+    VersionDiff Diff(const VersionData& from, const VersionData& to) {
+        const VersionDiff diff = diff_core(from, to);
+        return diff == VersionDiff::none ? diff_identifiers(Comparator(), from, to) : diff;
+    }
+
+    void Diff(const VersionData* from, const VersionData* to, const size_t n, VersionDiff* out) {
+        for (size_t i = 0; i < n; ++i) out[i] = diff_core(from[i], to[i]);
+        const Comparator comparator;
+        for (size_t i = 0; i < n; ++i) {
+            if (out[i] == VersionDiff::none) out[i] = diff_identifiers(comparator, from[i], to[i]);
+        }
+    }
+}}
@@ -0,0 +1,218 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include "../../canonical.h"
+#include "../../exceptions.h"
+#include "versioning/semver/2_0_0/version_filter.h"
+
+namespace vsn { namespace semver {
+namespace {
+    const char filter_magic[8] = { 'V', 'S', 'N', 'B', 'L', 'O', 'O', 'M' };
+    const uint32_t filter_format_version = 1;
+    const uint32_t byte_order_mark = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t format_version;
+        uint32_t byte_order;
+        uint64_t block_count;
+        uint64_t key_count;
+    };
+
+    // Odd multipliers picking one bit per block word from the key.
+    const uint32_t salts[8] = { 0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U };
+
+    // Number of probes whose blocks are prefetched ahead.
+    const size_t prefetch_distance = 8;
+
+    [[noreturn]] void invalid(const char* message) {
+        throw ParseError(ParseErrorReason::other, std::string("invalid version filter: ") + message);
+    }
+
+    uint64_t hash_canonical(const std::string& package, const char* version, const size_t size) {
+        return hash_bytes(version, size, hash_bytes(package.data(), package.size()));
+    }
+}
+
+    VersionFilter::VersionFilter() : VersionFilter(1, 0) {}
+
+    VersionFilter::VersionFilter(const size_t block_count, const size_t key_count)
+            : words_((block_count + 1) * block_words), block_count_{ block_count }, key_count_{ key_count } {
+        // Align blocks to their size, so no block straddles cache lines.
+        const auto address = reinterpret_cast<uintptr_t>(words_.data());
+        const size_t block_bytes = block_words * sizeof(uint32_t);
+        offset_ = (block_bytes - address % block_bytes) % block_bytes / sizeof(uint32_t);
+    }
+
+    // Alignment offset depends on address of the storage, so it is computed anew rather than copied.
+    VersionFilter::VersionFilter(const VersionFilter& other) : VersionFilter(other.block_count_, other.key_count_) {
+        std::memcpy(blocks(), other.blocks(), Bytes());
+    }
+
+    VersionFilter& VersionFilter::operator=(const VersionFilter& other) {
+        if (this != &other) *this = VersionFilter(other);
+        return *this;
+    }
+
+    uint64_t VersionFilter::Hash(const std::string& package, const VersionData& version) {
+        std::string canonical;
+        append_canonical(canonical, version, false);
+        return hash_canonical(package, canonical.data(), canonical.size());
+    }
+
+    // Valid text is canonical already, up to build metadata.
+    bool VersionFilter::Hash(const std::string& package, const char* version, const size_t size, uint64_t& hash) {
+        const char* first = version;
+        const char* last = version + size;
+        trim(first, last);
+        if (!Parser().IsValid(first, static_cast<size_t>(last - first))) return false;
+        const void* plus = std::memchr(first, '+', static_cast<size_t>(last - first));
+        if (plus) last = static_cast<const char*>(plus);
+        hash = hash_canonical(package, first, static_cast<size_t>(last - first));
+        return true;
+    }
+
+    // Pick block by high half of hash, mapped to [0, block_count) without division.
+    size_t VersionFilter::block_of(const uint64_t hash) const {
+        return static_cast<size_t>((hash >> 32) * block_count_ >> 32) * block_words;
+    }
+
+    void VersionFilter::insert(const uint64_t hash) {
+        uint32_t* block = blocks() + block_of(hash);
+        const auto key = static_cast<uint32_t>(hash);
+        for (size_t i = 0; i < block_words; ++i) block[i] |= uint32_t{ 1 } << ((key * salts[i]) >> 27);
+    }
+
+    bool VersionFilter::MayContain(const uint64_t hash) const {
+        const uint32_t* block = blocks() + block_of(hash);
+        const auto key = static_cast<uint32_t>(hash);
+        uint32_t found = 1;
+        for (size_t i = 0; i < block_words; ++i) found &= block[i] >> ((key * salts[i]) >> 27);
+        return found != 0;
+    }
+
+    void VersionFilter::MayContain(const uint64_t* hashes, const size_t n, bool* out) const {
+        for (size_t i = 0; i < n; ++i) {
+#if defined(__GNUC__) || defined(__clang__)
+            if (i + prefetch_distance < n) __builtin_prefetch(blocks() + block_of(hashes[i + prefetch_distance]));
+#endif
+            out[i] = MayContain(hashes[i]);
+        }
+    }
+
+    bool VersionFilter::MayContain(const std::string& package, const VersionData& version) const {
+        return MayContain(Hash(package, version));
+    }
+
+    bool VersionFilter::MayContain(const std::string& package, const std::string& version) const {
+        uint64_t hash;
+        return Hash(package, version.data(), version.size(), hash) && MayContain(hash);
+    }
+
+    std::vector<uint8_t> VersionFilter::Serialize() const {
+        Header h;
+        std::memcpy(h.magic, filter_magic, sizeof(filter_magic));
+        h.format_version = filter_format_version;
+        h.byte_order = byte_order_mark;
+        h.block_count = block_count_;
+        h.key_count = key_count_;
+        std::vector<uint8_t> out(sizeof(Header) + Bytes());
+        std::memcpy(out.data(), &h, sizeof(Header));
+        std::memcpy(out.data() + sizeof(Header), blocks(), Bytes());
+        return out;
+    }
+
+    VersionFilter VersionFilter::Deserialize(const uint8_t* data, const size_t size) {
+        if (size < sizeof(Header)) invalid("data is truncated");
+        Header h;
+        std::memcpy(&h, data, sizeof(Header));
+        if (std::memcmp(h.magic, filter_magic, sizeof(filter_magic)) != 0) invalid("bad magic");
+        if (h.format_version != filter_format_version) invalid("unsupported format version");
+        if (h.byte_order != byte_order_mark) invalid("written on a machine of different byte order");
+        const size_t block_bytes = block_words * sizeof(uint32_t);
+        if (h.block_count == 0 || h.block_count > (size - sizeof(Header)) / block_bytes ||
+            sizeof(Header) + h.block_count * block_bytes != size) {
+            invalid("size does not match block count");
+        }
+        VersionFilter res(static_cast<size_t>(h.block_count), static_cast<size_t>(h.key_count));
+        std::memcpy(res.blocks(), data + sizeof(Header), res.Bytes());
+        return res;
+    }
+
+    void VersionFilter::Write(const std::string& path) const {
+        const auto bytes = Serialize();
+        FILE* f = std::fopen(path.c_str(), "wb");
+        if (!f) throw std::system_error(errno, std::generic_category(), "cannot create " + path);
+        const bool written = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+        if (std::fclose(f) != 0 || !written) {
+            throw std::system_error(errno, std::generic_category(), "cannot write " + path);
+        }
+    }
+
+    VersionFilter VersionFilter::Read(const std::string& path) {
+        FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+        std::vector<uint8_t> bytes;
+        uint8_t buf[65536];
+        size_t n;
+        while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) bytes.insert(bytes.end(), buf, buf + n);
+        const bool failed = std::ferror(f) != 0;
+        std::fclose(f);
+        if (failed) throw std::system_error(EIO, std::generic_category(), "cannot read " + path);
+        return Deserialize(bytes.data(), bytes.size());
+    }
+
+    void VersionFilterBuilder::Add(const std::string& package, const VersionData& version) {
+        hashes_.push_back(VersionFilter::Hash(package, version));
+    }
+
+    void VersionFilterBuilder::Add(const std::string& package, const std::string& version) {
+        uint64_t hash;
+        if (!VersionFilter::Hash(package, version.data(), version.size(), hash)) {
+            const char* first = version.data();
+            const char* last = first + version.size();
+            trim(first, last);
+            Parser().Parse(std::string(first, last)); // throws with the reason text is invalid
+        }
+        hashes_.push_back(hash);
+    }
+
+    void VersionFilterBuilder::Add(const std::vector<PackageVersion>& versions) {
+        hashes_.reserve(hashes_.size() + versions.size());
+        for (const auto& v : versions) Add(v.package, v.version);
+    }
+
+    VersionFilter VersionFilterBuilder::Build(const double bits_per_key) const {
+        const double bits = std::ceil(static_cast<double>(hashes_.size()) * bits_per_key / 256);
+        VersionFilter res(bits < 1 ? 1 : static_cast<size_t>(bits), hashes_.size());
+        for (const uint64_t hash : hashes_) res.insert(hash);
+        return res;
+    }
+}}
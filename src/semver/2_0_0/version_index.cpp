@@ -0,0 +1,346 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include <versioning/semver/2_0_0/parser.h>
+#include "../../exceptions.h"
+#include "versioning/semver/2_0_0/version_index.h"
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vsn { namespace semver {
+namespace {
+    const char index_magic[8] = { 'V', 'S', 'N', 'I', 'N', 'D', 'E', 'X' };
+    const uint32_t index_format_version = 1;
+    const uint32_t byte_order_mark = 0x01020304;
+
+    struct Header {
+        char magic[8];
+        uint32_t format_version;
+        uint32_t byte_order;
+        uint64_t file_size;
+        uint64_t package_count;
+        uint64_t version_count;
+        uint64_t packages_offset;
+        uint64_t versions_offset;
+        uint64_t data_offset;
+    };
+
+    struct PackageRecord {
+        uint64_t name_offset;
+        uint64_t name_size;
+        uint64_t first_version;
+        uint64_t version_count;
+    };
+
+    struct VersionRecord {
+        uint64_t offset; ///< Offset of key, followed by text.
+        uint32_t key_size;
+        uint32_t text_size;
+        int32_t major;
+        uint32_t flags;
+    };
+
+    const uint32_t prerelease_flag = 1;
+
+    [[noreturn]] void corrupt(const char* message) {
+        throw ParseError(ParseErrorReason::other, std::string("invalid version index: ") + message);
+    }
+
+    // Records are copied out of the file, so index data needs no particular alignment.
+    template<typename T>
+    T read(const uint8_t* p) {
+        T t;
+        std::memcpy(&t, p, sizeof(T));
+        return t;
+    }
+
+    VersionRecord record(const uint8_t* versions, size_t i) {
+        return read<VersionRecord>(versions + i * sizeof(VersionRecord));
+    }
+
+    template<typename T>
+    void write(std::vector<uint8_t>& out, size_t at, const T& t) {
+        std::memcpy(out.data() + at, &t, sizeof(T));
+    }
+}
+
+    IndexedVersion IndexRange::operator[](size_t i) const {
+        return index_->version_at(first_ + i);
+    }
+
+    VersionIndex::VersionIndex(const std::string& path) : data_{ nullptr }, size_{ 0 }, mapping_{ nullptr } {
+#if defined(_WIN32)
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        attach(buffer_.data(), buffer_.size());
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "cannot open " + path);
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "cannot stat " + path);
+        }
+        const size_t size = static_cast<size_t>(st.st_size);
+        void* p = size ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : nullptr;
+        const int error = errno;
+        ::close(fd);
+        if (p == MAP_FAILED) throw std::system_error(error, std::generic_category(), "cannot map " + path);
+        mapping_ = p;
+        try {
+            attach(p, size);
+        } catch (...) {
+            if (mapping_) ::munmap(mapping_, size);
+            throw;
+        }
+#endif
+    }
+
+    VersionIndex::VersionIndex(const void* data, const size_t size) : data_{ nullptr }, size_{ 0 }, mapping_{ nullptr } {
+        attach(data, size);
+    }
+
+    VersionIndex::~VersionIndex() {
+#if !defined(_WIN32)
+        if (mapping_) ::munmap(mapping_, size_);
+#endif
+    }
+
+    // Check header and table bounds; records themselves are checked as they are read.
+    void VersionIndex::attach(const void* data, const size_t size) {
+        data_ = static_cast<const uint8_t*>(data);
+        size_ = size;
+        if (size < sizeof(Header)) corrupt("file is truncated");
+        const auto h = read<Header>(data_);
+        if (std::memcmp(h.magic, index_magic, sizeof(index_magic)) != 0) corrupt("bad magic");
+        if (h.format_version != index_format_version) corrupt("unsupported format version");
+        if (h.byte_order != byte_order_mark) corrupt("written on a machine of different byte order");
+        if (h.file_size != size) corrupt("file is truncated");
+        if (h.packages_offset > size || h.package_count > (size - h.packages_offset) / sizeof(PackageRecord)) {
+            corrupt("package table out of bounds");
+        }
+        if (h.versions_offset > size || h.version_count > (size - h.versions_offset) / sizeof(VersionRecord)) {
+            corrupt("version table out of bounds");
+        }
+        package_count_ = static_cast<size_t>(h.package_count);
+        version_count_ = static_cast<size_t>(h.version_count);
+        packages_ = data_ + h.packages_offset;
+        versions_ = data_ + h.versions_offset;
+    }
+
+    IndexedVersion VersionIndex::version_at(const size_t i) const {
+        const auto r = record(versions_, i);
+        if (r.offset > size_ || uint64_t{ r.key_size } + r.text_size > size_ - r.offset) {
+            corrupt("version out of bounds");
+        }
+        const uint8_t* key = data_ + r.offset;
+        return IndexedVersion(key, r.key_size, reinterpret_cast<const char*>(key + r.key_size), r.text_size);
+    }
+
+    IndexRange VersionIndex::package_versions(const std::string& package) const {
+        size_t low = 0, high = package_count_;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            const auto p = read<PackageRecord>(packages_ + mid * sizeof(PackageRecord));
+            if (p.name_offset > size_ || p.name_size > size_ - p.name_offset) corrupt("package name out of bounds");
+            const int cmp = package.compare(0, std::string::npos, reinterpret_cast<const char*>(data_ + p.name_offset),
+                                            static_cast<size_t>(p.name_size));
+            if (cmp > 0) low = mid + 1;
+            else if (cmp < 0) high = mid;
+            else {
+                if (p.first_version > version_count_ || p.version_count > version_count_ - p.first_version) {
+                    corrupt("package versions out of bounds");
+                }
+                return IndexRange(this, static_cast<size_t>(p.first_version),
+                                  static_cast<size_t>(p.first_version + p.version_count));
+            }
+        }
+        return IndexRange();
+    }
+
+    size_t VersionIndex::lower_bound(const IndexRange& versions, const std::vector<uint8_t>& key) const {
+        const WireVersion target(key.data(), key.size());
+        size_t low = versions.first_, high = versions.last_;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            if (version_at(mid).Key() < target) low = mid + 1;
+            else high = mid;
+        }
+        return low;
+    }
+
+    IndexedVersion VersionIndex::Latest(const std::string& package, const bool prerelease) const {
+        const auto versions = package_versions(package);
+        for (size_t i = versions.last_; i > versions.first_; --i) {
+            if (prerelease || !(record(versions_, i - 1).flags & prerelease_flag)) return version_at(i - 1);
+        }
+        return IndexedVersion();
+    }
+
+    IndexedVersion VersionIndex::LatestInMajor(const std::string& package, const int major,
+                                               const bool prerelease) const {
+        const auto versions = package_versions(package);
+        // Versions are sorted by precedence, so by major version first.
+        size_t low = versions.first_, high = versions.last_;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            if (record(versions_, mid).major <= major) low = mid + 1;
+            else high = mid;
+        }
+        for (size_t i = low; i > versions.first_; --i) {
+            const auto r = record(versions_, i - 1);
+            if (r.major != major) break;
+            if (prerelease || !(r.flags & prerelease_flag)) return version_at(i - 1);
+        }
+        return IndexedVersion();
+    }
+
+    IndexRange VersionIndex::Range(const std::string& package, const VersionData& low, const VersionData& high) const {
+        const auto versions = package_versions(package);
+        if (versions.empty()) return versions;
+        const size_t first = lower_bound(versions, Encode(low));
+        const size_t last = std::max(first, lower_bound(versions, Encode(high)));
+        return IndexRange(this, first, last);
+    }
+
+    IndexRange VersionIndex::All(const std::string& package) const {
+        return package_versions(package);
+    }
+
+    IndexedVersion VersionIndex::Find(const std::string& package, const std::string& version) const {
+        const auto versions = package_versions(package);
+        if (versions.empty()) return IndexedVersion();
+        std::vector<uint8_t> key;
+        try {
+            key = Encode(Parser().Parse(version));
+        } catch (const ParseError&) {
+            return IndexedVersion();
+        }
+        // Versions of equal precedence differ in build metadata only; look for the one with the same text.
+        const WireVersion target(key.data(), key.size());
+        for (size_t i = lower_bound(versions, key); i < versions.last_; ++i) {
+            const auto v = version_at(i);
+            if (v.Key() != target) break;
+            if (v.TextSize() == version.size() && std::memcmp(v.TextData(), version.data(), version.size()) == 0) {
+                return v;
+            }
+        }
+        return IndexedVersion();
+    }
+
+    void VersionIndexBuilder::Add(const std::string& package, const std::string& version) {
+        items_.push_back(Item{ PackageVersion{ package, Parser().Parse(version) }, version });
+    }
+
+    std::vector<uint8_t> VersionIndexBuilder::Build() {
+        const VersionOrder order(BuildMetadata::distinct);
+        std::sort(items_.begin(), items_.end(), [&order](const Item& l, const Item& r) {
+            const int cmp = order.Compare(l.version, r.version);
+            return cmp < 0 || (cmp == 0 && l.text < r.text);
+        });
+        items_.erase(std::unique(items_.begin(), items_.end(), [](const Item& l, const Item& r) {
+            return l.version.package == r.version.package && l.text == r.text;
+        }), items_.end());
+
+        size_t package_count = 0;
+        for (size_t i = 0; i < items_.size(); ++i) {
+            package_count += i == 0 || items_[i].version.package != items_[i - 1].version.package;
+        }
+
+        Header h;
+        std::memcpy(h.magic, index_magic, sizeof(index_magic));
+        h.format_version = index_format_version;
+        h.byte_order = byte_order_mark;
+        h.package_count = package_count;
+        h.version_count = items_.size();
+        h.packages_offset = sizeof(Header);
+        h.versions_offset = h.packages_offset + package_count * sizeof(PackageRecord);
+        h.data_offset = h.versions_offset + items_.size() * sizeof(VersionRecord);
+
+        std::vector<uint8_t> out(static_cast<size_t>(h.data_offset));
+        size_t package = 0;
+        for (size_t i = 0; i < items_.size(); ++i) {
+            const auto& item = items_[i];
+            if (i == 0 || item.version.package != items_[i - 1].version.package) {
+                size_t count = 1;
+                while (i + count < items_.size() && items_[i + count].version.package == item.version.package) {
+                    ++count;
+                }
+                const PackageRecord p{ out.size(), item.version.package.size(), i, count };
+                write(out, static_cast<size_t>(h.packages_offset) + package++ * sizeof(PackageRecord), p);
+                out.insert(out.end(), item.version.package.begin(), item.version.package.end());
+            }
+
+            VersionRecord r;
+            r.offset = out.size();
+            Encode(item.version.version, out);
+            r.key_size = static_cast<uint32_t>(out.size() - r.offset);
+            r.text_size = static_cast<uint32_t>(item.text.size());
+            r.major = item.version.version.major;
+            r.flags = item.version.version.prerelease_ids.empty() ? 0 : prerelease_flag;
+            out.insert(out.end(), item.text.begin(), item.text.end());
+            write(out, static_cast<size_t>(h.versions_offset) + i * sizeof(VersionRecord), r);
+        }
+
+        h.file_size = out.size();
+        write(out, 0, h);
+        return out;
+    }
+
+    void VersionIndexBuilder::Write(const std::string& path) {
+        const auto bytes = Build();
+        const std::string temp = path + ".tmp";
+        FILE* f = std::fopen(temp.c_str(), "wb");
+        if (!f) throw std::system_error(errno, std::generic_category(), "cannot create " + temp);
+        const bool written = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+        if (std::fclose(f) != 0 || !written) {
+            const int error = errno;
+            std::remove(temp.c_str());
+            throw std::system_error(error, std::generic_category(), "cannot write " + temp);
+        }
+#if defined(_WIN32)
+        std::remove(path.c_str());
+#endif
+        if (std::rename(temp.c_str(), path.c_str()) != 0) {
+            const int error = errno;
+            std::remove(temp.c_str());
+            throw std::system_error(error, std::generic_category(), "cannot replace " + path);
+        }
+    }
+}}
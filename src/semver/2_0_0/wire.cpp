@@ -0,0 +1,270 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <climits>
+#include <cstring>
+#include "../../char_classes.h"
+#include "../../exceptions.h"
+#include "../../varint.h"
+#include "versioning/semver/2_0_0/wire.h"
+
+namespace vsn { namespace semver {
+namespace {
+    // Longest varint accepted; encodes any 32-bit value.
+    const int max_varint_bytes = 5;
+
+    // Positions of encoded version parts, relative to its first byte.
+    struct Layout {
+        size_t size;
+        int major;
+        int minor;
+        int patch;
+        size_t prerelease_count;
+        size_t build_count;
+        size_t bitmap_offset;
+        size_t prerelease_offset;
+    };
+
+    [[noreturn]] void fail(ParseErrorReason reason, const char* message) {
+        throw ParseError(reason, message);
+    }
+
+    [[noreturn]] void truncated() {
+        fail(ParseErrorReason::missing_component, "encoded version is truncated");
+    }
+
+    inline uint64_t read_varint(const uint8_t*& p, const uint8_t* end) {
+        if (p != end && *p < 0x80) return *p++; // most numbers and lengths take one byte
+        uint64_t v = 0;
+        for (int i = 0; i < max_varint_bytes; ++i) {
+            if (p == end) truncated();
+            const uint8_t b = *p++;
+            v |= static_cast<uint64_t>(b & 0x7f) << (7 * i);
+            if (!(b & 0x80)) return v;
+        }
+        fail(ParseErrorReason::overflow, "encoded number out of range");
+    }
+
+    inline int read_component(const uint8_t*& p, const uint8_t* end) {
+        const uint64_t v = read_varint(p, end);
+        if (v > INT_MAX) fail(ParseErrorReason::overflow, "version number out of range");
+        return static_cast<int>(v);
+    }
+
+    // Read count of items taking at least one byte each, so corrupt counts are rejected before anything is reserved.
+    inline size_t read_count(const uint8_t*& p, const uint8_t* end) {
+        const uint64_t v = read_varint(p, end);
+        if (v > static_cast<uint64_t>(end - p)) truncated();
+        return static_cast<size_t>(v);
+    }
+
+    // Read and validate one identifier; numeric is its type according to bitmap, for prerelease identifiers.
+    inline void read_identifier(const uint8_t*& p, const uint8_t* end, const bool prerelease, const bool numeric,
+                         const uint8_t*& first, size_t& length) {
+        length = read_count(p, end);
+        if (length == 0) fail(ParseErrorReason::empty_identifier, "version identifier cannot be empty");
+        first = p;
+        uint8_t all = CharClasses::identifier_char | CharClasses::digit;
+        for (const uint8_t* last = p + length; p != last; ++p) all &= char_classes.of[*p];
+        if (!(all & CharClasses::identifier_char)) {
+            fail(ParseErrorReason::invalid_character, "invalid character encountered");
+        }
+        if (!prerelease) return;
+        if (!(all & CharClasses::digit) == numeric) {
+            fail(ParseErrorReason::other, "identifier type does not match its value");
+        }
+        if (numeric && length > 1 && *first == '0') {
+            fail(ParseErrorReason::leading_zero, "numeric identifiers cannot have leading 0");
+        }
+    }
+
+    // Validate version encoded at data, storing its layout and, unless out is null, its parts; identifiers are
+    // assigned over existing ones in out, reusing their storage.
+    void scan(const uint8_t* data, const uint8_t* end, Layout& layout, VersionData* out) {
+        const uint8_t* p = data;
+        if (p == end) truncated();
+        if (*p++ != wire_format_version) fail(ParseErrorReason::other, "unsupported encoding format version");
+        layout.major = read_component(p, end);
+        layout.minor = read_component(p, end);
+        layout.patch = read_component(p, end);
+
+        const size_t pr_count = read_count(p, end);
+        const uint8_t* bitmap = p;
+        const size_t bitmap_size = (pr_count + 7) / 8;
+        if (bitmap_size > static_cast<size_t>(end - p)) truncated();
+        if (pr_count % 8 && bitmap[bitmap_size - 1] >> (pr_count % 8)) {
+            fail(ParseErrorReason::other, "unused identifier type bits must be 0");
+        }
+        p += bitmap_size;
+        layout.prerelease_count = pr_count;
+        layout.bitmap_offset = static_cast<size_t>(bitmap - data);
+        layout.prerelease_offset = static_cast<size_t>(p - data);
+
+        const uint8_t* first;
+        size_t length;
+        if (out) out->prerelease_ids.resize(pr_count);
+        for (size_t i = 0; i < pr_count; ++i) {
+            const bool numeric = (bitmap[i / 8] >> (i % 8)) & 1;
+            read_identifier(p, end, true, numeric, first, length);
+            if (out) {
+                out->prerelease_ids[i].first.assign(reinterpret_cast<const char*>(first), length);
+                out->prerelease_ids[i].second = numeric ? Id_type::num : Id_type::alnum;
+            }
+        }
+
+        const size_t b_count = read_count(p, end);
+        layout.build_count = b_count;
+        if (out) out->build_ids.resize(b_count);
+        for (size_t i = 0; i < b_count; ++i) {
+            read_identifier(p, end, false, false, first, length);
+            if (out) out->build_ids[i].assign(reinterpret_cast<const char*>(first), length);
+        }
+        layout.size = static_cast<size_t>(p - data);
+
+        if (out) {
+            out->major = layout.major;
+            out->minor = layout.minor;
+            out->patch = layout.patch;
+        }
+    }
+
+    // Compare numeric identifiers without leading zeros: the longer one is higher, equally long ones compare as text.
+    inline int cmp_num(const uint8_t* l, const size_t llen, const uint8_t* r, const size_t rlen) {
+        if (llen != rlen) return llen > rlen ? 1 : -1;
+        const int cmp = std::memcmp(l, r, llen);
+        if (cmp == 0) return 0;
+        return cmp > 0 ? 1 : -1;
+    }
+
+    inline int cmp_alnum(const uint8_t* l, const size_t llen, const uint8_t* r, const size_t rlen) {
+        const int cmp = std::memcmp(l, r, llen < rlen ? llen : rlen);
+        if (cmp != 0) return cmp > 0 ? 1 : -1;
+        if (llen == rlen) return 0;
+        return llen > rlen ? 1 : -1;
+    }
+}
+
+    void Encode(const VersionData& v, std::vector<uint8_t>& out) {
+        const size_t pr_count = v.prerelease_ids.size();
+        size_t size = 1 + 3 * max_varint_bytes + 2 * max_varint_bytes + (pr_count + 7) / 8;
+        for (const auto& id : v.prerelease_ids) size += max_varint_bytes + id.first.size();
+        for (const auto& id : v.build_ids) size += max_varint_bytes + id.size();
+        out.reserve(out.size() + size);
+
+        out.push_back(wire_format_version);
+        put_varint(out, static_cast<uint32_t>(v.major));
+        put_varint(out, static_cast<uint32_t>(v.minor));
+        put_varint(out, static_cast<uint32_t>(v.patch));
+
+        put_varint(out, pr_count);
+        const size_t bitmap = out.size();
+        out.resize(out.size() + (pr_count + 7) / 8, 0);
+        for (size_t i = 0; i < pr_count; ++i) {
+            if (v.prerelease_ids[i].second == Id_type::num) out[bitmap + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        }
+        for (const auto& id : v.prerelease_ids) {
+            put_varint(out, id.first.size());
+            out.insert(out.end(), id.first.begin(), id.first.end());
+        }
+
+        put_varint(out, v.build_ids.size());
+        for (const auto& id : v.build_ids) {
+            put_varint(out, id.size());
+            out.insert(out.end(), id.begin(), id.end());
+        }
+    }
+
+    std::vector<uint8_t> Encode(const VersionData& v) {
+        std::vector<uint8_t> out;
+        Encode(v, out);
+        return out;
+    }
+
+    /// Decode and validate encoded version.
+    /**
+    Unlike text, encoding carries component values and identifier boundaries and types, so decoding is a single
+    pass of length-prefixed copies; identifier characters are still checked, so decoded data is always valid.
+    */
+    VersionData Decode(const uint8_t* data, const size_t size, size_t* consumed) {
+        VersionData v;
+        Decode(data, size, v, consumed);
+        return v;
+    }
+
+    void Decode(const uint8_t* data, const size_t size, VersionData& out, size_t* consumed) {
+        Layout layout;
+        scan(data, data + size, layout, &out);
+        if (consumed) *consumed = layout.size;
+    }
+
+    WireVersion::WireVersion(const uint8_t* data, const size_t size) : data_{ data } {
+        Layout layout;
+        scan(data, data + size, layout, nullptr);
+        size_ = layout.size;
+        major_ = layout.major;
+        minor_ = layout.minor;
+        patch_ = layout.patch;
+        prerelease_count_ = layout.prerelease_count;
+        build_count_ = layout.build_count;
+        bitmap_offset_ = layout.bitmap_offset;
+        prerelease_offset_ = layout.prerelease_offset;
+    }
+
+    VersionData WireVersion::ToData() const {
+        return Decode(data_, size_);
+    }
+
+    int WireVersion::Compare(const WireVersion& l, const WireVersion& r) {
+        if (l.major_ != r.major_) return l.major_ > r.major_ ? 1 : -1;
+        if (l.minor_ != r.minor_) return l.minor_ > r.minor_ ? 1 : -1;
+        if (l.patch_ != r.patch_) return l.patch_ > r.patch_ ? 1 : -1;
+
+        // Release is always higher than prerelease.
+        if (!l.prerelease_count_ || !r.prerelease_count_) {
+            if (l.prerelease_count_ == r.prerelease_count_) return 0;
+            return l.prerelease_count_ ? -1 : 1;
+        }
+
+        const uint8_t* lbits = l.data_ + l.bitmap_offset_;
+        const uint8_t* rbits = r.data_ + r.bitmap_offset_;
+        const uint8_t* lp = l.data_ + l.prerelease_offset_;
+        const uint8_t* rp = r.data_ + r.prerelease_offset_;
+        const size_t shorter = l.prerelease_count_ < r.prerelease_count_ ? l.prerelease_count_ : r.prerelease_count_;
+        for (size_t i = 0; i < shorter; ++i) {
+            const bool lnum = (lbits[i / 8] >> (i % 8)) & 1;
+            const bool rnum = (rbits[i / 8] >> (i % 8)) & 1;
+            const size_t llen = static_cast<size_t>(get_varint(lp));
+            const size_t rlen = static_cast<size_t>(get_varint(rp));
+            // Numeric identifiers have lower precedence than alphanumeric ones.
+            if (lnum != rnum) return lnum ? -1 : 1;
+            const int cmp = lnum ? cmp_num(lp, llen, rp, rlen) : cmp_alnum(lp, llen, rp, rlen);
+            if (cmp != 0) return cmp;
+            lp += llen;
+            rp += rlen;
+        }
+
+        if (l.prerelease_count_ == r.prerelease_count_) return 0;
+        return l.prerelease_count_ > r.prerelease_count_ ? 1 : -1;
+    }
+}}
@@ -0,0 +1,147 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <string>
+#include <ostream>
+#include <utility>
+#include <versioning/metrics.h>
+#include <versioning/version_base.h>
+
+#ifndef VERSIONING_HEADER_ONLY
+#include <versioning/impl/version_base.h>
+#endif
+
+namespace vsn {
+namespace {
+    // Longest decimal representation of an int, including sign.
+    const size_t max_int_digits = 12;
+
+    // Write decimal representation of v to buf, returning its length.
+    size_t format_int(char* buf, int v) {
+        char tmp[max_int_digits];
+        size_t n = 0;
+        unsigned u = v < 0 ? 0u - static_cast<unsigned>(v) : static_cast<unsigned>(v);
+        do {
+            tmp[n++] = static_cast<char>('0' + u % 10);
+            u /= 10;
+        } while (u);
+        size_t len = 0;
+        if (v < 0) buf[len++] = '-';
+        while (n) buf[len++] = tmp[--n];
+        return len;
+    }
+
+    inline const std::string& id_text(const Prerelease_identifier& id) {
+        return id.first;
+    }
+
+    inline const std::string& id_text(const Build_identifier& id) {
+        return id;
+    }
+
+    // Length of identifiers joined with dots.
+    template<typename Ids>
+    size_t joined_size(const Ids& ids) {
+        size_t n = ids.empty() ? 0 : ids.size() - 1;
+        for (const auto& id : ids) n += id_text(id).size();
+        return n;
+    }
+
+    template<typename Ids>
+    void append_joined(std::string& s, const Ids& ids) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i) s += '.';
+            s += id_text(ids[i]);
+        }
+    }
+
+    template<typename Ids>
+    void write_joined(std::ostream& os, const Ids& ids) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i) os << '.';
+            os << id_text(ids[i]);
+        }
+    }
+}
+
+    const std::string VersionBase::PreRelease() const {
+        std::string s;
+        s.reserve(joined_size(Data().prerelease_ids));
+        append_joined(s, Data().prerelease_ids);
+        return s;
+    }
+
+    const std::string VersionBase::Build() const {
+        std::string s;
+        s.reserve(joined_size(Data().build_ids));
+        append_joined(s, Data().build_ids);
+        return s;
+    }
+
+    std::string VersionBase::ToString() const {
+        VERSIONING_INSTRUMENT(format);
+#ifdef VERSIONING_RETAIN_SOURCE
+        if (!source().empty()) return source();
+#endif
+        const VersionData& data = Data();
+        char major[max_int_digits], minor[max_int_digits], patch[max_int_digits];
+        size_t major_len = format_int(major, data.major);
+        size_t minor_len = format_int(minor, data.minor);
+        size_t patch_len = format_int(patch, data.patch);
+        size_t pr_len = data.prerelease_ids.empty() ? 0 : 1 + joined_size(data.prerelease_ids);
+        size_t build_len = data.build_ids.empty() ? 0 : 1 + joined_size(data.build_ids);
+
+        // Reserve exact size up front, so formatting allocates at most once.
+        std::string s;
+        s.reserve(major_len + minor_len + patch_len + 2 + pr_len + build_len);
+        s.append(major, major_len).append(1, '.').append(minor, minor_len).append(1, '.').append(patch, patch_len);
+        if (pr_len) {
+            s += '-';
+            append_joined(s, data.prerelease_ids);
+        }
+        if (build_len) {
+            s += '+';
+            append_joined(s, data.build_ids);
+        }
+        return s;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const VersionBase& v) {
+        VERSIONING_INSTRUMENT(format);
+#ifdef VERSIONING_RETAIN_SOURCE
+        if (!v.source().empty()) return os << v.source();
+#endif
+        const VersionData& data = v.Data();
+        os << data.major << '.' << data.minor << '.' << data.patch;
+        if (!data.prerelease_ids.empty()) {
+            os << '-';
+            write_joined(os, data.prerelease_ids);
+        }
+        if (!data.build_ids.empty()) {
+            os << '+';
+            write_joined(os, data.build_ids);
+        }
+        return os;
+    }
+}
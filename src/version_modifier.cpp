@@ -0,0 +1,46 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <climits>
+#include <string>
+#include <versioning/version_modifier.h>
+#include "exceptions.h"
+#include "numeric_id.h"
+
+namespace vsn {
+    VersionData VersionModifier::IncPreRelease(const VersionData& s) const {
+        if (s.prerelease_ids.empty()) {
+            if (s.patch == INT_MAX) throw ModificationError("patch version overflow");
+            return ResetPreRelease(ResetPatch(s, s.patch + 1), Prerelease_identifiers{ { "0", Id_type::num } });
+        }
+        Prerelease_identifiers ids = s.prerelease_ids;
+        for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+            if (it->second != Id_type::num) continue;
+            increment_numeric_id(it->first);
+            return ResetPreRelease(s, ids);
+        }
+        ids.emplace_back("0", Id_type::num);
+        return ResetPreRelease(s, ids);
+    }
+}
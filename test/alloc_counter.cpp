@@ -0,0 +1,110 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <cstdlib>
+#include <new>
+#include "alloc_counter.h"
+
+namespace {
+    struct Counters {
+        size_t allocations;
+        size_t deallocations;
+        size_t bytes;
+    };
+
+    // Plain data, so it is usable from operator new at any point of thread's life.
+    thread_local Counters counters = { 0, 0, 0 };
+
+    // All forms of operator new and delete below are replaced together, so whichever pair a caller uses, memory
+    // comes from and returns to malloc, and is counted.
+    void* allocate(std::size_t n) noexcept {
+        ++counters.allocations;
+        counters.bytes += n;
+        return std::malloc(n ? n : 1);
+    }
+
+    void release(void* p) noexcept {
+        if (p) ++counters.deallocations;
+        std::free(p);
+    }
+}
+
+void* operator new(std::size_t n) {
+    if (void* p = allocate(n)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t n) {
+    if (void* p = allocate(n)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+    return allocate(n);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept {
+    return allocate(n);
+}
+
+void operator delete(void* p) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    release(p);
+}
+
+namespace vsn { namespace test {
+    AllocationScope::AllocationScope()
+            : allocations_{ counters.allocations }, deallocations_{ counters.deallocations }, bytes_{ counters.bytes } {}
+
+    size_t AllocationScope::Allocations() const {
+        return counters.allocations - allocations_;
+    }
+
+    size_t AllocationScope::Bytes() const {
+        return counters.bytes - bytes_;
+    }
+
+    long AllocationScope::Outstanding() const {
+        return static_cast<long>(Allocations()) - static_cast<long>(counters.deallocations - deallocations_);
+    }
+}}
@@ -0,0 +1,66 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef VERSIONING_TEST_ALLOC_COUNTER_H
+#define VERSIONING_TEST_ALLOC_COUNTER_H
+
+#include <cstddef>
+#include <boost/test/unit_test.hpp>
+
+namespace vsn { namespace test {
+    /// Counts heap allocations made through global operator new by the current thread during its lifetime.
+    /**
+    Link alloc_counter.cpp into the test executable, which replaces global operator new and delete. Scopes may be
+    nested; allocations made by other threads are not counted.
+    */
+    class AllocationScope {
+    public:
+        AllocationScope();
+
+        /// Get number of allocations made so far.
+        size_t Allocations() const;
+
+        /// Get number of bytes allocated so far.
+        size_t Bytes() const;
+
+        /// Get number of allocations minus deallocations made so far.
+        long Outstanding() const;
+
+    private:
+        size_t allocations_;
+        size_t deallocations_;
+        size_t bytes_;
+    };
+}}
+
+/// Check that statement makes at most budget allocations.
+#define CHECK_ALLOCATIONS(budget, statement) \
+    do { \
+        vsn::test::AllocationScope scope_; \
+        statement; \
+        BOOST_CHECK_MESSAGE(scope_.Allocations() <= (budget), \
+                            #statement << ": " << scope_.Allocations() << " allocations, budget " << (budget)); \
+    } while (0)
+
+#endif //VERSIONING_TEST_ALLOC_COUNTER_H
@@ -0,0 +1,41 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+/* Compiled as C, to check versioning_c.h is usable from C. */
+
+#include <string.h>
+#include <versioning/versioning_c.h>
+
+int vsn_c_header_check(void) {
+    const char text[] = "1.2.3-rc.1+b7";
+    vsn_string s;
+    vsn_version v;
+    vsn_error error = VSN_ERROR_OTHER;
+    s.data = text;
+    s.size = strlen(text);
+    if (vsn_parse(&s, 1, &v, &error) != VSN_OK || error != VSN_ERROR_NONE) return 1;
+    if (v.major != 1 || v.minor != 2 || v.patch != 3) return 2;
+    if (v.prerelease.size != 4 || strncmp(v.prerelease.data, "rc.1", 4) != 0) return 3;
+    if (v.build.size != 2 || strncmp(v.build.data, "b7", 2) != 0) return 4;
+    return vsn_abi_version() == VSN_ABI_VERSION ? 0 : 5;
+}
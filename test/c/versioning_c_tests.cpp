@@ -0,0 +1,221 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE versioning_c_tests
+
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/comparator.h>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/version.h>
+#include <versioning/versioning_c.h>
+#include "../../src/exceptions.h"
+
+extern "C" int vsn_c_header_check(void);
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    vsn_string view(const std::string& s) {
+        return vsn_string{ s.data(), s.size() };
+    }
+
+    std::string text(const vsn_string& s) {
+        return std::string(s.data ? s.data : "", s.size);
+    }
+
+    vsn_error expected_error(const std::string& s) {
+        ParseErrorReason reason;
+        if (p.IsValid(s.data(), s.size(), reason)) return VSN_ERROR_NONE;
+        return static_cast<vsn_error>(reason) + VSN_ERROR_OTHER;
+    }
+
+    std::vector<std::string> corpus() {
+        CorpusProfile profile;
+        profile.max_major = 2;
+        profile.max_minor = 2;
+        profile.max_patch = 2;
+        profile.max_prerelease_ids = 3;
+        profile.max_id_length = 2;
+        profile.build_share = 0.3;
+        profile.malformed_share = 0.05;
+        return CorpusGenerator(profile).Generate(5000);
+    }
+
+    BOOST_AUTO_TEST_CASE(c_header) {
+        BOOST_CHECK_EQUAL(vsn_c_header_check(), 0);
+        BOOST_CHECK_EQUAL(vsn_status_name(VSN_BUFFER_TOO_SMALL), "buffer_too_small");
+        BOOST_CHECK_EQUAL(vsn_error_name(VSN_ERROR_LEADING_ZERO), "leading_zero");
+        BOOST_CHECK_EQUAL(vsn_error_name(VSN_ERROR_MODIFICATION), "modification");
+        BOOST_CHECK_EQUAL(vsn_error_name(42), "unknown");
+    }
+
+    BOOST_AUTO_TEST_CASE(parse) {
+        const auto texts = corpus();
+        std::vector<vsn_string> in;
+        for (const auto& t : texts) in.push_back(view(t));
+        std::vector<vsn_version> out(in.size());
+        std::vector<vsn_error> errors(in.size());
+        BOOST_CHECK_EQUAL(vsn_parse(in.data(), in.size(), out.data(), errors.data()), VSN_INVALID_INPUT);
+        for (size_t i = 0; i < texts.size(); ++i) {
+            BOOST_REQUIRE_EQUAL(errors[i], expected_error(texts[i]));
+            if (errors[i] != VSN_ERROR_NONE) continue;
+            const VersionData d = p.Parse(texts[i]);
+            const Version v(d);
+            BOOST_REQUIRE_EQUAL(out[i].major, d.major);
+            BOOST_REQUIRE_EQUAL(out[i].minor, d.minor);
+            BOOST_REQUIRE_EQUAL(out[i].patch, d.patch);
+            BOOST_REQUIRE_EQUAL(text(out[i].prerelease), v.PreRelease());
+            BOOST_REQUIRE_EQUAL(text(out[i].build), v.Build());
+        }
+
+        const std::string valid = "1.0.0";
+        const vsn_string s = view(valid);
+        BOOST_CHECK_EQUAL(vsn_parse(&s, 1, nullptr, nullptr), VSN_OK);
+        BOOST_CHECK_EQUAL(vsn_parse(nullptr, 0, nullptr, nullptr), VSN_OK);
+        BOOST_CHECK_EQUAL(vsn_parse(nullptr, 1, nullptr, nullptr), VSN_INVALID_ARGUMENT);
+        const vsn_string dangling{ nullptr, 3 };
+        BOOST_CHECK_EQUAL(vsn_parse(&dangling, 1, nullptr, nullptr), VSN_INVALID_ARGUMENT);
+    }
+
+    BOOST_AUTO_TEST_CASE(compare_and_sort) {
+        const auto texts = corpus();
+        std::vector<vsn_string> in;
+        for (const auto& t : texts) in.push_back(view(t));
+        const size_t pairs = in.size() - 1;
+        std::vector<int32_t> results(pairs);
+        std::vector<vsn_error> errors(pairs);
+        BOOST_CHECK_EQUAL(vsn_compare(in.data(), in.data() + 1, pairs, results.data(), errors.data()),
+                VSN_INVALID_INPUT);
+        const Comparator comparator;
+        for (size_t i = 0; i < pairs; ++i) {
+            const vsn_error l = expected_error(texts[i]);
+            const vsn_error r = expected_error(texts[i + 1]);
+            BOOST_REQUIRE_EQUAL(errors[i], l != VSN_ERROR_NONE ? l : r);
+            if (errors[i] != VSN_ERROR_NONE) continue;
+            const int cmp = comparator.Compare(p.Parse(texts[i]), p.Parse(texts[i + 1]));
+            BOOST_REQUIRE_EQUAL(results[i], (cmp > 0) - (cmp < 0));
+        }
+
+        std::vector<size_t> order(in.size());
+        BOOST_CHECK_EQUAL(vsn_sort(in.data(), in.size(), order.data(), nullptr), VSN_INVALID_INPUT);
+        std::vector<size_t> valid, invalid;
+        for (size_t i = 0; i < texts.size(); ++i) {
+            (expected_error(texts[i]) == VSN_ERROR_NONE ? valid : invalid).push_back(i);
+        }
+        std::stable_sort(valid.begin(), valid.end(), [&](const size_t l, const size_t r) {
+            return comparator.Compare(p.Parse(texts[l]), p.Parse(texts[r])) < 0;
+        });
+        valid.insert(valid.end(), invalid.begin(), invalid.end());
+        BOOST_CHECK(order == valid);
+    }
+
+    BOOST_AUTO_TEST_CASE(format) {
+        const std::vector<std::string> texts = { "1.2.3", "0.0.0-alpha.1", "10.20.30-rc.1+build.5", "1.0.0+sha" };
+        std::vector<vsn_string> in;
+        for (const auto& t : texts) in.push_back(view(t));
+        std::vector<vsn_version> versions(in.size());
+        BOOST_REQUIRE_EQUAL(vsn_parse(in.data(), in.size(), versions.data(), nullptr), VSN_OK);
+
+        std::vector<vsn_string> out(in.size());
+        size_t required = 0;
+        BOOST_CHECK_EQUAL(vsn_format(versions.data(), versions.size(), nullptr, 0, out.data(), &required, nullptr),
+                VSN_BUFFER_TOO_SMALL);
+        size_t total = 0;
+        for (const auto& t : texts) total += t.size();
+        BOOST_CHECK_EQUAL(required, total);
+
+        std::string buffer(required, '\0');
+        BOOST_CHECK_EQUAL(vsn_format(versions.data(), versions.size(), &buffer[0], buffer.size(), out.data(),
+                &required, nullptr), VSN_OK);
+        for (size_t i = 0; i < texts.size(); ++i) BOOST_CHECK_EQUAL(text(out[i]), texts[i]);
+
+        // Texts past the first one not fitting are empty.
+        BOOST_CHECK_EQUAL(vsn_format(versions.data(), versions.size(), &buffer[0], texts[0].size() + 1, out.data(),
+                &required, nullptr), VSN_BUFFER_TOO_SMALL);
+        BOOST_CHECK_EQUAL(text(out[0]), texts[0]);
+        for (size_t i = 1; i < texts.size(); ++i) BOOST_CHECK(out[i].data == nullptr && out[i].size == 0);
+
+        const std::string bad_id = "01";
+        vsn_version invalid[2] = { { -1, 0, 0, { nullptr, 0 }, { nullptr, 0 } },
+                                   { 1, 0, 0, view(bad_id), { nullptr, 0 } } };
+        vsn_error errors[2];
+        BOOST_CHECK_EQUAL(vsn_format(invalid, 2, &buffer[0], buffer.size(), out.data(), &required, errors),
+                VSN_INVALID_INPUT);
+        BOOST_CHECK_EQUAL(errors[0], VSN_ERROR_INVALID_CHARACTER);
+        BOOST_CHECK_EQUAL(errors[1], VSN_ERROR_LEADING_ZERO);
+        BOOST_CHECK_EQUAL(required, 0u);
+    }
+
+    BOOST_AUTO_TEST_CASE(modify) {
+        const std::vector<std::string> texts = { "1.2.3-rc.1+b", "0.9.9", "1.0.0-alpha.9", "bad" };
+        std::vector<vsn_string> in;
+        for (const auto& t : texts) in.push_back(view(t));
+        const struct {
+            vsn_operation operation;
+            const char* argument;
+            std::vector<std::string> expected;
+        } cases[] = {
+            { VSN_INC_MAJOR, "", { "2.0.0", "1.0.0", "2.0.0", "" } },
+            { VSN_INC_MINOR, "", { "1.3.0", "0.10.0", "1.1.0", "" } },
+            { VSN_INC_PATCH, "", { "1.2.4", "0.9.10", "1.0.1", "" } },
+            { VSN_INC_PRERELEASE, "", { "1.2.3-rc.2", "0.9.10-0", "1.0.0-alpha.10", "" } },
+            { VSN_SET_PRERELEASE, "beta.2", { "1.2.3-beta.2", "0.9.9-beta.2", "1.0.0-beta.2", "" } },
+            { VSN_SET_PRERELEASE, "", { "1.2.3", "0.9.9", "1.0.0", "" } },
+            { VSN_SET_BUILD, "ci.7", { "1.2.3-rc.1+ci.7", "0.9.9+ci.7", "1.0.0-alpha.9+ci.7", "" } },
+        };
+        std::string buffer(256, '\0');
+        std::vector<vsn_string> out(in.size());
+        std::vector<vsn_error> errors(in.size());
+        for (const auto& c : cases) {
+            const std::string argument = c.argument;
+            size_t required = 0;
+            BOOST_CHECK_EQUAL(vsn_modify(in.data(), in.size(), c.operation, view(argument), &buffer[0], buffer.size(),
+                    out.data(), &required, errors.data()), VSN_INVALID_INPUT);
+            for (size_t i = 0; i < texts.size(); ++i) {
+                BOOST_CHECK_MESSAGE(text(out[i]) == c.expected[i], c.operation << " " << texts[i] << ": "
+                        << text(out[i]) << " instead of " << c.expected[i]);
+            }
+            BOOST_CHECK_EQUAL(errors[3], VSN_ERROR_INVALID_CHARACTER);
+        }
+
+        const std::string top = "2147483647.0.0";
+        const vsn_string s = view(top);
+        vsn_error error;
+        BOOST_CHECK_EQUAL(vsn_modify(&s, 1, VSN_INC_MAJOR, vsn_string{ nullptr, 0 }, &buffer[0], buffer.size(),
+                out.data(), nullptr, &error), VSN_INVALID_INPUT);
+        BOOST_CHECK_EQUAL(error, VSN_ERROR_MODIFICATION);
+
+        const std::string bad = "a..b";
+        BOOST_CHECK_EQUAL(vsn_modify(in.data(), in.size(), VSN_SET_PRERELEASE, view(bad), &buffer[0], buffer.size(),
+                out.data(), nullptr, nullptr), VSN_INVALID_ARGUMENT);
+        BOOST_CHECK_EQUAL(vsn_modify(in.data(), in.size(), 42, view(bad), &buffer[0], buffer.size(), out.data(),
+                nullptr, nullptr), VSN_INVALID_ARGUMENT);
+    }
+}}
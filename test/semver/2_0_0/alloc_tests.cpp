@@ -0,0 +1,197 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_alloc_tests
+
+#include <streambuf>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/batch_modifier.h>
+#include <versioning/semver/2_0_0/deduplicator.h>
+#include <versioning/semver/2_0_0/registry.h>
+#include <versioning/semver/2_0_0/version.h>
+#include <versioning/semver/2_0_0/wire.h>
+#include "../../alloc_counter.h"
+
+// Allocation budgets of public operations. Identifiers used here are short enough to fit into std::string's
+// inline buffer, so budgets count container allocations only.
+namespace vsn { namespace semver {
+    // Stream discarding everything written to it, so only allocations made by the library are counted.
+    struct NullBuffer : std::streambuf {
+        int overflow(int c) override { return c; }
+    };
+
+    const Parser parser;
+    const Comparator comparator;
+    const Modifier modifier;
+
+#ifdef VERSIONING_SHARED_PAYLOAD
+    // Constructing a version allocates block it's data is shared through.
+    const int payload = 1;
+#else
+    const int payload = 0;
+#endif
+
+    // Create lazily initialized per-thread state, such as metrics counters, before anything is measured.
+    struct WarmUp {
+        WarmUp() {
+            Version("1.0.0") < Version("2.0.0");
+        }
+    };
+
+    BOOST_GLOBAL_FIXTURE(WarmUp);
+
+    BOOST_AUTO_TEST_CASE(parse) {
+        const std::string release = "1.2.3", prerelease = "1.2.3-rc.1", full = "1.2.3-rc.1+build.5";
+        VersionData d;
+        CHECK_ALLOCATIONS(0, d = parser.Parse(release));
+        CHECK_ALLOCATIONS(1, d = parser.Parse(prerelease));
+        CHECK_ALLOCATIONS(2, d = parser.Parse(full));
+        CHECK_ALLOCATIONS(1, parser.ParsePreRelease("alpha.1.x"));
+        CHECK_ALLOCATIONS(1, parser.ParseBuild("build.5.sha"));
+
+        std::string s = release;
+        CHECK_ALLOCATIONS(payload, Version v(std::move(s)));
+
+        const std::string invalid = "1.2.3-rc..1";
+        bool valid = false;
+        CHECK_ALLOCATIONS(0, valid = parser.IsValid(full.data(), full.size()));
+        BOOST_CHECK(valid);
+        CHECK_ALLOCATIONS(0, valid = parser.IsValid(invalid.data(), invalid.size()));
+        BOOST_CHECK(!valid);
+    }
+
+    BOOST_AUTO_TEST_CASE(deduplicate) {
+        VersionDeduplicator d;
+        const std::string v = "1.2.3-rc.1+build.5", padded = " 1.2.3-rc.1+build.5\n";
+        d.Add(v);
+        DedupResult res = DedupResult::added;
+        CHECK_ALLOCATIONS(0, res = d.Add(v));
+        CHECK_ALLOCATIONS(0, res = d.Add(padded));
+        BOOST_CHECK(res == DedupResult::duplicate);
+        CHECK_ALLOCATIONS(0, res = d.Add("x"));
+        BOOST_CHECK(res == DedupResult::rejected);
+    }
+
+    BOOST_AUTO_TEST_CASE(compare) {
+        auto a = parser.Parse("1.2.3-alpha.10.x"), b = parser.Parse("1.2.3-alpha.9.x"), c = parser.Parse("1.2.3");
+        int sum = 0;
+        CHECK_ALLOCATIONS(0, sum += comparator.Compare(a, b));
+        CHECK_ALLOCATIONS(0, sum += comparator.Compare(a, c));
+        CHECK_ALLOCATIONS(0, sum += comparator.Compare(c, c));
+        BOOST_CHECK_EQUAL(sum, 0);
+
+        Version v("1.0.0-rc.1"), w("1.0.0-rc.2");
+        bool less = false;
+        CHECK_ALLOCATIONS(0, less = v < w);
+        BOOST_CHECK(less);
+    }
+
+    BOOST_AUTO_TEST_CASE(format) {
+        NullBuffer buffer;
+        std::ostream os(&buffer);
+        Version parsed("1.2.3-rc.1+build.5");
+        Version built(parser.Parse("1.2.3-rc.1+build.5"));
+        std::string s;
+        CHECK_ALLOCATIONS(0, s = parsed.PreRelease());
+        CHECK_ALLOCATIONS(0, s = parsed.Build());
+        CHECK_ALLOCATIONS(1, s = parsed.ToString());
+        CHECK_ALLOCATIONS(1, s = built.ToString());
+        CHECK_ALLOCATIONS(0, os << parsed);
+        CHECK_ALLOCATIONS(0, os << built);
+        BOOST_CHECK_EQUAL(s, "1.2.3-rc.1+build.5");
+    }
+
+    BOOST_AUTO_TEST_CASE(modify) {
+        auto d = parser.Parse("1.2.3-rc.1+build.5");
+        CHECK_ALLOCATIONS(0, d = modifier.SetMajor(std::move(d), 2));
+        CHECK_ALLOCATIONS(0, d = modifier.IncPreRelease(std::move(d)));
+        CHECK_ALLOCATIONS(0, d = modifier.ResetMinor(std::move(d), 4));
+
+        // Modifications return the generic version type Version derives from.
+        using Generic = GenericVersion<Parser, Comparator, Modifier>;
+        Generic v("1.2.3");
+        CHECK_ALLOCATIONS(0, v = std::move(v).IncMinor().IncPatch());
+        CHECK_ALLOCATIONS(2, v = std::move(v).SetPreRelease("rc.1"));
+        CHECK_ALLOCATIONS(0, v = std::move(v).IncPreRelease());
+        CHECK_ALLOCATIONS(2 + payload, v = Generic::Builder(std::move(v)).IncPatch().SetBuild("ci").Build());
+        BOOST_CHECK_EQUAL(v.ToString(), "1.3.2+ci");
+
+        std::vector<VersionData> batch(1000, parser.Parse("1.2.3-rc.1"));
+        BatchModifier bump(BumpPolicy(Bump::minor), 1);
+        CHECK_ALLOCATIONS(1, bump.Apply(batch.data(), batch.size(), batch.data()));
+    }
+
+#ifdef VERSIONING_SHARED_PAYLOAD
+    BOOST_AUTO_TEST_CASE(copy) {
+        Version v("1.2.3-rc.1+build.5");
+        std::vector<Version> copies;
+        copies.reserve(8);
+        CHECK_ALLOCATIONS(0, copies.assign(8, v));
+
+        // Modifying a shared version allocates new block and whatever identifiers modifier builds, nothing else.
+        using Generic = GenericVersion<Parser, Comparator, Modifier>;
+        Generic m = copies[0];
+        CHECK_ALLOCATIONS(1, m = std::move(m).ResetMinor(4));
+        CHECK_ALLOCATIONS(0, m = std::move(m).IncPatch());
+        CHECK_ALLOCATIONS(1, m = copies[1].IncMajor());
+        // Data is shared as a whole, so changing only a number of a shared version copies both identifier vectors.
+        CHECK_ALLOCATIONS(3, m = copies[1].SetMajor(7));
+        BOOST_CHECK_EQUAL(m.ToString(), "7.2.3-rc.1+build.5");
+        m = copies[1];
+        CHECK_ALLOCATIONS(3, m = std::move(m).SetMajor(2).IncMinor());
+        BOOST_CHECK_EQUAL(m.ToString(), "2.3.0");
+        BOOST_CHECK_EQUAL(copies[0].ToString(), "1.2.3-rc.1+build.5");
+    }
+#endif
+
+    BOOST_AUTO_TEST_CASE(registry_queries) {
+        Registry reg;
+        reg.Publish("pkg", { Version("1.0.0"), Version("1.1.0-rc.1"), Version("2.0.0") });
+        const std::string name = "pkg";
+        auto snap = reg.Read();
+        const Version* v = nullptr;
+        CHECK_ALLOCATIONS(0, v = snap.Latest(name));
+        CHECK_ALLOCATIONS(0, v = snap.LatestInMajor(name, 1));
+        CHECK_ALLOCATIONS(payload, snap.Range(name, *v, Version("2.0.0")));
+        CHECK_ALLOCATIONS(0, Registry::Snapshot s = reg.Read());
+        BOOST_CHECK_EQUAL(v->ToString(), "1.0.0");
+    }
+
+    BOOST_AUTO_TEST_CASE(wire) {
+        std::vector<uint8_t> release = Encode(parser.Parse("1.2.3")), full = Encode(parser.Parse("1.2.3-rc.1+build.5"));
+        std::vector<uint8_t> out;
+        out.reserve(64);
+        CHECK_ALLOCATIONS(0, Encode(parser.Parse("1.2.3"), out));
+        VersionData d;
+        CHECK_ALLOCATIONS(0, d = Decode(release.data(), release.size()));
+        CHECK_ALLOCATIONS(2, d = Decode(full.data(), full.size()));
+        CHECK_ALLOCATIONS(0, Decode(full.data(), full.size(), d));
+
+        int cmp = 1;
+        CHECK_ALLOCATIONS(0, cmp = WireVersion::Compare(WireVersion(full.data(), full.size()),
+                                                        WireVersion(release.data(), release.size())));
+        BOOST_CHECK_EQUAL(cmp, -1);
+    }
+}}
@@ -0,0 +1,133 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_batch_modifier_tests
+
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/batch_modifier.h>
+#include <versioning/semver/2_0_0/version.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    std::vector<VersionData> parse_all(const std::vector<std::string>& src) {
+        std::vector<VersionData> res;
+        for (const auto& s : src) res.push_back(p.Parse(s));
+        return res;
+    }
+
+    BOOST_AUTO_TEST_CASE(bump_components) {
+        const std::vector<std::string> src{ "1.2.3", "1.2.3-rc.1+b5", "0.9.0-alpha" };
+        std::vector<std::string> out(src.size());
+
+        BOOST_CHECK(BatchModifier(BumpPolicy(Bump::major)).Apply(src.data(), src.size(), out.data()).empty());
+        BOOST_CHECK(out == std::vector<std::string>({ "2.0.0", "2.0.0", "1.0.0" }));
+
+        BOOST_CHECK(BatchModifier(BumpPolicy(Bump::minor, 2)).Apply(src.data(), src.size(), out.data()).empty());
+        BOOST_CHECK(out == std::vector<std::string>({ "1.4.0", "1.4.0", "0.11.0" }));
+
+        BOOST_CHECK(BatchModifier(BumpPolicy(Bump::patch, 1, Build_identifiers{ "ci", "42" })).Apply(src.data(), src.size(), out.data()).empty());
+        BOOST_CHECK(out == std::vector<std::string>({ "1.2.4+ci.42", "1.2.4+ci.42", "0.9.1+ci.42" }));
+
+        BOOST_CHECK(BatchModifier(BumpPolicy(Bump::prerelease)).Apply(src.data(), src.size(), out.data()).empty());
+        BOOST_CHECK(out == std::vector<std::string>({ "1.2.4-0", "1.2.3-rc.2", "0.9.0-alpha.0" }));
+    }
+
+    BOOST_AUTO_TEST_CASE(bump_version_data_in_place) {
+        auto data = parse_all({ "1.2.3-rc.1+b5", "4.5.6" });
+        BOOST_CHECK(BatchModifier(BumpPolicy(Bump::minor, 1, Build_identifiers{ "b6" })).Apply(data.data(), data.size(), data.data()).empty());
+        BOOST_CHECK_EQUAL(Version(data[0]).ToString(), "1.3.0+b6");
+        BOOST_CHECK_EQUAL(Version(data[1]).ToString(), "4.6.0+b6");
+    }
+
+    BOOST_AUTO_TEST_CASE(per_item_errors) {
+        const std::vector<std::string> src{ "1.2.3", "not.a.version", "0.0.1", "1.0.0-01" };
+        std::vector<std::string> out(src.size());
+        auto errors = BatchModifier(BumpPolicy(Bump::patch, -1)).Apply(src.data(), src.size(), out.data());
+        BOOST_REQUIRE_EQUAL(errors.size(), 2u);
+        BOOST_CHECK_EQUAL(errors[0].index, 1u);
+        BOOST_CHECK_EQUAL(errors[1].index, 3u);
+        BOOST_CHECK(out == std::vector<std::string>({ "1.2.2", "", "0.0.0", "" }));
+
+        auto data = parse_all({ "1.2.3-rc.1", "0.0.0-rc.1" });
+        std::vector<VersionData> res(data.size());
+        errors = BatchModifier(BumpPolicy(Bump::major, -1)).Apply(data.data(), data.size(), res.data());
+        BOOST_REQUIRE_EQUAL(errors.size(), 1u);
+        BOOST_CHECK_EQUAL(errors[0].index, 1u);
+        BOOST_CHECK_EQUAL(Version(res[0]).ToString(), "0.0.0");
+        // Failed items are copied unchanged
+        BOOST_CHECK_EQUAL(Version(res[1]).ToString(), "0.0.0-rc.1");
+    }
+
+    BOOST_AUTO_TEST_CASE(overflow_is_item_error) {
+        const std::vector<std::string> src{ "2147483647.0.0", "2147483646.0.0", "1.2147483647.0", "1.2.2147483647" };
+        std::vector<std::string> out(src.size());
+        auto errors = BatchModifier(BumpPolicy(Bump::major, 2)).Apply(src.data(), src.size(), out.data());
+        BOOST_REQUIRE_EQUAL(errors.size(), 2u);
+        BOOST_CHECK_EQUAL(errors[0].index, 0u);
+        BOOST_CHECK_EQUAL(errors[1].index, 1u);
+        BOOST_CHECK_EQUAL(out[2], "3.0.0");
+
+        auto data = parse_all(src);
+        errors = BatchModifier(BumpPolicy(Bump::minor)).Apply(data.data(), data.size(), data.data());
+        BOOST_REQUIRE_EQUAL(errors.size(), 1u);
+        BOOST_CHECK_EQUAL(errors[0].index, 2u);
+        BOOST_CHECK_EQUAL(Version(data[2]).ToString(), "1.2147483647.0");
+
+        errors = BatchModifier(BumpPolicy(Bump::patch)).Apply(src.data(), src.size(), out.data());
+        BOOST_REQUIRE_EQUAL(errors.size(), 1u);
+        BOOST_CHECK_EQUAL(errors[0].index, 3u);
+        BOOST_CHECK(out[3].empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(invalid_policy) {
+        BOOST_CHECK_THROW(BatchModifier(BumpPolicy(Bump::major, 1, Build_identifiers{ "a..b" })), vsn::ModificationError);
+    }
+
+    BOOST_AUTO_TEST_CASE(large_batch_matches_single_version_bumps) {
+        std::vector<std::string> src;
+        for (int i = 0; i < 50000; ++i) {
+            std::string v = std::to_string(i % 7) + "." + std::to_string(i % 13) + "." + std::to_string(i % 101);
+            if (i % 3 == 0) v += "-rc." + std::to_string(i % 5);
+            if (i % 1000 == 0) v = "bad-" + v;
+            src.push_back(v);
+        }
+        std::vector<std::string> out(src.size());
+        auto errors = BatchModifier(BumpPolicy(Bump::minor), 4).Apply(src.data(), src.size(), out.data());
+
+        size_t e = 0;
+        for (size_t i = 0; i < src.size(); ++i) {
+            if (i % 1000 == 0) {
+                BOOST_REQUIRE(e < errors.size());
+                BOOST_CHECK_EQUAL(errors[e++].index, i);
+                BOOST_CHECK(out[i].empty());
+            } else if (out[i] != Version(src[i]).IncMinor().ToString()) {
+                BOOST_FAIL("batch result differs at " + std::to_string(i));
+            }
+        }
+        BOOST_CHECK_EQUAL(e, errors.size());
+    }
+}}
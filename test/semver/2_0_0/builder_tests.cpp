@@ -0,0 +1,120 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_builder_tests
+
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/version.h>
+#include "../../../src/exceptions.h"
+#include "../../alloc_counter.h"
+
+namespace vsn { namespace semver {
+    const std::string src = "1.2.3-alpha.1+build.5";
+
+    // Number of allocations needed for a single deep copy of source version data.
+    size_t copy_cost() {
+        auto data = Parser().Parse(src);
+        test::AllocationScope scope;
+        VersionData copy(data);
+        return scope.Allocations();
+    }
+
+#ifdef VERSIONING_SHARED_PAYLOAD
+    // Producing a new version also allocates block it's data is shared through.
+    const size_t payload = 1;
+#else
+    const size_t payload = 0;
+#endif
+
+    BOOST_AUTO_TEST_CASE(rvalue_chain_does_not_allocate) {
+        Version v(src);
+        test::AllocationScope scope;
+        auto v2 = std::move(v).SetMajor(3).SetMinor(1).SetPatch(4).ResetPatch(5);
+        auto allocated = scope.Allocations();
+        BOOST_CHECK_EQUAL(allocated, 0u);
+        BOOST_CHECK_EQUAL(v2.Major(), 3);
+        BOOST_CHECK_EQUAL(v2.Minor(), 1);
+        BOOST_CHECK_EQUAL(v2.Patch(), 5);
+        BOOST_CHECK_EQUAL(v2.PreRelease(), "");
+    }
+
+    BOOST_AUTO_TEST_CASE(lvalue_chain_copies_once) {
+        auto expected = copy_cost() + payload;
+        Version v(src);
+        test::AllocationScope scope;
+        auto v2 = v.SetMajor(3).SetMinor(1).SetPatch(4);
+        auto allocated = scope.Allocations();
+        BOOST_CHECK_EQUAL(allocated, expected);
+        BOOST_CHECK_EQUAL(v2.ToString(), "3.1.4-alpha.1+build.5");
+        // Source version is unaffected
+        BOOST_CHECK_EQUAL(v.ToString(), src);
+    }
+
+    BOOST_AUTO_TEST_CASE(builder_copies_once) {
+        auto expected = copy_cost() + payload;
+        Version v(src);
+        test::AllocationScope scope;
+        auto v2 = VersionBuilder(v).SetMajor(3).SetMinor(1).IncPatch().SetPatch(7).Build();
+        auto allocated = scope.Allocations();
+        BOOST_CHECK_EQUAL(allocated, expected);
+        BOOST_CHECK_EQUAL(v2.ToString(), "3.1.7");
+        BOOST_CHECK_EQUAL(v.ToString(), src);
+    }
+
+    BOOST_AUTO_TEST_CASE(builder_modifications) {
+        VersionBuilder b;
+        b.SetMajor(1).SetMinor(2).SetPatch(3).SetPreRelease("rc.1").SetBuild("b42");
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.2.3-rc.1+b42");
+        b.ResetPreRelease("rc.2");
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.2.3-rc.2");
+        b.ResetBuild("b43").IncMinor();
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.3.0");
+        b.IncMajor(2).ResetMinor(4).ResetPatch(1);
+        BOOST_CHECK_EQUAL(std::move(b).Build().ToString(), "3.4.1");
+    }
+
+    BOOST_AUTO_TEST_CASE(builder_typed_identifiers) {
+        VersionBuilder b{ Version(src) };
+        b.SetPreRelease(Prerelease_identifiers{ { "rc", Id_type::alnum }, { "4", Id_type::num } }).IncPreRelease();
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.2.3-rc.5");
+        b.SetBuild(Build_identifiers{ "b1" });
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.2.3-rc.5+b1");
+        b.ResetPreRelease(Prerelease_identifiers{ { "beta", Id_type::alnum } });
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.2.3-beta");
+        b.ResetBuild(Build_identifiers{ "b2" });
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.2.3-beta+b2");
+        BOOST_CHECK_THROW(b.SetBuild(Build_identifiers{ "" }), vsn::ModificationError);
+        BOOST_CHECK_EQUAL(b.Build().ToString(), "1.2.3-beta+b2");
+    }
+
+    BOOST_AUTO_TEST_CASE(builder_invalid_values) {
+        VersionBuilder b{ Version(src) };
+        BOOST_CHECK_THROW(b.SetMajor(-1), vsn::ModificationError);
+        BOOST_CHECK_THROW(b.IncMinor(-3), vsn::ModificationError);
+        BOOST_CHECK_THROW(b.SetPreRelease("a..b"), vsn::ParseError);
+        // Failed modifications leave builder unchanged
+        BOOST_CHECK_EQUAL(b.Build().ToString(), src);
+    }
+}}
@@ -0,0 +1,173 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_constexpr_version_tests
+
+#include <climits>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/comparator.h>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/constexpr_version.h>
+#include <versioning/semver/2_0_0/version.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    // Checks below are evaluated by the compiler; the test only has to build.
+    constexpr ConstexprVersion abi = "2.3.0-rc.1+exp.sha.5114f85";
+    static_assert(abi.Major() == 2 && abi.Minor() == 3 && abi.Patch() == 0 && abi.IsPrerelease(), "parts");
+    static_assert(abi < "2.3.0" && abi > "2.3.0-beta.11" && abi == "2.3.0-rc.1", "precedence");
+    static_assert(ConstexprVersion("1.0.0-alpha.10") > "1.0.0-alpha.9", "numeric identifiers by value");
+    static_assert(ConstexprVersion("1.0.0-alpha.beta") > "1.0.0-alpha.1", "numeric identifiers lower");
+    static_assert(ConstexprVersion("1.0.0-alpha.1") > "1.0.0-alpha", "more identifiers higher");
+    static_assert(ConstexprVersion("1.0.0+a") == "1.0.0+b", "build ignored");
+    static_assert(ConstexprConstraint("^2.1.0 || ~1.9.4").Contains(abi), "caret");
+    static_assert(!ConstexprConstraint(">=2.3.0 <3.0.0").Contains(abi), "range");
+
+    BOOST_AUTO_TEST_CASE(parts) {
+        const std::string text = "1.2.3-alpha.1+build.7";
+        const ConstexprVersion v(text.data(), text.size());
+        const VersionData expected = p.Parse(text);
+        const VersionData d = v.Data();
+        BOOST_CHECK_EQUAL(d.major, expected.major);
+        BOOST_CHECK_EQUAL(d.minor, expected.minor);
+        BOOST_CHECK_EQUAL(d.patch, expected.patch);
+        BOOST_CHECK(d.prerelease_ids == expected.prerelease_ids);
+        BOOST_CHECK(d.build_ids == expected.build_ids);
+        BOOST_CHECK_EQUAL(std::string(v.Text(), v.Size()), text);
+    }
+
+    // Invalid text throws at run time what Parser would.
+    BOOST_AUTO_TEST_CASE(invalid_text) {
+        const char* texts[] = { "", "1", "1.2", "1.2.", "01.2.3", "1.2.3-", "1.2.3-a..b", "1.2.3+", "1.2.3-01",
+                "1.2.3-a_b", "1.2.3x", "1.2.99999999999", "v1.2.3", "1.2.3+b+c" };
+        for (const char* text : texts) {
+            const std::string s = text;
+            ParseErrorReason reason = ParseErrorReason::other;
+            BOOST_REQUIRE(!p.IsValid(s.data(), s.size(), reason));
+            try {
+                ConstexprVersion(s.data(), s.size());
+                BOOST_ERROR("no error for " << s);
+            } catch (const ParseError& e) {
+                BOOST_CHECK_MESSAGE(e.Reason() == reason, "wrong reason for " << s);
+                try {
+                    p.Parse(s);
+                } catch (const ParseError& expected) {
+                    BOOST_CHECK_EQUAL(std::string(e.what()), std::string(expected.what()));
+                }
+            }
+        }
+    }
+
+    // Validity and precedence agree with Parser and Comparator on generated versions, malformed ones included.
+    BOOST_AUTO_TEST_CASE(agrees_with_comparator) {
+        CorpusProfile profile;
+        profile.max_major = 2;
+        profile.max_minor = 2;
+        profile.max_patch = 2;
+        profile.max_prerelease_ids = 3;
+        profile.max_id_length = 2;
+        profile.malformed_share = 0.1;
+        const auto texts = CorpusGenerator(profile).Generate(20000);
+        std::vector<std::string> valid;
+        for (const auto& t : texts) {
+            const bool ok = p.IsValid(t.data(), t.size());
+            bool parsed = true;
+            try {
+                ConstexprVersion(t.data(), t.size());
+            } catch (const ParseError&) {
+                parsed = false;
+            }
+            BOOST_REQUIRE_MESSAGE(parsed == ok, t);
+            if (ok) valid.push_back(t);
+        }
+
+        const Comparator comparator;
+        for (size_t i = 0; i + 1 < valid.size(); ++i) {
+            const auto& l = valid[i];
+            const auto& r = valid[i + 1];
+            const int expected = comparator.Compare(p.Parse(l), p.Parse(r));
+            const ConstexprVersion sl(l.data(), l.size()), sr(r.data(), r.size());
+            const int cmp = ConstexprVersion::Compare(sl, sr);
+            BOOST_REQUIRE_MESSAGE((cmp > 0) - (cmp < 0) == (expected > 0) - (expected < 0), l << " <=> " << r);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(constraints) {
+        const struct {
+            const char* range;
+            const char* version;
+            bool contains;
+        } cases[] = {
+            { "1.2.3", "1.2.3+b1", true },
+            { "=1.2.3", "1.2.4", false },
+            { "*", "0.0.0-0", true },
+            { "<1.2.3", "1.2.3-rc.1", true },
+            { "<1.2.3", "1.2.3", false },
+            { "<=1.2.3", "1.2.3", true },
+            { ">1.2.3", "1.2.3", false },
+            { ">=1.2.3", "1.2.3", true },
+            { ">=1.0.0 <2.0.0", "1.9.9", true },
+            { ">=1.0.0 <2.0.0", "2.0.0", false },
+            { "  >=1.0.0\t<2.0.0  ", "0.9.0", false },
+            { "~1.2.3", "1.2.9", true },
+            { "~1.2.3", "1.3.0-alpha", false },
+            { "~1.2.3", "1.2.2", false },
+            { "^1.2.3", "1.9.0", true },
+            { "^1.2.3", "2.0.0-rc.1", false },
+            { "^1.2.3", "1.2.3-rc.1", false },
+            { "^0.2.3", "0.2.9", true },
+            { "^0.2.3", "0.3.0", false },
+            { "^0.0.3", "0.0.3", true },
+            { "^0.0.3", "0.0.4", false },
+            { "^1.2.3-beta.2", "1.2.3-beta.10", true },
+            { "<1.0.0 || >=2.0.0", "1.5.0", false },
+            { "<1.0.0 || >=2.0.0", "2.1.0", true },
+            { "1.0.0||2.0.0", "2.0.0", true },
+            { "^2147483647.0.0", "2147483647.2147483647.2147483647", true },
+            { "~1.2147483647.0", "1.2147483647.5", true },
+            { "~1.2147483647.0", "2.0.0", false },
+            { "^0.0.2147483647", "0.1.0", false },
+        };
+        for (const auto& c : cases) {
+            const std::string range = c.range;
+            const std::string version = c.version;
+            const bool contains = ConstexprConstraint(range.data(), range.size())
+                    .Contains(ConstexprVersion(version.data(), version.size()));
+            BOOST_CHECK_MESSAGE(contains == c.contains, "'" << range << "' " << version);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(invalid_constraints) {
+        const char* ranges[] = { "", "  ", "||", "1.0.0 ||", ">= 1.0.0", "=>1.0.0", "1.0.0 | 2.0.0", "^1.0", "~x" };
+        for (const char* range : ranges) {
+            const std::string s = range;
+            BOOST_CHECK_THROW(ConstexprConstraint(s.data(), s.size()), ParseError);
+        }
+    }
+}}
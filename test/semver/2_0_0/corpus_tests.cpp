@@ -0,0 +1,115 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_corpus_tests
+
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    bool parses(const std::string& s) {
+        try {
+            p.Parse(s);
+            return true;
+        } catch (const ParseError&) {
+            return false;
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(deterministic) {
+        CorpusProfile profile;
+        profile.malformed_share = 0.1;
+        auto a = CorpusGenerator(profile).Generate(1000);
+        BOOST_CHECK(a == CorpusGenerator(profile).Generate(1000));
+
+        profile.seed = 2;
+        BOOST_CHECK(a != CorpusGenerator(profile).Generate(1000));
+
+        // Output must not depend on platform or standard library.
+        profile = CorpusProfile();
+        profile.seed = 42;
+        profile.prerelease_share = 0.6;
+        profile.build_share = 0.6;
+        CorpusGenerator gen(profile);
+        BOOST_CHECK_EQUAL(gen.Next(), "1.2.62-dev.19.alpha+sha.0895101");
+        BOOST_CHECK_EQUAL(gen.Next(), "2.15.2");
+        BOOST_CHECK_EQUAL(gen.Next(), "3.21.4-M.preview.7+sha.b5b1a0a");
+        BOOST_CHECK_EQUAL(gen.Next(), "17.22.48+ci.826.b2c2dfe");
+    }
+
+    BOOST_AUTO_TEST_CASE(malformed_share) {
+        CorpusProfile profile;
+        profile.malformed_share = 0.3;
+        profile.prerelease_share = 0.5;
+        profile.build_share = 0.5;
+        CorpusGenerator gen(profile);
+        std::string s;
+        int malformed = 0;
+        const int n = 20000;
+        for (int i = 0; i < n; ++i) {
+            bool valid = gen.Next(s);
+            BOOST_CHECK_MESSAGE(parses(s) == valid, s);
+            malformed += !valid;
+        }
+        BOOST_CHECK_CLOSE(malformed / double(n), 0.3, 5);
+    }
+
+    BOOST_AUTO_TEST_CASE(profile_shapes_corpus) {
+        CorpusProfile profile;
+        profile.prerelease_share = 1;
+        profile.min_prerelease_ids = 2;
+        profile.max_prerelease_ids = 2;
+        profile.numeric_id_share = 0;
+        profile.common_tag_share = 0;
+        profile.min_id_length = 5;
+        profile.max_id_length = 5;
+        profile.build_share = 1;
+        profile.sha_build_share = 1;
+        profile.max_major = 3;
+        for (const auto& s : CorpusGenerator(profile).Generate(1000)) {
+            auto d = p.Parse(s);
+            BOOST_CHECK(d.major <= 3);
+            BOOST_REQUIRE_EQUAL(d.prerelease_ids.size(), 2u);
+            for (const auto& id : d.prerelease_ids) {
+                BOOST_CHECK(id.second == Id_type::alnum);
+                BOOST_CHECK_EQUAL(id.first.size(), 5u);
+            }
+            BOOST_REQUIRE_EQUAL(d.build_ids.size(), 2u);
+            BOOST_CHECK_EQUAL(d.build_ids[0], "sha");
+        }
+
+        profile = CorpusProfile();
+        profile.prerelease_share = 0;
+        profile.build_share = 0;
+        for (const auto& s : CorpusGenerator(profile).Generate(1000)) {
+            auto d = p.Parse(s);
+            BOOST_CHECK(d.prerelease_ids.empty() && d.build_ids.empty());
+        }
+    }
+}}
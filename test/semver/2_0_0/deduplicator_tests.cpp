@@ -0,0 +1,159 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_deduplicator_tests
+
+#include <map>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/deduplicator.h>
+#include <versioning/semver/2_0_0/merge.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    DedupOptions options(VersionEquality equality, bool coerce = false, size_t max_bytes = size_t{ 64 } << 20) {
+        DedupOptions res;
+        res.equality = equality;
+        res.coerce = coerce;
+        res.max_bytes = max_bytes;
+        return res;
+    }
+
+    // Versions from a narrow range, so most of them repeat, some padded with whitespace.
+    std::vector<std::string> feed(size_t n) {
+        CorpusProfile profile;
+        profile.max_major = 3;
+        profile.max_minor = 3;
+        profile.max_patch = 3;
+        profile.max_prerelease_ids = 1;
+        profile.build_share = 0.3;
+        profile.sha_build_share = 0;
+        profile.max_id_length = 2;
+        profile.malformed_share = 0.05;
+        auto res = CorpusGenerator(profile).Generate(n);
+        for (size_t i = 0; i < res.size(); i += 7) res[i] = " " + res[i] + (i % 2 ? "\t" : "");
+        return res;
+    }
+
+    BOOST_AUTO_TEST_CASE(equality_modes) {
+        const char* in[] = { "1.0.0+b1", " 1.0.0+b1", "1.0.0+b2", "1.0.0", "1.0.0-rc.1", "1.0", "1.0.0+b1" };
+        VersionDeduplicator text(options(VersionEquality::text)), identity, precedence(options(
+                VersionEquality::precedence));
+        for (auto s : in) {
+            text.Add(s);
+            identity.Add(s);
+            precedence.Add(s);
+        }
+        BOOST_CHECK_EQUAL(text.Distinct(), 5u);
+        BOOST_CHECK_EQUAL(text.Count("1.0.0+b1"), 2u);
+        BOOST_CHECK_EQUAL(text.Count(" 1.0.0+b1"), 1u);
+        BOOST_CHECK_EQUAL(identity.Distinct(), 4u);
+        BOOST_CHECK_EQUAL(identity.Count("1.0.0+b1"), 3u);
+        BOOST_CHECK_EQUAL(precedence.Distinct(), 2u);
+        BOOST_CHECK_EQUAL(precedence.Count("1.0.0"), 5u);
+        BOOST_CHECK_EQUAL(precedence.Count("1.0.0+b1"), 0u);
+        for (const auto* d : { &text, &identity, &precedence }) {
+            BOOST_CHECK_EQUAL(d->Total(), 7u);
+            BOOST_CHECK_EQUAL(d->Rejected(), 1u);
+            BOOST_CHECK_EQUAL(d->Duplicates(), d->Total() - d->Rejected() - d->Distinct());
+        }
+
+        const std::vector<std::pair<std::string, uint64_t>> expected = { { "1.0.0", 5 }, { "1.0.0-rc.1", 1 } };
+        BOOST_CHECK(precedence.Counts() == expected);
+    }
+
+    BOOST_AUTO_TEST_CASE(coercion) {
+        VersionDeduplicator identity(options(VersionEquality::identity, true));
+        VersionDeduplicator text(options(VersionEquality::text, true));
+        for (auto s : { "v1.2", "1.2.0", " 1.02 ", "release-1.2.0", "1.2.0.7", "latest" }) {
+            identity.Add(s);
+            text.Add(s);
+        }
+        BOOST_CHECK_EQUAL(identity.Count("1.2.0"), 4u);
+        BOOST_CHECK_EQUAL(identity.Count("1.2.0+7"), 1u);
+        BOOST_CHECK_EQUAL(identity.Distinct(), 2u);
+        BOOST_CHECK_EQUAL(identity.Rejected(), 1u);
+        BOOST_CHECK_EQUAL(text.Distinct(), 5u);
+        BOOST_CHECK_EQUAL(text.Count("v1.2"), 1u);
+    }
+
+    BOOST_AUTO_TEST_CASE(counts_match_reference) {
+        const auto in = feed(200000);
+        for (auto equality : { VersionEquality::identity, VersionEquality::precedence }) {
+            const auto builds = equality == VersionEquality::identity ? BuildMetadata::distinct
+                                                                      : BuildMetadata::ignored;
+            std::map<VersionData, uint64_t, VersionOrder> expected{ VersionOrder(builds) };
+            VersionDeduplicator d(options(equality));
+            uint64_t rejected = 0;
+            for (const auto& s : in) {
+                const auto res = d.Add(s);
+                try {
+                    const auto first = s.find_first_not_of(" \t"), last = s.find_last_not_of(" \t");
+                    ++expected[p.Parse(first == std::string::npos ? "" : s.substr(first, last + 1 - first))];
+                    BOOST_CHECK(res == DedupResult::added || res == DedupResult::duplicate);
+                } catch (const ParseError&) {
+                    ++rejected;
+                    BOOST_CHECK(res == DedupResult::rejected);
+                }
+            }
+            BOOST_CHECK_EQUAL(d.Rejected(), rejected);
+            BOOST_CHECK_EQUAL(d.Overflowed(), 0u);
+            BOOST_REQUIRE_EQUAL(d.Distinct(), expected.size());
+            BOOST_CHECK(d.Duplicates() > 0);
+            for (const auto& c : d.Counts()) {
+                const auto it = expected.find(p.Parse(c.first));
+                BOOST_REQUIRE(it != expected.end());
+                BOOST_CHECK_EQUAL(c.second, it->second);
+                BOOST_CHECK_EQUAL(d.Count(c.first), c.second);
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(memory_cap) {
+        const size_t cap = 128 * 1024;
+        VersionDeduplicator d(options(VersionEquality::identity, false, cap));
+        std::vector<std::string> kept;
+        for (int i = 0; i < 20000; ++i) {
+            const auto s = "1." + std::to_string(i) + ".0-some.longer.prerelease.tag";
+            if (d.Add(s) == DedupResult::added) kept.push_back(s);
+            BOOST_REQUIRE_LE(d.MemoryUsage(), cap);
+        }
+        BOOST_CHECK(d.Overflowed() > 0);
+        BOOST_CHECK_EQUAL(d.Distinct(), kept.size());
+        BOOST_CHECK_EQUAL(d.Total(), d.Distinct() + d.Overflowed());
+
+        // Versions kept are still counted; others are not.
+        BOOST_CHECK(d.Add(kept.front()) == DedupResult::duplicate);
+        BOOST_CHECK(d.Add("1.19999.0-some.longer.prerelease.tag") == DedupResult::overflow);
+        BOOST_CHECK_EQUAL(d.Count(kept.front()), 2u);
+        BOOST_CHECK_EQUAL(d.Count("1.19999.0-some.longer.prerelease.tag"), 0u);
+
+        VersionDeduplicator none(options(VersionEquality::identity, false, 0));
+        BOOST_CHECK(none.Add("1.0.0") == DedupResult::overflow);
+        BOOST_CHECK_EQUAL(none.Distinct(), 0u);
+    }
+}}
@@ -0,0 +1,78 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_header_only_tests
+
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <versioning/read_only_version.h>
+#include <versioning/semver/2_0_0/comparator.h>
+
+// Built against headers only, without the versioning library, so everything used here must be defined inline.
+namespace vsn { namespace semver {
+    const Comparator comparator;
+
+    ReadOnlyVersion version(int M, int m, int p, Prerelease_identifiers pr = {}) {
+        return ReadOnlyVersion(VersionData(M, m, p, std::move(pr), {}), &comparator);
+    }
+
+    BOOST_AUTO_TEST_CASE(accessors) {
+        const ReadOnlyVersion v = version(1, 2, 3);
+        BOOST_CHECK_EQUAL(v.Major(), 1);
+        BOOST_CHECK_EQUAL(v.Minor(), 2);
+        BOOST_CHECK_EQUAL(v.Patch(), 3);
+    }
+
+    // Precedence example from the specification: 1.0.0-alpha < 1.0.0-alpha.1 < ... < 1.0.0 < 1.0.1 < 1.1.0 < 2.0.0.
+    BOOST_AUTO_TEST_CASE(precedence) {
+        const Prerelease_identifier alpha{ "alpha", Id_type::alnum }, beta{ "beta", Id_type::alnum };
+        const Prerelease_identifier rc{ "rc", Id_type::alnum };
+        const std::vector<ReadOnlyVersion> ordered = {
+            version(1, 0, 0, { alpha }),
+            version(1, 0, 0, { alpha, { "1", Id_type::num } }),
+            version(1, 0, 0, { alpha, beta }),
+            version(1, 0, 0, { beta }),
+            version(1, 0, 0, { beta, { "2", Id_type::num } }),
+            version(1, 0, 0, { beta, { "11", Id_type::num } }),
+            version(1, 0, 0, { rc, { "1", Id_type::num } }),
+            version(1, 0, 0),
+            version(1, 0, 1),
+            version(1, 1, 0),
+            version(2, 0, 0),
+        };
+        for (size_t i = 0; i < ordered.size(); ++i) {
+            for (size_t j = 0; j < ordered.size(); ++j) {
+                const auto& l = ordered[i];
+                const auto& r = ordered[j];
+                BOOST_CHECK_EQUAL(l < r, i < j);
+                BOOST_CHECK_EQUAL(l > r, i > j);
+                BOOST_CHECK_EQUAL(l <= r, i <= j);
+                BOOST_CHECK_EQUAL(l >= r, i >= j);
+                BOOST_CHECK_EQUAL(l == r, i == j);
+                BOOST_CHECK_EQUAL(l != r, i != j);
+            }
+        }
+    }
+}}
@@ -0,0 +1,205 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_merge_tests
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/merge.h>
+#include <versioning/semver/2_0_0/packed_version_list.h>
+#include <versioning/semver/2_0_0/parser.h>
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    bool operator==(const PackageVersion& l, const PackageVersion& r) {
+        return l.package == r.package && l.version.major == r.version.major && l.version.minor == r.version.minor &&
+               l.version.patch == r.version.patch && l.version.prerelease_ids == r.version.prerelease_ids &&
+               l.version.build_ids == r.version.build_ids;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const PackageVersion& v) {
+        return os << v.package << "@" << v.version.major << "." << v.version.minor << "." << v.version.patch;
+    }
+
+    // Sorted snapshot of (package, version) pairs; snapshots with different seeds overlap partially.
+    std::vector<PackageVersion> snapshot(uint64_t seed, size_t n, int packages) {
+        CorpusProfile profile;
+        profile.seed = seed;
+        profile.max_major = 3;
+        profile.max_minor = 4;
+        profile.max_patch = 4;
+        profile.build_share = 0.2;
+        CorpusGenerator gen(profile);
+        std::vector<PackageVersion> res;
+        for (size_t i = 0; i < n; ++i) {
+            auto v = p.Parse(gen.Next());
+            res.push_back(PackageVersion{ "pkg" + std::to_string((v.patch * 7919 + i) % packages), std::move(v) });
+        }
+        std::sort(res.begin(), res.end(), VersionOrder(BuildMetadata::distinct));
+        return res;
+    }
+
+    template<typename T>
+    std::vector<T> concat(const std::vector<std::vector<T>>& parts) {
+        std::vector<T> res;
+        for (const auto& part : parts) res.insert(res.end(), part.begin(), part.end());
+        return res;
+    }
+
+    BOOST_AUTO_TEST_CASE(set_operations) {
+        auto a = snapshot(1, 3000, 50), b = snapshot(2, 3000, 50);
+        for (auto builds : { BuildMetadata::ignored, BuildMetadata::distinct }) {
+            VersionOrder order(builds);
+            std::vector<PackageVersion> expected, actual, added, removed;
+            auto into = [](std::vector<PackageVersion>& out) {
+                return [&out](const PackageVersion& v) { out.push_back(v); };
+            };
+
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected), order);
+            Difference(a.begin(), a.end(), b.begin(), b.end(), into(actual), builds);
+            BOOST_CHECK(actual == expected);
+            Diff(a.begin(), a.end(), b.begin(), b.end(), into(removed), into(added), builds);
+            BOOST_CHECK(removed == expected);
+
+            expected.clear();
+            std::set_difference(b.begin(), b.end(), a.begin(), a.end(), std::back_inserter(expected), order);
+            BOOST_CHECK(added == expected);
+
+            expected.clear();
+            actual.clear();
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected), order);
+            Intersection(a.begin(), a.end(), b.begin(), b.end(), into(actual), builds);
+            BOOST_CHECK(actual == expected);
+            BOOST_CHECK(!actual.empty());
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(merge) {
+        std::vector<std::vector<PackageVersion>> inputs = { snapshot(1, 2000, 20), {}, snapshot(2, 500, 20),
+                                                            snapshot(3, 1000, 20) };
+        VersionOrder order;
+        std::vector<PackageVersion> expected;
+        for (const auto& in : inputs) {
+            std::vector<PackageVersion> merged;
+            std::merge(expected.begin(), expected.end(), in.begin(), in.end(), std::back_inserter(merged), order);
+            expected.swap(merged);
+        }
+
+        using It = std::vector<PackageVersion>::const_iterator;
+        std::vector<std::pair<It, It>> streams;
+        for (const auto& in : inputs) streams.emplace_back(in.begin(), in.end());
+        std::vector<PackageVersion> actual;
+        Merge(streams, [&actual](const PackageVersion& v) { actual.push_back(v); });
+        BOOST_CHECK(actual == expected);
+
+        auto equal = [&order](const PackageVersion& l, const PackageVersion& r) { return order.Compare(l, r) == 0; };
+        expected.erase(std::unique(expected.begin(), expected.end(), equal), expected.end());
+        actual.clear();
+        Merge(streams, [&actual](const PackageVersion& v) { actual.push_back(v); }, true);
+        BOOST_CHECK(actual == expected);
+    }
+
+    BOOST_AUTO_TEST_CASE(build_metadata) {
+        std::vector<VersionData> a = { p.Parse("1.0.0-rc.1"), p.Parse("1.0.0+a"), p.Parse("2.0.0") };
+        std::vector<VersionData> b = { p.Parse("1.0.0-rc.1"), p.Parse("1.0.0+b"), p.Parse("2.0.0") };
+        size_t removed = 0, added = 0;
+        auto count = [](size_t& n) { return [&n](const VersionData&) { ++n; }; };
+        Diff(a.begin(), a.end(), b.begin(), b.end(), count(removed), count(added));
+        BOOST_CHECK_EQUAL(removed + added, 0u);
+        Diff(a.begin(), a.end(), b.begin(), b.end(), count(removed), count(added), BuildMetadata::distinct);
+        BOOST_CHECK_EQUAL(removed, 1u);
+        BOOST_CHECK_EQUAL(added, 1u);
+
+        // Streams need not be in memory: compressed lists are decoded as they are read.
+        PackedVersionList la(a), lb(b);
+        std::vector<VersionData> common;
+        Intersection(la.begin(), la.end(), lb.begin(), lb.end(), [&common](const VersionData& v) {
+            common.push_back(v);
+        }, BuildMetadata::distinct);
+        BOOST_CHECK_EQUAL(common.size(), 2u);
+    }
+
+    BOOST_AUTO_TEST_CASE(parallel) {
+        auto a = snapshot(1, 60000, 500), b = snapshot(2, 40000, 500), c = snapshot(3, 100, 500);
+        for (unsigned threads : { 1u, 3u, 8u }) {
+            std::vector<std::vector<PackageVersion>> parts(64), removed(64), added(64);
+            auto into = [](std::vector<std::vector<PackageVersion>>& out) {
+                return [&out](size_t part, const PackageVersion& v) { out[part].push_back(v); };
+            };
+            std::vector<PackageVersion> expected, other;
+            auto collect = [](std::vector<PackageVersion>& out) {
+                return [&out](const PackageVersion& v) { out.push_back(v); };
+            };
+
+            size_t n = ParallelDifference(a, b, into(parts), threads);
+            BOOST_CHECK(threads == 1 || n > 1);
+            Difference(a.begin(), a.end(), b.begin(), b.end(), collect(expected));
+            BOOST_CHECK(concat(parts) == expected);
+
+            ParallelDiff(a, b, into(removed), into(added), threads, BuildMetadata::distinct);
+            expected.clear();
+            Diff(a.begin(), a.end(), b.begin(), b.end(), collect(expected), collect(other), BuildMetadata::distinct);
+            BOOST_CHECK(concat(removed) == expected);
+            BOOST_CHECK(concat(added) == other);
+
+            parts.assign(64, {});
+            expected.clear();
+            ParallelIntersection(a, b, into(parts), threads);
+            Intersection(a.begin(), a.end(), b.begin(), b.end(), collect(expected));
+            BOOST_CHECK(concat(parts) == expected);
+
+            parts.assign(64, {});
+            expected.clear();
+            ParallelMerge<PackageVersion>({ &a, &b, &c }, into(parts), true, threads);
+            using It = std::vector<PackageVersion>::const_iterator;
+            std::vector<std::pair<It, It>> streams = { { a.begin(), a.end() }, { b.begin(), b.end() },
+                                                       { c.begin(), c.end() } };
+            Merge(streams, collect(expected), true);
+            BOOST_CHECK(concat(parts) == expected);
+        }
+
+        // Versions are partitioned by major version.
+        std::vector<VersionData> va, vb;
+        for (const auto& v : a) va.push_back(v.version);
+        for (const auto& v : b) vb.push_back(v.version);
+        std::sort(va.begin(), va.end(), VersionOrder());
+        std::sort(vb.begin(), vb.end(), VersionOrder());
+        std::vector<std::vector<VersionData>> parts(64);
+        std::vector<VersionData> expected;
+        ParallelIntersection(va, vb, [&parts](size_t part, const VersionData& v) { parts[part].push_back(v); }, 4);
+        Intersection(va.begin(), va.end(), vb.begin(), vb.end(), [&expected](const VersionData& v) {
+            expected.push_back(v);
+        });
+        BOOST_CHECK_EQUAL(concat(parts).size(), expected.size());
+
+        BOOST_CHECK_THROW(ParallelDifference(a, b, [](size_t, const PackageVersion&) {
+            throw std::runtime_error("sink failed");
+        }, 4), std::runtime_error);
+    }
+}}
@@ -0,0 +1,93 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_metrics_tests
+
+#include <sstream>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <versioning/metrics.h>
+#include <versioning/semver/2_0_0/version.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    using metrics::Operation;
+
+    void parse_some(int n) {
+        Parser p;
+        for (int i = 0; i < n; ++i) {
+            p.Parse("1.2." + std::to_string(i));
+            try {
+                p.Parse("1.02.3");
+            } catch (const ParseError&) {}
+        }
+    }
+
+#ifdef VERSIONING_METRICS
+    BOOST_AUTO_TEST_CASE(count_operations) {
+        auto before = metrics::Collect();
+        BOOST_CHECK(before.enabled);
+
+        // Counters of threads that have already exited are kept.
+        std::thread t(parse_some, 100);
+        t.join();
+        parse_some(100);
+        Version a("1.0.0"), b("2.0.0");
+        BOOST_CHECK(a < b);
+        auto c = a.IncMinor().SetPatch(4);
+        std::ostringstream os;
+        os << c << c.ToString();
+
+        auto after = metrics::Collect();
+        BOOST_CHECK_EQUAL(after[Operation::parse].calls - before[Operation::parse].calls, 402u);
+        BOOST_CHECK_EQUAL(after.ParseFailures(ParseErrorReason::leading_zero) -
+                          before.ParseFailures(ParseErrorReason::leading_zero), 200u);
+        BOOST_CHECK_EQUAL(after[Operation::compare].calls - before[Operation::compare].calls, 1u);
+        BOOST_CHECK_EQUAL(after[Operation::modify].calls - before[Operation::modify].calls, 2u);
+        BOOST_CHECK_EQUAL(after[Operation::format].calls - before[Operation::format].calls, 2u);
+
+        const auto& parse = after[Operation::parse];
+        BOOST_CHECK(parse.sampled > 0 && parse.sampled <= parse.calls);
+        BOOST_CHECK(parse.MeanNs() > 0);
+        BOOST_CHECK(parse.PercentileNs(0.5) <= parse.PercentileNs(0.99));
+
+        std::ostringstream report;
+        report << after;
+        BOOST_CHECK(report.str().find("parse") != std::string::npos);
+        BOOST_CHECK(report.str().find("leading_zero") != std::string::npos);
+    }
+#else
+    BOOST_AUTO_TEST_CASE(compiled_out) {
+        parse_some(10);
+        auto s = metrics::Collect();
+        BOOST_CHECK(!s.enabled);
+        BOOST_CHECK_EQUAL(s[Operation::parse].calls, 0u);
+
+        std::ostringstream report;
+        report << s;
+        BOOST_CHECK(report.str().find("not enabled") != std::string::npos);
+    }
+#endif
+}}
@@ -312,4 +312,81 @@ namespace vsn { namespace semver {
         // Check source version is unaffected
         CHECK_SRC
     }
+
+    BOOST_AUTO_TEST_CASE(set_typed_prerelease_and_build) {
+        Version v("1.2.3-pre.rel.0+build.no.321");
+        const Prerelease_identifiers pr{ { "rc", Id_type::alnum }, { "4", Id_type::num } };
+        const Build_identifiers b{ "sha", "0a1b2c" };
+        BOOST_CHECK_EQUAL(v.SetPreRelease(pr).ToString(), "1.2.3-rc.4+build.no.321");
+        BOOST_CHECK_EQUAL(v.SetBuild(b).ToString(), "1.2.3-pre.rel.0+sha.0a1b2c");
+        BOOST_CHECK_EQUAL(v.ResetPreRelease(pr).ToString(), "1.2.3-rc.4");
+        BOOST_CHECK_EQUAL(v.ResetBuild(b).ToString(), "1.2.3-pre.rel.0+sha.0a1b2c");
+        BOOST_CHECK_EQUAL(v.SetPreRelease(pr.begin(), pr.end() - 1).ToString(), "1.2.3-rc+build.no.321");
+        BOOST_CHECK_EQUAL(v.SetBuild(b.begin() + 1, b.end()).ToString(), "1.2.3-pre.rel.0+0a1b2c");
+        BOOST_CHECK_EQUAL(Version(v).SetBuild(b).SetPreRelease(pr).ToString(), "1.2.3-rc.4+sha.0a1b2c");
+        // Check source version is unaffected
+        CHECK_SRC
+    }
+
+    BOOST_AUTO_TEST_CASE(set_typed_invalid_ids) {
+        Version v("1.2.3-pre.rel.0+build.no.321");
+        BOOST_CHECK_THROW(v.SetPreRelease(Prerelease_identifiers{ { "", Id_type::alnum } }), vsn::ModificationError);
+        BOOST_CHECK_THROW(v.SetPreRelease(Prerelease_identifiers{ { "a#b", Id_type::alnum } }), vsn::ModificationError);
+        BOOST_CHECK_THROW(v.SetPreRelease(Prerelease_identifiers{ { "01", Id_type::num } }), vsn::ModificationError);
+        BOOST_CHECK_THROW(v.SetPreRelease(Prerelease_identifiers{ { "1", Id_type::alnum } }), vsn::ModificationError);
+        BOOST_CHECK_THROW(v.SetPreRelease(Prerelease_identifiers{ { "a1", Id_type::num } }), vsn::ModificationError);
+        BOOST_CHECK_THROW(v.ResetPreRelease(Prerelease_identifiers{ { "a.b", Id_type::alnum } }), vsn::ModificationError);
+        BOOST_CHECK_THROW(v.SetBuild(Build_identifiers{ "" }), vsn::ModificationError);
+        BOOST_CHECK_THROW(v.ResetBuild(Build_identifiers{ "a+b" }), vsn::ModificationError);
+        // Leading zeros are allowed in alphanumeric and build identifiers
+        BOOST_CHECK_EQUAL(v.SetPreRelease(Prerelease_identifiers{ { "01a", Id_type::alnum } }).PreRelease(), "01a");
+        BOOST_CHECK_EQUAL(v.SetBuild(Build_identifiers{ "007" }).Build(), "007");
+        CHECK_SRC
+    }
+
+    BOOST_AUTO_TEST_CASE(inc_prerelease) {
+        BOOST_CHECK_EQUAL(Version("1.2.3-rc.4").IncPreRelease().ToString(), "1.2.3-rc.5");
+        BOOST_CHECK_EQUAL(Version("1.2.3-rc.9").IncPreRelease().ToString(), "1.2.3-rc.10");
+        BOOST_CHECK_EQUAL(Version("1.2.3-rc.99999999999999999999").IncPreRelease().ToString(), "1.2.3-rc.100000000000000000000");
+        BOOST_CHECK_EQUAL(Version("1.2.3-1.alpha").IncPreRelease().ToString(), "1.2.3-2.alpha");
+        BOOST_CHECK_EQUAL(Version("1.2.3-rc").IncPreRelease().ToString(), "1.2.3-rc.0");
+        BOOST_CHECK_EQUAL(Version("1.2.3-rc.1+b5").IncPreRelease().ToString(), "1.2.3-rc.2");
+        BOOST_CHECK_EQUAL(Version("1.2.3").IncPreRelease().ToString(), "1.2.4-0");
+        BOOST_CHECK_EQUAL(Version("1.2.3+b5").IncPreRelease().IncPreRelease().ToString(), "1.2.4-1");
+
+        Version v("1.2.3-pre.rel.0+build.no.321");
+        auto v2 = v.IncPreRelease();
+        BOOST_CHECK(v2 > v);
+        BOOST_CHECK_EQUAL(v2.ToString(), "1.2.3-pre.rel.1");
+        CHECK_SRC
+    }
+
+    // Modifier implementing only required methods, so IncPreRelease() comes from VersionModifier.
+    struct MinimalModifier : VersionModifier {
+        VersionData SetMajor(const VersionData& s, const int v) const override { return m.SetMajor(s, v); }
+        VersionData SetMinor(const VersionData& s, const int v) const override { return m.SetMinor(s, v); }
+        VersionData SetPatch(const VersionData& s, const int v) const override { return m.SetPatch(s, v); }
+        VersionData SetPreRelease(const VersionData& s, const Prerelease_identifiers& pr) const override {
+            return m.SetPreRelease(s, pr);
+        }
+        VersionData SetBuild(const VersionData& s, const Build_identifiers& b) const override { return m.SetBuild(s, b); }
+        VersionData ResetMajor(const VersionData& s, const int v) const override { return m.ResetMajor(s, v); }
+        VersionData ResetMinor(const VersionData& s, const int v) const override { return m.ResetMinor(s, v); }
+        VersionData ResetPatch(const VersionData& s, const int v) const override { return m.ResetPatch(s, v); }
+        VersionData ResetPreRelease(const VersionData& s, const Prerelease_identifiers& pr) const override {
+            return m.ResetPreRelease(s, pr);
+        }
+        VersionData ResetBuild(const VersionData& s, const Build_identifiers& b) const override {
+            return m.ResetBuild(s, b);
+        }
+    };
+
+    BOOST_AUTO_TEST_CASE(default_inc_prerelease) {
+        using MinimalVersion = GenericVersion<Parser, Comparator, MinimalModifier>;
+        BOOST_CHECK_EQUAL(MinimalVersion("1.2.3-rc.9").IncPreRelease().ToString(), "1.2.3-rc.10");
+        BOOST_CHECK_EQUAL(MinimalVersion("1.2.3-1.alpha+b5").IncPreRelease().ToString(), "1.2.3-2.alpha");
+        BOOST_CHECK_EQUAL(MinimalVersion("1.2.3-rc").IncPreRelease().ToString(), "1.2.3-rc.0");
+        BOOST_CHECK_EQUAL(MinimalVersion("1.2.3+b5").IncPreRelease().IncPreRelease().ToString(), "1.2.4-1");
+        BOOST_CHECK_THROW(MinimalVersion("1.2.2147483647").IncPreRelease(), ModificationError);
+    }
 }}
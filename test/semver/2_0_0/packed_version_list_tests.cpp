@@ -0,0 +1,173 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_packed_version_list_tests
+
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/comparator.h>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/packed_version_list.h>
+#include <versioning/semver/2_0_0/parser.h>
+
+namespace vsn { namespace semver {
+    Parser p;
+    Comparator c;
+
+    bool same(const VersionData& l, const VersionData& r) {
+        return l.major == r.major && l.minor == r.minor && l.patch == r.patch &&
+               l.prerelease_ids == r.prerelease_ids && l.build_ids == r.build_ids;
+    }
+
+    bool precedes(const VersionData& l, const VersionData& r) {
+        int cmp = c.Compare(l, r);
+        return cmp < 0 || (cmp == 0 && l.build_ids < r.build_ids);
+    }
+
+    std::vector<VersionData> parse_all(const std::vector<std::string>& strings) {
+        std::vector<VersionData> res;
+        for (const auto& s : strings) res.push_back(p.Parse(s));
+        return res;
+    }
+
+    // Release history of a package: each release is preceded by a few release candidates, some with builds.
+    std::vector<VersionData> history() {
+        std::vector<VersionData> res;
+        for (int major = 0; major < 5; ++major) {
+            for (int minor = 0; minor < 20; ++minor) {
+                for (int patch = 0; patch < 25; ++patch) {
+                    for (int rc = 1; rc <= patch % 4; ++rc) {
+                        res.push_back(VersionData(major, minor, patch, { { "rc", Id_type::alnum },
+                                                                         { std::to_string(rc), Id_type::num } }, {}));
+                    }
+                    Build_identifiers build;
+                    if (patch % 5 == 0) build = { "build", std::to_string(1000 + res.size()) };
+                    res.push_back(VersionData(major, minor, patch, {}, build));
+                }
+            }
+        }
+        return res;
+    }
+
+    BOOST_AUTO_TEST_CASE(round_trip) {
+        CorpusProfile profile;
+        profile.prerelease_share = 0.5;
+        profile.build_share = 0.3;
+        auto versions = parse_all(CorpusGenerator(profile).Generate(5000));
+        versions.push_back(p.Parse("0.0.0"));
+        versions.push_back(p.Parse("2147483647.2147483647.2147483647-99999999999999999999"));
+        auto sorted = versions;
+        std::sort(sorted.begin(), sorted.end(), precedes);
+
+        for (size_t block_size : { 1, 3, 64, 100000 }) {
+            PackedVersionList list(versions, block_size);
+            BOOST_REQUIRE_EQUAL(list.Size(), sorted.size());
+            BOOST_CHECK_EQUAL(list.BlockCount(), (sorted.size() + block_size - 1) / block_size);
+            auto decoded = list.ToVector();
+            for (size_t i = 0; i < sorted.size(); ++i) BOOST_REQUIRE(same(decoded[i], sorted[i]));
+            for (size_t i = 0; i < sorted.size(); i += 97) {
+                BOOST_CHECK(same(list.At(i), sorted[i]));
+                BOOST_CHECK_EQUAL(list.Seek(i).Index(), i);
+            }
+            BOOST_CHECK(list.Seek(sorted.size()) == list.end());
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(append) {
+        PackedVersionList list(2);
+        BOOST_CHECK(list.Empty());
+        BOOST_CHECK(list.begin() == list.end());
+        BOOST_CHECK(list.Append(p.Parse("1.0.0-rc.1")));
+        BOOST_CHECK(list.Append(p.Parse("1.0.0-rc.1")));
+        BOOST_CHECK(list.Append(p.Parse("1.0.0-rc.1+b")));
+        BOOST_CHECK(!list.Append(p.Parse("1.0.0-rc.1+a")));
+        BOOST_CHECK(!list.Append(p.Parse("1.0.0-beta")));
+        BOOST_CHECK(list.Append(p.Parse("1.0.0")));
+        BOOST_CHECK(!list.Append(VersionData(-1, 0, 0, {}, {})));
+        BOOST_CHECK(list.Append(p.Parse("1.0.1+b")));
+        BOOST_CHECK(list.Append(p.Parse("1.2.0+b")));
+        BOOST_CHECK_EQUAL(list.Size(), 6u);
+        BOOST_CHECK_EQUAL(list.BlockCount(), 3u);
+
+        std::vector<std::string> expected = { "1.0.0-rc.1", "1.0.0-rc.1", "1.0.0-rc.1+b", "1.0.0", "1.0.1+b",
+                                              "1.2.0+b" };
+        size_t i = 0;
+        for (const auto& v : list) BOOST_CHECK(same(v, p.Parse(expected[i++])));
+        BOOST_CHECK_EQUAL(i, expected.size());
+    }
+
+    BOOST_AUTO_TEST_CASE(deltas) {
+        std::vector<std::string> history = { "1.0.0-rc.9", "1.0.0-rc.10", "1.0.0", "1.0.1-rc.99" };
+        std::vector<std::string> next = { "1.0.1-rc.100", "1.0.1", "1.0.2-rc.1", "1.0.2-rc.2", "1.0.2-rc.2+b.1",
+                                          "1.0.2-rc.2+b.1", "1.0.2-rc.2.x" };
+        // Incremented and cleared prerelease take one byte, "rc" is shared with the last prerelease.
+        std::vector<size_t> sizes = { 1, 1, 6, 1, 6, 1, 6 };
+
+        PackedVersionList list;
+        for (const auto& s : history) list.Append(p.Parse(s));
+        for (size_t i = 0; i < next.size(); ++i) {
+            size_t before = list.Bytes();
+            BOOST_CHECK(list.Append(p.Parse(next[i])));
+            BOOST_CHECK_MESSAGE(list.Bytes() - before == sizes[i], next[i] << " takes " << list.Bytes() - before);
+        }
+        history.insert(history.end(), next.begin(), next.end());
+        size_t i = 0;
+        for (const auto& v : list) BOOST_CHECK(same(v, p.Parse(history[i++])));
+    }
+
+    BOOST_AUTO_TEST_CASE(bounds) {
+        auto sorted = history();
+        PackedVersionList list(sorted, 16);
+        auto probes = sorted;
+        for (const char* s : { "0.0.0-a", "0.0.0", "3.7.2-rc.2", "3.7.2-rc.10", "3.7.2-alpha", "3.7.2", "9.0.0" }) {
+            probes.push_back(p.Parse(s));
+        }
+        auto less = [](const VersionData& l, const VersionData& r) { return c.Compare(l, r) < 0; };
+        for (const auto& v : probes) {
+            size_t lower = std::lower_bound(sorted.begin(), sorted.end(), v, less) - sorted.begin();
+            size_t upper = std::upper_bound(sorted.begin(), sorted.end(), v, less) - sorted.begin();
+            BOOST_CHECK_EQUAL(list.LowerBound(v).Index(), lower);
+            BOOST_CHECK_EQUAL(list.UpperBound(v).Index(), upper);
+            if (lower < sorted.size()) BOOST_CHECK(same(*list.LowerBound(v), sorted[lower]));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(compression) {
+        auto versions = history();
+        size_t text = 0;
+        for (const auto& v : versions) {
+            text += 5 + v.prerelease_ids.size() + v.build_ids.size();
+            for (const auto& id : v.prerelease_ids) text += id.first.size();
+            for (const auto& id : v.build_ids) text += id.size();
+        }
+        std::reverse(versions.begin(), versions.end());
+        PackedVersionList list(versions);
+        BOOST_TEST_MESSAGE(versions.size() << " versions: " << text << " bytes of text, " << list.Bytes()
+                                           << " packed");
+        // Most entries take a byte or two; build metadata is stored in full.
+        BOOST_CHECK_LT(list.Bytes() * 2, text);
+        BOOST_CHECK_LT(list.Bytes() * 10, versions.size() * sizeof(VersionData));
+    }
+}}
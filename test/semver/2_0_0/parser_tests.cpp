@@ -133,4 +133,92 @@ namespace vsn { namespace semver {
                            vsn::Build_identifiers({ "build","314" }));
 
     }
+
+    vsn::ParseErrorReason reason_of(const std::string& s) {
+        try {
+            p.Parse(s);
+        } catch (const vsn::ParseError& ex) {
+            return ex.Reason();
+        }
+        BOOST_FAIL("no parse error for " + s);
+        return vsn::ParseErrorReason::other;
+    }
+
+    // parse errors tell why the version string was rejected
+    BOOST_AUTO_TEST_CASE(parse_error_reasons) {
+        BOOST_CHECK(reason_of("1.2") == vsn::ParseErrorReason::missing_component);
+        BOOST_CHECK(reason_of("") == vsn::ParseErrorReason::missing_component);
+        BOOST_CHECK(reason_of("1.2.3-") == vsn::ParseErrorReason::empty_identifier);
+        BOOST_CHECK(reason_of("1.2.3+a..b") == vsn::ParseErrorReason::empty_identifier);
+        BOOST_CHECK(reason_of("1.2.x") == vsn::ParseErrorReason::invalid_character);
+        BOOST_CHECK(reason_of("1.2.3-r_1") == vsn::ParseErrorReason::invalid_character);
+        BOOST_CHECK(reason_of("01.2.3") == vsn::ParseErrorReason::leading_zero);
+        BOOST_CHECK(reason_of("1.2.3-01") == vsn::ParseErrorReason::leading_zero);
+        BOOST_CHECK(reason_of("1.2.99999999999") == vsn::ParseErrorReason::overflow);
+    }
+}}
+
+namespace vsn { namespace semver {
+    CoercingParser cp;
+
+    std::string format(const VersionData& v) {
+        std::string s = std::to_string(v.major) + "." + std::to_string(v.minor) + "." + std::to_string(v.patch);
+        for (size_t i = 0; i < v.prerelease_ids.size(); ++i) s += (i ? "." : "-") + v.prerelease_ids[i].first;
+        for (size_t i = 0; i < v.build_ids.size(); ++i) s += (i ? "." : "+") + v.build_ids[i];
+        return s;
+    }
+
+    unsigned flags(std::initializer_list<Coercion> cs) {
+        unsigned res = 0;
+        for (auto c : cs) res |= static_cast<unsigned>(c);
+        return res;
+    }
+
+    // coerced text is normalised into a valid version, and parses strictly into the same data
+    void check_coerce(const std::string& s, const std::string& expected, std::initializer_list<Coercion> applied) {
+        const auto res = cp.Coerce(s);
+        BOOST_CHECK_EQUAL(format(res.version), expected);
+        BOOST_CHECK_EQUAL(res.coercions, flags(applied));
+        const auto strict = p.Parse(expected);
+        BOOST_CHECK(strict.prerelease_ids == res.version.prerelease_ids);
+        BOOST_CHECK(strict.build_ids == res.version.build_ids);
+    }
+
+    BOOST_AUTO_TEST_CASE(coerce_valid_versions_unchanged) {
+        for (auto s : { "0.0.0", "1.2.3", "10.20.30-rc.1.x-y", "1.0.0-0.3.7+exp.sha.5114f85", "1.2.3+01" }) {
+            check_coerce(s, s, {});
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(coerce_loose_versions) {
+        check_coerce("v1.2", "1.2.0", { Coercion::prefix, Coercion::padded });
+        check_coerce("V3", "3.0.0", { Coercion::prefix, Coercion::padded });
+        check_coerce("1.2.3.4", "1.2.3+4", { Coercion::extra_components });
+        check_coerce("1.2.3.4.5+b", "1.2.3+4.5.b", { Coercion::extra_components });
+        check_coerce(" 1.02.3 ", "1.2.3", { Coercion::trimmed, Coercion::leading_zero });
+        check_coerce("\t007.0.00\n", "7.0.0", { Coercion::trimmed, Coercion::leading_zero });
+        check_coerce("release-1.4.0", "1.4.0", { Coercion::prefix });
+        check_coerce("1.0rc1", "1.0.0-rc1", { Coercion::padded, Coercion::separator });
+        check_coerce("2.1.0_beta.2", "2.1.0-beta.2", { Coercion::separator });
+        check_coerce("2.1.beta", "2.1.0-beta", { Coercion::padded, Coercion::separator });
+        check_coerce("1.2.", "1.2.0", { Coercion::padded, Coercion::separator });
+        check_coerce("1.2.3-rc.01", "1.2.3-rc.1", { Coercion::leading_zero });
+        check_coerce("1.2.3-r_1+b@2", "1.2.3-r-1+b-2", { Coercion::invalid_character });
+        check_coerce("1.2.3-..rc..1.+", "1.2.3-rc.1", { Coercion::empty_identifier });
+    }
+
+    BOOST_AUTO_TEST_CASE(coerce_failures) {
+        CoercedVersion out;
+        BOOST_CHECK(!cp.TryCoerce("", out));
+        BOOST_CHECK(!cp.TryCoerce("  latest ", out));
+        BOOST_CHECK(!cp.TryCoerce("1.99999999999", out));
+        BOOST_CHECK_THROW(cp.Coerce("none"), ParseError);
+        BOOST_CHECK_THROW(cp.Parse("x.y.z"), ParseError);
+
+        BOOST_REQUIRE(cp.TryCoerce("v1.2-rc+b", out));
+        BOOST_REQUIRE(cp.TryCoerce("1.2.3", out));
+        BOOST_CHECK_EQUAL(format(out.version), "1.2.3");
+        BOOST_CHECK_EQUAL(out.coercions, 0u);
+        BOOST_CHECK(!out.Has(Coercion::prefix));
+    }
 }}
@@ -0,0 +1,183 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_pipeline_tests
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <versioning/bounded_queue.h>
+#include <versioning/semver/2_0_0/pipeline_stages.h>
+
+namespace vsn { namespace semver {
+    // Pass versions through slowly, to make upstream stages fill the queue.
+    struct SlowStage : Stage<Version, Version> {
+        void operator()(std::vector<Version>& batch, std::vector<Version>& out) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            for (auto& v : batch) out.push_back(std::move(v));
+        }
+    };
+
+    struct FailingStage : Stage<Version, Version> {
+        void operator()(std::vector<Version>& batch, std::vector<Version>&) {
+            for (const auto& v : batch) {
+                if (v.Major() == 13) throw std::runtime_error("unlucky");
+            }
+        }
+    };
+
+    BOOST_AUTO_TEST_CASE(queue_single_thread) {
+        BoundedQueue<int> q(3);
+        BOOST_CHECK_EQUAL(q.Capacity(), 4u);
+        for (int i = 0; i < 4; ++i) BOOST_CHECK(q.TryPush(i));
+        int v = 42;
+        BOOST_CHECK(!q.TryPush(v));
+        BOOST_CHECK_EQUAL(v, 42);
+        BOOST_CHECK_EQUAL(q.Size(), 4u);
+        for (int i = 0; i < 4; ++i) {
+            BOOST_CHECK(q.TryPop(v));
+            BOOST_CHECK_EQUAL(v, i);
+        }
+        BOOST_CHECK(!q.TryPop(v));
+        q.Push(7);
+        q.Close();
+        BOOST_CHECK(q.Pop(v));
+        BOOST_CHECK_EQUAL(v, 7);
+        BOOST_CHECK(!q.Pop(v));
+    }
+
+    BOOST_AUTO_TEST_CASE(queue_many_producers_and_consumers) {
+        const int producers = 4, consumers = 4, per_producer = 50000;
+        BoundedQueue<long long> q(64);
+        std::atomic<long long> sum{ 0 };
+        std::atomic<int> done{ 0 };
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&] {
+                for (int i = 1; i <= per_producer; ++i) q.Push(i);
+                if (++done == producers) q.Close();
+            });
+        }
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                long long v, local = 0;
+                while (q.Pop(v)) local += v;
+                sum += local;
+            });
+        }
+        for (auto& t : threads) t.join();
+        BOOST_CHECK_EQUAL(sum.load(), producers * (per_producer * (per_producer + 1LL) / 2));
+    }
+
+    BOOST_AUTO_TEST_CASE(parse_dedupe_sort_format) {
+        std::vector<std::string> input;
+        for (int i = 0; i < 5000; ++i) {
+            input.push_back(std::to_string(i % 100) + ".0.0");
+            input.push_back("1.0.0-rc." + std::to_string(i % 7));
+            input.push_back("not.a.version");
+        }
+
+        PipelineOptions options;
+        options.batch_size = 64;
+        options.queue_capacity = 4;
+        auto pipeline = Pipeline<std::string>(options)
+                .Then("parse", ParseStage(), 4)
+                .Then("dedupe", DedupeStage(), 4)
+                .Then("sort", SortStage())
+                .Then("format", FormatStage(), 2);
+
+        std::vector<std::string> res;
+        auto metrics = pipeline.Run(input.begin(), input.end(), [&](std::string&& s) { res.push_back(std::move(s)); });
+
+        std::vector<std::string> expected;
+        for (int i = 0; i < 100; ++i) {
+            if (i == 1) {
+                for (int j = 0; j < 7; ++j) expected.push_back("1.0.0-rc." + std::to_string(j));
+            }
+            expected.push_back(std::to_string(i) + ".0.0");
+        }
+        // Sorted output passes through multithreaded formatting, which keeps batches but not their order.
+        std::sort(res.begin(), res.end(), [](const std::string& l, const std::string& r) { return Version(l) < Version(r); });
+        BOOST_CHECK(res == expected);
+
+        BOOST_REQUIRE_EQUAL(metrics.size(), 4u);
+        BOOST_CHECK_EQUAL(metrics[0].name, "parse");
+        BOOST_CHECK_EQUAL(metrics[0].threads, 4u);
+        BOOST_CHECK_EQUAL(metrics[0].items_in, input.size());
+        BOOST_CHECK_EQUAL(metrics[0].items_out, 10000u);
+        BOOST_CHECK_EQUAL(metrics[1].threads, 1u);
+        BOOST_CHECK_EQUAL(metrics[1].items_out, expected.size());
+        BOOST_CHECK_EQUAL(metrics[2].items_out, expected.size());
+        BOOST_CHECK_EQUAL(metrics[3].items_out, expected.size());
+        for (const auto& m : metrics) {
+            BOOST_CHECK(m.max_queue_depth <= m.queue_capacity);
+            BOOST_CHECK(m.Throughput() > 0);
+        }
+
+        // Pipeline can be run again.
+        BOOST_CHECK_EQUAL(pipeline.Run(input).size(), expected.size());
+    }
+
+    BOOST_AUTO_TEST_CASE(backpressure) {
+        std::vector<std::string> input(20000, "1.2.3");
+        PipelineOptions options;
+        options.batch_size = 16;
+        options.queue_capacity = 2;
+        auto metrics = Pipeline<std::string>(options)
+                .Then("parse", ParseStage(), 2)
+                .Then("slow", SlowStage())
+                .Run(input.begin(), input.end(), [](Version&&) {});
+
+        BOOST_CHECK_EQUAL(metrics[1].items_out, input.size());
+        BOOST_CHECK(metrics[1].max_queue_depth <= 2);
+        BOOST_CHECK(metrics[1].mean_queue_depth > 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(stage_error) {
+        std::vector<std::string> input;
+        for (int i = 0; i < 10000; ++i) input.push_back(std::to_string(i % 20) + ".0.0");
+        auto pipeline = Pipeline<std::string>().Then("parse", ParseStage(), 2).Then("fail", FailingStage(), 2);
+        BOOST_CHECK_THROW(pipeline.Run(input), std::runtime_error);
+    }
+
+    BOOST_AUTO_TEST_CASE(invalid_options) {
+        PipelineOptions options;
+        options.batch_size = 0;
+        BOOST_CHECK_THROW(Pipeline<std::string>{ options }, std::invalid_argument);
+        options.batch_size = 1;
+        options.queue_capacity = 0;
+        BOOST_CHECK_THROW(Pipeline<std::string>{ options }, std::invalid_argument);
+
+        // Smallest valid settings still let items through.
+        options.queue_capacity = 1;
+        std::vector<std::string> input(100, "1.2.3");
+        auto metrics = Pipeline<std::string>(options).Then("parse", ParseStage())
+                .Run(input.begin(), input.end(), [](Version&&) {});
+        BOOST_CHECK_EQUAL(metrics[0].items_out, input.size());
+    }
+}}
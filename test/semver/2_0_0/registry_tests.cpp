@@ -0,0 +1,125 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_registry_tests
+
+#include <atomic>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/registry.h>
+
+namespace vsn { namespace semver {
+    std::vector<std::string> to_strings(VersionRange r) {
+        std::vector<std::string> res;
+        for (const auto& v : r) res.push_back(v.ToString());
+        return res;
+    }
+
+    BOOST_AUTO_TEST_CASE(publish_and_query) {
+        Registry reg;
+        for (auto s : { "1.2.0", "2.0.0-rc.1", "1.10.0", "0.9.0", "1.2.0+b1", "2.1.0-alpha", "1.11.0-beta" })
+            BOOST_CHECK(reg.Publish("pkg", Version(s)));
+        BOOST_CHECK(!reg.Publish("pkg", Version("1.2.0+b1")));
+        BOOST_CHECK(reg.Publish("other", Version("3.0.0")));
+
+        auto snap = reg.Read();
+        BOOST_CHECK(to_strings(snap.All("pkg")) == std::vector<std::string>({ "0.9.0", "1.2.0", "1.2.0+b1", "1.10.0",
+                                                                              "1.11.0-beta", "2.0.0-rc.1", "2.1.0-alpha" }));
+        BOOST_CHECK_EQUAL(snap.Latest("pkg")->ToString(), "1.10.0");
+        BOOST_CHECK_EQUAL(snap.Latest("pkg", true)->ToString(), "2.1.0-alpha");
+        BOOST_CHECK_EQUAL(snap.LatestInMajor("pkg", 1)->ToString(), "1.10.0");
+        BOOST_CHECK_EQUAL(snap.LatestInMajor("pkg", 1, true)->ToString(), "1.11.0-beta");
+        BOOST_CHECK_EQUAL(snap.LatestInMajor("pkg", 0)->ToString(), "0.9.0");
+        BOOST_CHECK(snap.LatestInMajor("pkg", 2) == nullptr);
+        BOOST_CHECK(snap.LatestInMajor("pkg", 3) == nullptr);
+        BOOST_CHECK_EQUAL(snap.Latest("other")->ToString(), "3.0.0");
+        BOOST_CHECK(snap.Latest("missing") == nullptr);
+        BOOST_CHECK(snap.All("missing").empty());
+
+        BOOST_CHECK(to_strings(snap.Range("pkg", Version("1.2.0"), Version("2.0.0"))) ==
+                    std::vector<std::string>({ "1.2.0", "1.2.0+b1", "1.10.0", "1.11.0-beta", "2.0.0-rc.1" }));
+        BOOST_CHECK(snap.Range("pkg", Version("3.0.0"), Version("1.0.0")).empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(bulk_publish) {
+        Registry reg;
+        BOOST_CHECK(reg.Publish("pkg", Version("1.0.0")));
+        BOOST_CHECK_EQUAL(reg.Publish("pkg", { Version("1.1.0"), Version("1.0.0"), Version("0.1.0"),
+                                               Version("1.1.0"), Version("1.1.0+x") }), 3u);
+        BOOST_CHECK(to_strings(reg.Read().All("pkg")) ==
+                    std::vector<std::string>({ "0.1.0", "1.0.0", "1.1.0", "1.1.0+x" }));
+    }
+
+    BOOST_AUTO_TEST_CASE(snapshot_is_stable) {
+        Registry reg;
+        reg.Publish("pkg", Version("1.0.0"));
+        auto snap = reg.Read();
+        const Version* latest = snap.Latest("pkg");
+        reg.Publish("pkg", Version("2.0.0"));
+        BOOST_CHECK_EQUAL(latest->ToString(), "1.0.0");
+        BOOST_CHECK_EQUAL(reg.Read().Latest("pkg")->ToString(), "2.0.0");
+    }
+
+    BOOST_AUTO_TEST_CASE(concurrent_readers_and_writers) {
+        const int writers = 2, readers = 4, per_writer = 2000;
+        Registry reg;
+        std::atomic<bool> done{ false };
+        std::atomic<int> errors{ 0 };
+
+        std::vector<std::thread> threads;
+        for (int w = 0; w < writers; ++w) {
+            threads.emplace_back([&, w] {
+                for (int i = 0; i < per_writer; ++i) {
+                    reg.Publish("pkg" + std::to_string(i % 16), Version(VersionData{ 1, i, w, {}, {} }));
+                }
+            });
+        }
+        for (int r = 0; r < readers; ++r) {
+            threads.emplace_back([&] {
+                std::vector<int> seen(16, -1);
+                while (!done.load()) {
+                    for (int p = 0; p < 16; ++p) {
+                        auto snap = reg.Read();
+                        auto all = snap.All("pkg" + std::to_string(p));
+                        const Version* latest = snap.Latest("pkg" + std::to_string(p));
+                        if (!latest) continue;
+                        // Each package only grows, so the latest version may never go backwards.
+                        if (latest->Minor() < seen[p] || !std::is_sorted(all.begin(), all.end())) ++errors;
+                        seen[p] = latest->Minor();
+                    }
+                }
+            });
+        }
+        for (int w = 0; w < writers; ++w) threads[w].join();
+        done.store(true);
+        for (size_t t = writers; t < threads.size(); ++t) threads[t].join();
+
+        BOOST_CHECK_EQUAL(errors.load(), 0);
+        auto snap = reg.Read();
+        size_t total = 0;
+        for (int p = 0; p < 16; ++p) total += snap.All("pkg" + std::to_string(p)).size();
+        BOOST_CHECK_EQUAL(total, size_t(writers * per_writer));
+    }
+}}
@@ -0,0 +1,146 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_shared_version_data_tests
+
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <versioning/shared_version_data.h>
+#include <versioning/semver/2_0_0/version.h>
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    BOOST_AUTO_TEST_CASE(copies_share_block) {
+        SharedVersionData a(p.Parse("1.2.3-rc.1+b5"));
+        BOOST_CHECK(a.Unique());
+        SharedVersionData b(a);
+        BOOST_CHECK(!a.Unique());
+        BOOST_CHECK_EQUAL(a.Owners(), 2u);
+        BOOST_CHECK_EQUAL(&a.Data(), &b.Data());
+
+        SharedVersionData c;
+        c = b;
+        BOOST_CHECK_EQUAL(a.Owners(), 3u);
+        c = SharedVersionData();
+        BOOST_CHECK_EQUAL(a.Owners(), 2u);
+    }
+
+    BOOST_AUTO_TEST_CASE(moved_from_views_empty_data) {
+        SharedVersionData a(p.Parse("1.2.3-rc.1"));
+        SharedVersionData b(std::move(a));
+        BOOST_CHECK_EQUAL(a.Owners(), 0u);
+        BOOST_CHECK_EQUAL(a.Data().major, 0);
+        BOOST_CHECK(a.Data().prerelease_ids.empty());
+        BOOST_CHECK(a.Source().empty());
+        BOOST_CHECK(!a.Unique());
+        BOOST_CHECK_EQUAL(b.Data().prerelease_ids.size(), 2u);
+
+        a = b;
+        BOOST_CHECK_EQUAL(b.Owners(), 2u);
+    }
+
+    BOOST_AUTO_TEST_CASE(writes_copy_shared_block) {
+        SharedVersionData a(p.Parse("1.2.3-rc.1+b5"));
+        a.SetSource("1.2.3-rc.1+b5");
+        SharedVersionData b(a);
+
+        // Taking data out of a shared block copies it, so other owners keep their view.
+        VersionData d = b.Take();
+        BOOST_CHECK_EQUAL(d.build_ids.size(), 1u);
+        BOOST_CHECK_EQUAL(a.Data().build_ids.size(), 1u);
+        d.major = 7;
+        b.Reset(std::move(d));
+        BOOST_CHECK(a.Unique() && b.Unique());
+        BOOST_CHECK_EQUAL(a.Data().major, 1);
+        BOOST_CHECK_EQUAL(a.Source(), "1.2.3-rc.1+b5");
+        BOOST_CHECK_EQUAL(b.Data().major, 7);
+        BOOST_CHECK(b.Source().empty());
+
+        SharedVersionData c(a);
+        c.SetSource("1.2.3-rc.1+b5 ");
+        BOOST_CHECK_EQUAL(a.Source(), "1.2.3-rc.1+b5");
+        BOOST_CHECK_EQUAL(c.Data().prerelease_ids.size(), 2u);
+    }
+
+    BOOST_AUTO_TEST_CASE(unique_block_is_reused) {
+        SharedVersionData a(p.Parse("1.2.3-rc.1"));
+        const VersionData* block = &a.Data();
+        VersionData d = a.Take();
+        d.patch = 4;
+        a.Reset(std::move(d));
+        BOOST_CHECK_EQUAL(&a.Data(), block);
+        BOOST_CHECK_EQUAL(a.Data().patch, 4);
+        BOOST_CHECK_EQUAL(a.Data().prerelease_ids.size(), 2u);
+    }
+
+    BOOST_AUTO_TEST_CASE(version_copies_are_independent) {
+        Version v("1.2.3-rc.1+b5");
+        Version copy(v);
+        BOOST_CHECK_EQUAL(copy.ToString(), "1.2.3-rc.1+b5");
+
+        auto bumped = std::move(copy).IncPreRelease();
+        BOOST_CHECK_EQUAL(bumped.ToString(), "1.2.3-rc.2");
+        BOOST_CHECK_EQUAL(v.ToString(), "1.2.3-rc.1+b5");
+
+        auto reset = Version(v).ResetMajor(2);
+        BOOST_CHECK_EQUAL(reset.ToString(), "2.0.0");
+        BOOST_CHECK_EQUAL(v.PreRelease(), "rc.1");
+
+        std::vector<GenericVersion<Parser, Comparator, Modifier>> vs(3, v);
+        vs[1] = std::move(vs[1]).SetBuild("ci");
+        BOOST_CHECK_EQUAL(vs[0].ToString(), "1.2.3-rc.1+b5");
+        BOOST_CHECK_EQUAL(vs[1].ToString(), "1.2.3-rc.1+ci");
+        BOOST_CHECK_EQUAL(vs[2], v);
+    }
+
+    BOOST_AUTO_TEST_CASE(concurrent_copies) {
+        const SharedVersionData shared(p.Parse("1.2.3-alpha.1.beta+build.5"));
+        const int threads_count = 4, per_thread = 20000;
+
+        // Threads copy, modify and drop copies of one block; it must stay intact until the last owner is gone.
+        std::vector<std::thread> threads;
+        std::vector<int> errors(threads_count, 0);
+        for (int t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    SharedVersionData copy(shared);
+                    if (copy.Data().prerelease_ids.size() != 3) ++errors[t];
+                    if (i % 8 == 0) {
+                        VersionData d = copy.Take();
+                        d.minor = i;
+                        copy.Reset(std::move(d));
+                        if (copy.Data().minor != i || !copy.Unique()) ++errors[t];
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) t.join();
+
+        for (int t = 0; t < threads_count; ++t) BOOST_CHECK_EQUAL(errors[t], 0);
+        BOOST_CHECK_EQUAL(shared.Owners(), 1u);
+        BOOST_CHECK_EQUAL(shared.Data().minor, 2);
+    }
+}}
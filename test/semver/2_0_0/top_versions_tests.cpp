@@ -0,0 +1,138 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_top_versions_tests
+
+#include <algorithm>
+#include <thread>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/top_versions.h>
+
+namespace vsn { namespace semver {
+    Parser p;
+    Comparator c;
+
+    std::vector<VersionData> stream(size_t n, uint64_t seed) {
+        CorpusProfile profile;
+        profile.seed = seed;
+        profile.max_major = 5;
+        profile.build_share = 0.2;
+        std::vector<VersionData> res;
+        for (const auto& s : CorpusGenerator(profile).Generate(n)) res.push_back(p.Parse(s));
+        return res;
+    }
+
+    // K newest versions by sorting all of them.
+    std::vector<VersionData> expected(std::vector<VersionData> in, size_t k, bool prerelease, bool unique) {
+        if (!prerelease) {
+            in.erase(std::remove_if(in.begin(), in.end(), [](const VersionData& v) {
+                return !v.prerelease_ids.empty();
+            }), in.end());
+        }
+        std::stable_sort(in.begin(), in.end(), [](const VersionData& l, const VersionData& r) {
+            return c.Compare(l, r) > 0;
+        });
+        if (unique) {
+            in.erase(std::unique(in.begin(), in.end(), [](const VersionData& l, const VersionData& r) {
+                return c.Compare(l, r) == 0;
+            }), in.end());
+        }
+        if (in.size() > k) in.resize(k);
+        return in;
+    }
+
+    // Versions equal in precedence may differ in build metadata, so results are compared by precedence.
+    void check_same(const std::vector<VersionData>& actual, const std::vector<VersionData>& expected) {
+        BOOST_REQUIRE_EQUAL(actual.size(), expected.size());
+        for (size_t i = 0; i < actual.size(); ++i) BOOST_REQUIRE_EQUAL(c.Compare(actual[i], expected[i]), 0);
+    }
+
+    BOOST_AUTO_TEST_CASE(matches_sorted_tail) {
+        const auto in = stream(20000, 1);
+        for (size_t k : { 0, 1, 10, 500, 30000 }) {
+            for (bool prerelease : { true, false }) {
+                for (bool unique : { false, true }) {
+                    TopVersions top(k, prerelease, unique);
+                    for (const auto& v : in) top.Add(v);
+                    check_same(top.Result(), expected(in, k, prerelease, unique));
+                    BOOST_CHECK_LE(top.Size(), k);
+                }
+            }
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(add_reports_admission) {
+        TopVersions top(2, false);
+        BOOST_CHECK(top.Add(p.Parse("1.0.0")));
+        BOOST_CHECK(!top.Add(p.Parse("3.0.0-rc.1")));
+        BOOST_CHECK(top.Add(p.Parse("2.0.0")));
+        BOOST_CHECK(!top.Add(p.Parse("0.9.0")));
+        BOOST_CHECK(!top.Add(p.Parse("1.0.0")));
+        BOOST_CHECK(top.Add(p.Parse("1.5.0")));
+        auto v = p.Parse("2.0.1");
+        BOOST_CHECK(top.Add(std::move(v)));
+        check_same(top.Result(), { p.Parse("2.0.1"), p.Parse("2.0.0") });
+
+        TopVersions unique(3, true, true);
+        BOOST_CHECK(unique.Add(p.Parse("1.0.0-rc.1")));
+        BOOST_CHECK(!unique.Add(p.Parse("1.0.0-rc.1+b2")));
+        BOOST_CHECK(unique.Add(p.Parse("1.0.0-rc.2")));
+        BOOST_CHECK_EQUAL(unique.Size(), 2u);
+    }
+
+    BOOST_AUTO_TEST_CASE(merge_partial_results) {
+        const auto in = stream(40000, 2);
+        const size_t threads = 4, k = 100;
+        for (bool unique : { false, true }) {
+            std::vector<TopVersions> parts(threads, TopVersions(k, true, unique));
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t) {
+                pool.emplace_back([&, t] {
+                    for (size_t i = t; i < in.size(); i += threads) parts[t].Add(in[i]);
+                });
+            }
+            for (auto& t : pool) t.join();
+
+            TopVersions all(k, true, unique);
+            all.Merge(parts[0]);
+            for (size_t t = 1; t < threads; ++t) all.Merge(std::move(parts[t]));
+            check_same(all.Result(), expected(in, k, true, unique));
+            BOOST_CHECK_EQUAL(parts[1].Size(), 0u);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(merge_with_itself) {
+        const auto in = stream(1000, 3);
+        TopVersions top(10);
+        for (const auto& v : in) top.Add(v);
+        const auto before = top.Result();
+        top.Merge(top);
+        check_same(top.Result(), before);
+        top.Merge(std::move(top));
+        check_same(top.Result(), before);
+    }
+}}
@@ -0,0 +1,119 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_validator_tests
+
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/validator.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    std::vector<std::string> corpus(size_t n) {
+        CorpusProfile profile;
+        profile.malformed_share = 0.3;
+        return CorpusGenerator(profile).Generate(n);
+    }
+
+    // Report built by parsing versions one by one; empty lines of text are skipped.
+    ValidationReport expected_report(const std::vector<std::string>& in, size_t max_samples, bool lines = false) {
+        ValidationReport res;
+        for (size_t i = 0; i < in.size(); ++i) {
+            if (lines && in[i].empty()) continue;
+            ++res.checked;
+            try {
+                p.Parse(in[i]);
+            } catch (const ParseError& e) {
+                const auto r = static_cast<size_t>(e.Reason());
+                ++res.invalid;
+                if (res.counts[r]++ < max_samples) res.samples[r].push_back(i);
+            }
+        }
+        return res;
+    }
+
+    void check_report(const ValidationReport& actual, const ValidationReport& expected) {
+        BOOST_CHECK_EQUAL(actual.checked, expected.checked);
+        BOOST_CHECK_EQUAL(actual.invalid, expected.invalid);
+        for (size_t r = 0; r < parse_error_reason_count; ++r) {
+            BOOST_CHECK_EQUAL(actual.counts[r], expected.counts[r]);
+            BOOST_CHECK(actual.samples[r] == expected.samples[r]);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(is_valid_agrees_with_parse) {
+        for (const auto& s : corpus(20000)) {
+            ParseErrorReason reason = ParseErrorReason::other, expected = reason;
+            bool parsed = true;
+            try {
+                p.Parse(s);
+            } catch (const ParseError& e) {
+                parsed = false;
+                expected = e.Reason();
+            }
+            BOOST_CHECK_EQUAL(p.IsValid(s.data(), s.size()), parsed);
+            BOOST_CHECK_EQUAL(p.IsValid(s.data(), s.size(), reason), parsed);
+            BOOST_CHECK(reason == expected);
+        }
+        const char text[] = "1.2.3 trailing";
+        BOOST_CHECK(p.IsValid(text, 5));
+        BOOST_CHECK(!p.IsValid(text, sizeof(text) - 1));
+        BOOST_CHECK(!p.IsValid(text, 0));
+    }
+
+    BOOST_AUTO_TEST_CASE(validate_strings) {
+        const auto in = corpus(30000);
+        const auto expected = expected_report(in, 16);
+        BOOST_CHECK(expected.invalid > 0);
+        for (unsigned threads : { 1u, 3u, 8u }) {
+            check_report(BulkValidator(threads).Validate(in.data(), in.size()), expected);
+        }
+        check_report(BulkValidator(4, 0).Validate(in.data(), in.size()), expected_report(in, 0));
+        check_report(BulkValidator(4).Validate(in.data(), 0), ValidationReport());
+    }
+
+    BOOST_AUTO_TEST_CASE(validate_lines) {
+        auto lines = corpus(50000);
+        for (size_t i = 0; i < lines.size(); i += 97) lines[i].clear();
+        std::string text;
+        for (size_t i = 0; i < lines.size(); ++i) text += lines[i] + (i % 5 ? "\n" : "\r\n");
+        const auto expected = expected_report(lines, 16, true);
+        for (unsigned threads : { 1u, 2u, 7u }) {
+            check_report(BulkValidator(threads).Validate(text.data(), text.size()), expected);
+        }
+
+        // Last line needs no line end.
+        text = "1.0.0\n\n1.0\r\n2.0.0-rc.1";
+        lines = { "1.0.0", "", "1.0", "2.0.0-rc.1" };
+        check_report(BulkValidator(1).Validate(text.data(), text.size()), expected_report(lines, 16, true));
+        const auto report = BulkValidator(1).Validate(text.data(), text.size());
+        BOOST_CHECK_EQUAL(report.Count(ParseErrorReason::missing_component), 1u);
+        BOOST_REQUIRE_EQUAL(report.Samples(ParseErrorReason::missing_component).size(), 1u);
+        BOOST_CHECK_EQUAL(report.Samples(ParseErrorReason::missing_component)[0], 2u);
+        BOOST_CHECK_EQUAL(BulkValidator().Validate("", 0).checked, 0u);
+    }
+}}
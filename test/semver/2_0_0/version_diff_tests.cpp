@@ -0,0 +1,115 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_version_diff_tests
+
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/comparator.h>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/version_diff.h>
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    std::ostream& operator<<(std::ostream& os, const VersionDiff d) {
+        return os << ToString(d);
+    }
+
+    BOOST_AUTO_TEST_CASE(classify_pairs) {
+        const struct {
+            const char* from;
+            const char* to;
+            VersionDiff diff;
+        } cases[] = {
+            { "1.2.3", "1.2.3", VersionDiff::none },
+            { "1.2.3-rc.1+b1", "1.2.3-rc.1+b1", VersionDiff::none },
+            { "1.2.3", "2.0.0", VersionDiff::major },
+            { "1.2.3", "2.0.0-rc.1", VersionDiff::major },
+            { "1.2.3", "1.3.0", VersionDiff::minor },
+            { "1.2.3", "1.2.4-alpha", VersionDiff::patch },
+            { "1.2.3-rc.1", "1.2.3", VersionDiff::prerelease },
+            { "1.2.3-rc.1", "1.2.3-rc.2", VersionDiff::prerelease },
+            { "1.2.3-alpha.9", "1.2.3-alpha.10", VersionDiff::prerelease },
+            { "1.2.3-1", "1.2.3-a", VersionDiff::prerelease },
+            { "1.2.3+b1", "1.2.3+b2", VersionDiff::build },
+            { "1.2.3-rc.1", "1.2.3-rc.1+b1", VersionDiff::build },
+            { "1.2.3", "1.2.3-rc.1", VersionDiff::downgrade },
+            { "1.2.3-rc.10", "1.2.3-rc.9", VersionDiff::downgrade },
+            { "2.0.0", "1.9.9", VersionDiff::downgrade },
+            { "1.2.3", "1.2.2+b1", VersionDiff::downgrade },
+        };
+        for (const auto& c : cases) {
+            const VersionDiff d = Diff(p.Parse(c.from), p.Parse(c.to));
+            BOOST_CHECK_MESSAGE(d == c.diff, c.from << " -> " << c.to << ": " << d << " instead of " << c.diff);
+        }
+    }
+
+    // Upgrades, downgrades and ties agree with Comparator; level of upgrade is the first core component changed.
+    BOOST_AUTO_TEST_CASE(agrees_with_comparator) {
+        CorpusProfile profile;
+        profile.max_major = 2;
+        profile.max_minor = 2;
+        profile.max_patch = 2;
+        profile.build_share = 0.3;
+        profile.max_prerelease_ids = 2;
+        profile.max_id_length = 2;
+        std::vector<VersionData> from, to;
+        const auto texts = CorpusGenerator(profile).Generate(40000);
+        for (size_t i = 0; i + 1 < texts.size(); i += 2) {
+            from.push_back(p.Parse(texts[i]));
+            to.push_back(p.Parse(texts[i + 1]));
+        }
+
+        std::vector<VersionDiff> batch(from.size());
+        Diff(from.data(), to.data(), from.size(), batch.data());
+        const Comparator comparator;
+        size_t counts[version_diff_count] = {};
+        for (size_t i = 0; i < from.size(); ++i) {
+            const auto& f = from[i];
+            const auto& t = to[i];
+            const VersionDiff d = Diff(f, t);
+            BOOST_REQUIRE_EQUAL(batch[i], d);
+            ++counts[static_cast<size_t>(d)];
+            const int cmp = comparator.Compare(f, t);
+            if (cmp > 0) {
+                BOOST_REQUIRE_EQUAL(d, VersionDiff::downgrade);
+            } else if (cmp == 0) {
+                BOOST_REQUIRE_EQUAL(d, f.build_ids == t.build_ids ? VersionDiff::none : VersionDiff::build);
+            } else if (f.major != t.major) {
+                BOOST_REQUIRE_EQUAL(d, VersionDiff::major);
+            } else if (f.minor != t.minor) {
+                BOOST_REQUIRE_EQUAL(d, VersionDiff::minor);
+            } else if (f.patch != t.patch) {
+                BOOST_REQUIRE_EQUAL(d, VersionDiff::patch);
+            } else {
+                BOOST_REQUIRE_EQUAL(d, VersionDiff::prerelease);
+            }
+        }
+        for (size_t k = 0; k < version_diff_count; ++k) {
+            BOOST_CHECK_MESSAGE(counts[k] > 0, "no " << ToString(static_cast<VersionDiff>(k)) << " pairs");
+        }
+    }
+}}
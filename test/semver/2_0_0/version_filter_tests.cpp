@@ -0,0 +1,160 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_version_filter_tests
+
+#include <cstdio>
+#include <system_error>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/version_filter.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    // Distinct package versions: version i of package "pkg<i % packages>".
+    std::vector<PackageVersion> catalog(size_t n, int packages, uint64_t seed) {
+        CorpusProfile profile;
+        profile.seed = seed;
+        profile.build_share = 0;
+        std::vector<PackageVersion> res;
+        CorpusGenerator gen(profile);
+        for (size_t i = 0; i < n; ++i) {
+            res.push_back(PackageVersion{ "pkg" + std::to_string(i % packages), p.Parse(gen.Next()) });
+            res.back().version.patch = static_cast<int>(i); // make versions distinct
+        }
+        return res;
+    }
+
+    BOOST_AUTO_TEST_CASE(no_misses) {
+        const auto versions = catalog(50000, 300, 1);
+        VersionFilterBuilder builder;
+        builder.Add(versions);
+        BOOST_CHECK_EQUAL(builder.Size(), versions.size());
+        const auto filter = builder.Build();
+        BOOST_CHECK_EQUAL(filter.KeyCount(), versions.size());
+        BOOST_CHECK(filter.Bytes() * 8 >= versions.size() * 16);
+
+        std::vector<uint64_t> hashes;
+        for (const auto& v : versions) {
+            BOOST_REQUIRE(filter.MayContain(v.package, v.version));
+            hashes.push_back(VersionFilter::Hash(v.package, v.version));
+        }
+        std::unique_ptr<bool[]> found(new bool[hashes.size()]);
+        filter.MayContain(hashes.data(), hashes.size(), found.get());
+        for (size_t i = 0; i < hashes.size(); ++i) BOOST_REQUIRE(found[i]);
+    }
+
+    BOOST_AUTO_TEST_CASE(precedence_equal_versions_hash_same) {
+        VersionFilterBuilder builder;
+        builder.Add("libfoo", "1.2.3-rc.1+build.5");
+        builder.Add("libbar", p.Parse("2.0.0"));
+        BOOST_CHECK_THROW(builder.Add("libfoo", "1.2"), ParseError);
+        BOOST_CHECK_THROW(builder.Add("libfoo", " "), ParseError);
+        const auto filter = builder.Build();
+
+        BOOST_CHECK(filter.MayContain("libfoo", "1.2.3-rc.1"));
+        BOOST_CHECK(filter.MayContain("libfoo", " 1.2.3-rc.1+build.6\n"));
+        BOOST_CHECK(filter.MayContain("libfoo", p.Parse("1.2.3-rc.1+x")));
+        BOOST_CHECK(filter.MayContain("libbar", "2.0.0+sha.1"));
+        BOOST_CHECK(!filter.MayContain("libfoo", "1.2.3-rc"));
+        BOOST_CHECK(!filter.MayContain("libfoo", "not a version"));
+
+        uint64_t text_hash = 0;
+        BOOST_REQUIRE(VersionFilter::Hash("libfoo", "1.2.3-rc.1+b", 12, text_hash));
+        BOOST_CHECK_EQUAL(text_hash, VersionFilter::Hash("libfoo", p.Parse("1.2.3-rc.1")));
+        BOOST_CHECK(text_hash != VersionFilter::Hash("libbar", p.Parse("1.2.3-rc.1")));
+        BOOST_CHECK(!VersionFilter::Hash("libfoo", "1.2", 3, text_hash));
+
+        const VersionFilter empty;
+        BOOST_CHECK(!empty.MayContain("libfoo", "1.2.3-rc.1"));
+    }
+
+    BOOST_AUTO_TEST_CASE(false_positive_rate) {
+        const auto present = catalog(100000, 1000, 2);
+        const auto absent = catalog(100000, 1000, 3);
+        VersionFilterBuilder builder;
+        builder.Add(present);
+        for (double bits : { 8.0, 16.0 }) {
+            const auto filter = builder.Build(bits);
+            size_t positives = 0;
+            for (const auto& v : absent) {
+                auto probe = v;
+                probe.version.minor += 1000; // never among present versions
+                positives += filter.MayContain(probe.package, probe.version);
+            }
+            const double rate = static_cast<double>(positives) / absent.size();
+            BOOST_TEST_MESSAGE("false positive rate at " << bits << " bits per key: " << rate);
+            BOOST_CHECK_LT(rate, bits < 10 ? 0.05 : 0.005);
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(copies) {
+        const auto versions = catalog(1000, 10, 5);
+        VersionFilterBuilder builder;
+        builder.Add(versions);
+        const auto filter = builder.Build();
+        const auto bytes = filter.Serialize();
+
+        // Copies get storage at other addresses, so each one aligns its blocks anew.
+        std::vector<VersionFilter> copies(5, filter);
+        copies[1] = copies[0];
+        copies[2] = VersionFilter();
+        copies[2] = filter;
+        for (const auto& copy : copies) {
+            BOOST_CHECK(copy.Serialize() == bytes);
+            for (const auto& v : versions) BOOST_REQUIRE(copy.MayContain(v.package, v.version));
+        }
+    }
+
+    BOOST_AUTO_TEST_CASE(serialization) {
+        const auto versions = catalog(1000, 10, 4);
+        VersionFilterBuilder builder;
+        builder.Add(versions);
+        const auto filter = builder.Build();
+        const auto bytes = filter.Serialize();
+        const auto copy = VersionFilter::Deserialize(bytes.data(), bytes.size());
+        BOOST_CHECK_EQUAL(copy.KeyCount(), filter.KeyCount());
+        BOOST_CHECK(copy.Serialize() == bytes);
+        for (const auto& v : versions) BOOST_REQUIRE(copy.MayContain(v.package, v.version));
+
+        const std::string path = "version_filter_tests.bin";
+        filter.Write(path);
+        BOOST_CHECK(VersionFilter::Read(path).Serialize() == bytes);
+        std::remove(path.c_str());
+        BOOST_CHECK_THROW(VersionFilter::Read(path), std::system_error);
+
+        for (size_t size = 0; size < bytes.size(); size += 7) {
+            BOOST_CHECK_THROW(VersionFilter::Deserialize(bytes.data(), size), ParseError);
+        }
+        auto b = bytes;
+        b[0] = 'X';
+        BOOST_CHECK_THROW(VersionFilter::Deserialize(b.data(), b.size()), ParseError);
+        b = bytes;
+        b[16] ^= 1; // block count
+        BOOST_CHECK_THROW(VersionFilter::Deserialize(b.data(), b.size()), ParseError);
+    }
+}}
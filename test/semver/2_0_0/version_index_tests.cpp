@@ -0,0 +1,208 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_version_index_tests
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <system_error>
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/version_index.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+
+    struct Indexed {
+        VersionData version;
+        std::string text;
+    };
+
+    // Indexed versions of each package, sorted as the index sorts them.
+    using Reference = std::map<std::string, std::vector<Indexed>>;
+
+    Reference populate(VersionIndexBuilder& builder, size_t n, int packages) {
+        CorpusProfile profile;
+        profile.seed = 7;
+        profile.max_major = 4;
+        profile.max_minor = 5;
+        profile.max_patch = 5;
+        profile.build_share = 0.2;
+        profile.malformed_share = 0;
+        CorpusGenerator gen(profile);
+        Reference ref;
+        for (size_t i = 0; i < n; ++i) {
+            const auto text = gen.Next();
+            const auto package = "pkg" + std::to_string(i % packages);
+            builder.Add(package, text);
+            ref[package].push_back(Indexed{ p.Parse(text), text });
+        }
+        const VersionOrder order(BuildMetadata::distinct);
+        for (auto& versions : ref) {
+            auto& v = versions.second;
+            std::sort(v.begin(), v.end(), [&order](const Indexed& l, const Indexed& r) {
+                const int cmp = order.Compare(l.version, r.version);
+                return cmp < 0 || (cmp == 0 && l.text < r.text);
+            });
+            v.erase(std::unique(v.begin(), v.end(), [](const Indexed& l, const Indexed& r) {
+                return l.text == r.text;
+            }), v.end());
+        }
+        return ref;
+    }
+
+    std::vector<std::string> texts(const IndexRange& range) {
+        std::vector<std::string> res;
+        for (const auto v : range) res.push_back(v.Text());
+        return res;
+    }
+
+    std::string text(const IndexedVersion& v) {
+        return v ? v.Text() : "<none>";
+    }
+
+    struct TempFile {
+        std::string path = "version_index_tests.idx";
+        ~TempFile() { std::remove(path.c_str()); }
+    };
+
+    BOOST_AUTO_TEST_CASE(queries_match_sorted_reference) {
+        VersionIndexBuilder builder;
+        const auto ref = populate(builder, 5000, 40);
+        TempFile file;
+        builder.Write(file.path);
+        const VersionIndex index(file.path);
+
+        BOOST_CHECK_EQUAL(index.PackageCount(), ref.size());
+        size_t count = 0;
+        const VersionOrder order(BuildMetadata::ignored);
+        const VersionData low = p.Parse("1.2.0"), high = p.Parse("3.0.0-rc");
+        for (const auto& versions : ref) {
+            const auto& package = versions.first;
+            const auto& v = versions.second;
+            count += v.size();
+
+            std::vector<std::string> all, in_range;
+            std::string latest = "<none>", latest_prerelease = "<none>", latest_major = "<none>";
+            for (const auto& i : v) {
+                all.push_back(i.text);
+                latest_prerelease = i.text;
+                if (i.version.prerelease_ids.empty()) latest = i.text;
+                if (i.version.major == 2 && i.version.prerelease_ids.empty()) latest_major = i.text;
+                if (order.Compare(i.version, low) >= 0 && order.Compare(i.version, high) < 0) {
+                    in_range.push_back(i.text);
+                }
+            }
+
+            BOOST_CHECK(texts(index.All(package)) == all);
+            BOOST_CHECK(texts(index.Range(package, low, high)) == in_range);
+            BOOST_CHECK(texts(index.Range(package, high, low)).empty());
+            BOOST_CHECK_EQUAL(text(index.Latest(package)), latest);
+            BOOST_CHECK_EQUAL(text(index.Latest(package, true)), latest_prerelease);
+            BOOST_CHECK_EQUAL(text(index.LatestInMajor(package, 2)), latest_major);
+            for (const auto& i : v) {
+                const auto found = index.Find(package, i.text);
+                BOOST_REQUIRE(found);
+                BOOST_CHECK_EQUAL(found.Text(), i.text);
+                BOOST_CHECK(found.Key() == WireVersion(Encode(i.version).data(), Encode(i.version).size()));
+            }
+        }
+        BOOST_CHECK_EQUAL(index.VersionCount(), count);
+        BOOST_CHECK(index.All("missing").empty());
+        BOOST_CHECK(!index.Latest("missing"));
+    }
+
+    BOOST_AUTO_TEST_CASE(find_matches_exact_text) {
+        VersionIndexBuilder builder;
+        builder.Add("a", "1.0.0+linux");
+        builder.Add("a", "1.0.0+mac");
+        builder.Add("a", "1.0.0+linux");
+        builder.Add("a", "1.0.0-rc.1");
+        builder.Add("b", "1.0.0");
+        BOOST_CHECK_THROW(builder.Add("a", "1.0"), ParseError);
+        const auto bytes = builder.Build();
+        BOOST_CHECK_EQUAL(builder.Size(), 4u);
+        const VersionIndex index(bytes.data(), bytes.size());
+
+        BOOST_CHECK_EQUAL(text(index.Find("a", "1.0.0+mac")), "1.0.0+mac");
+        BOOST_CHECK_EQUAL(text(index.Find("a", "1.0.0+linux")), "1.0.0+linux");
+        BOOST_CHECK(!index.Find("a", "1.0.0"));
+        BOOST_CHECK(!index.Find("a", "1.0.0+win"));
+        BOOST_CHECK(!index.Find("a", "not a version"));
+        BOOST_CHECK(!index.Find("c", "1.0.0"));
+        BOOST_CHECK_EQUAL(index.All("a").size(), 3u);
+        BOOST_CHECK_EQUAL(index.Find("a", "1.0.0+mac").Data().build_ids.at(0), "mac");
+        BOOST_CHECK(!index.Latest("a").Data().build_ids.empty());
+        BOOST_CHECK_EQUAL(text(index.LatestInMajor("a", 1, true)), "1.0.0+mac");
+        BOOST_CHECK(!index.LatestInMajor("a", 0, true));
+    }
+
+    BOOST_AUTO_TEST_CASE(empty_index) {
+        const auto bytes = VersionIndexBuilder().Build();
+        const VersionIndex index(bytes.data(), bytes.size());
+        BOOST_CHECK_EQUAL(index.PackageCount(), 0u);
+        BOOST_CHECK(!index.Latest(""));
+        BOOST_CHECK(index.Range("", p.Parse("0.0.0"), p.Parse("1.0.0")).empty());
+    }
+
+    BOOST_AUTO_TEST_CASE(corrupt_index_is_rejected) {
+        VersionIndexBuilder builder;
+        builder.Add("a", "1.0.0");
+        builder.Add("a", "2.0.0");
+        const auto bytes = builder.Build();
+
+        for (size_t size = 0; size < bytes.size(); ++size) {
+            BOOST_CHECK_THROW(VersionIndex(bytes.data(), size), ParseError);
+        }
+        auto b = bytes;
+        b[0] = 'X';
+        BOOST_CHECK_THROW(VersionIndex(b.data(), b.size()), ParseError);
+
+        // Corrupting any byte must never result in a read outside the index.
+        for (size_t i = 8; i < bytes.size(); ++i) {
+            for (const uint8_t value : { uint8_t{ 0x00 }, uint8_t{ 0x7f }, uint8_t{ 0xff } }) {
+                b = bytes;
+                b[i] = value;
+                try {
+                    const VersionIndex index(b.data(), b.size());
+                    for (const auto v : index.All("a")) v.Key().Major();
+                    index.Latest("a", true);
+                    index.LatestInMajor("a", 1);
+                    index.Find("a", "2.0.0");
+                } catch (const ParseError&) {}
+            }
+        }
+
+        TempFile file;
+        BOOST_CHECK_THROW(VersionIndex("no/such/index"), std::system_error);
+        std::FILE* f = std::fopen(file.path.c_str(), "wb");
+        std::fwrite(bytes.data(), 1, bytes.size() / 2, f);
+        std::fclose(f);
+        BOOST_CHECK_THROW(VersionIndex(file.path), ParseError);
+    }
+}}
@@ -68,6 +68,22 @@ namespace vsn { namespace semver {
         CHECK_RT("1.2.3-alpha.1.2.3+build.314");
 	}
 
+	BOOST_AUTO_TEST_CASE(test_to_string) {
+        BOOST_CHECK_EQUAL(v("1.2.3").ToString(), "1.2.3");
+        BOOST_CHECK_EQUAL(v("1.2.3-alpha.1.2.3+build.314").ToString(), "1.2.3-alpha.1.2.3+build.314");
+        BOOST_CHECK_EQUAL(v().ToString(), "0.0.0");
+
+        // Modified versions must not reuse source text of the original.
+        auto p = v("1.2.3-alpha.1+build.314");
+        BOOST_CHECK_EQUAL(p.SetMajor(4).ToString(), "4.2.3-alpha.1+build.314");
+        BOOST_CHECK_EQUAL(p.SetBuild("b2").ToString(), "1.2.3-alpha.1+b2");
+        BOOST_CHECK_EQUAL(p.IncMinor().ToString(), "1.3.0");
+        std::stringstream ss;
+        ss << p.ResetPreRelease("rc.1");
+        BOOST_CHECK_EQUAL(ss.str(), "1.2.3-rc.1");
+        BOOST_CHECK_EQUAL(p.ToString(), "1.2.3-alpha.1+build.314");
+	}
+
 	BOOST_AUTO_TEST_CASE(test_accessors) {
         auto p = v("1.2.3-pre.rel.1+test.build.321");
         BOOST_CHECK_EQUAL(p.Major(), 1);
@@ -77,4 +93,25 @@ namespace vsn { namespace semver {
         BOOST_CHECK_EQUAL(p.Build(), "test.build.321");
 	}
 
-}}
\ No newline at end of file
+	BOOST_AUTO_TEST_CASE(test_static_dispatch) {
+        using sv = StaticVersion;
+        // Static dispatch versions carry no comparator pointer
+        static_assert(sizeof(sv) < sizeof(v), "static dispatch version must be smaller");
+
+        BOOST_CHECK(sv("1.0.0-alpha") < sv("1.0.0-alpha.1"));
+        BOOST_CHECK(sv("1.0.0-beta.2") < sv("1.0.0-beta.11"));
+        BOOST_CHECK(sv("1.0.0-rc.1") <= sv("1.0.0"));
+        BOOST_CHECK(sv("1.0.0+rc.1") == sv("1.0.0+rc22"));
+        BOOST_CHECK(sv("1.0.0+rc.1") != sv("1.0.0-rc22"));
+        BOOST_CHECK(sv("2.0.0") > sv("1.9.9"));
+        BOOST_CHECK(sv("2.0.0") >= sv("2.0.0"));
+
+        sv p("1.2.3-alpha.1+build.314");
+        sv p2 = p.IncMinor().SetPreRelease("rc.1");
+        BOOST_CHECK_EQUAL(p2.ToString(), "1.3.0-rc.1");
+        BOOST_CHECK(p < p2);
+        std::stringstream ss;
+        ss << p;
+        BOOST_CHECK_EQUAL(ss.str(), "1.2.3-alpha.1+build.314");
+	}
+}}
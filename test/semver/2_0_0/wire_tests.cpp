@@ -0,0 +1,157 @@
+
+/*
+The MIT License (MIT)
+
+Copyright (c) 2017 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#define BOOST_TEST_MODULE semver200_wire_tests
+
+#include <boost/test/unit_test.hpp>
+#include <versioning/semver/2_0_0/comparator.h>
+#include <versioning/semver/2_0_0/corpus.h>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/wire.h>
+#include "../../../src/exceptions.h"
+
+namespace vsn { namespace semver {
+    Parser p;
+    Comparator c;
+
+    using Bytes = std::vector<uint8_t>;
+
+    bool same(const VersionData& l, const VersionData& r) {
+        return l.major == r.major && l.minor == r.minor && l.patch == r.patch &&
+               l.prerelease_ids == r.prerelease_ids && l.build_ids == r.build_ids;
+    }
+
+    ParseErrorReason decode_error(const Bytes& b) {
+        try {
+            Decode(b.data(), b.size());
+        } catch (const ParseError& e) {
+            BOOST_CHECK_THROW(WireVersion(b.data(), b.size()), ParseError);
+            return e.Reason();
+        }
+        BOOST_ERROR("decoding should fail");
+        return ParseErrorReason::other;
+    }
+
+    BOOST_AUTO_TEST_CASE(layout) {
+        BOOST_CHECK(Encode(p.Parse("1.2.3")) == Bytes({ 1, 1, 2, 3, 0, 0 }));
+        BOOST_CHECK(Encode(p.Parse("1.200.3")) == Bytes({ 1, 1, 0xc8, 0x01, 3, 0, 0 }));
+        BOOST_CHECK(Encode(p.Parse("0.0.1-rc.10+b")) ==
+                    Bytes({ 1, 0, 0, 1, 2, 0x02, 2, 'r', 'c', 2, '1', '0', 1, 1, 'b' }));
+    }
+
+    BOOST_AUTO_TEST_CASE(round_trip) {
+        CorpusProfile profile;
+        profile.prerelease_share = 0.5;
+        profile.build_share = 0.5;
+        profile.max_prerelease_ids = 12;
+        CorpusGenerator gen(profile);
+        Bytes stream;
+        std::vector<VersionData> versions;
+        for (int i = 0; i < 5000; ++i) {
+            auto v = p.Parse(gen.Next());
+            Encode(v, stream);
+            versions.push_back(std::move(v));
+        }
+        versions.push_back(p.Parse("2147483647.2147483647.2147483647-0.99999999999999999999.a-b"));
+        Encode(versions.back(), stream);
+
+        // Concatenated encodings decode in turn.
+        const uint8_t* data = stream.data();
+        size_t left = stream.size();
+        VersionData reused;
+        for (const auto& v : versions) {
+            size_t consumed = 0;
+            auto d = Decode(data, left, &consumed);
+            BOOST_CHECK(same(d, v));
+            Decode(data, left, reused);
+            BOOST_CHECK(same(reused, v));
+            WireVersion w(data, left);
+            BOOST_CHECK_EQUAL(w.Size(), consumed);
+            BOOST_CHECK_EQUAL(w.Major(), v.major);
+            BOOST_CHECK_EQUAL(w.PreReleaseCount(), v.prerelease_ids.size());
+            BOOST_CHECK_EQUAL(w.BuildCount(), v.build_ids.size());
+            BOOST_CHECK(same(w.ToData(), v));
+            data += consumed;
+            left -= consumed;
+        }
+        BOOST_CHECK_EQUAL(left, 0u);
+    }
+
+    BOOST_AUTO_TEST_CASE(compare_encoded) {
+        std::vector<VersionData> versions;
+        for (const char* s : { "1.0.0-alpha", "1.0.0-alpha.1", "1.0.0-alpha.beta", "1.0.0-beta", "1.0.0-beta.2",
+                               "1.0.0-beta.11", "1.0.0-rc.1", "1.0.0", "1.0.0+build", "1.0.0-1", "1.0.0-a-b",
+                               "1.0.0-alpha.10", "1.0.0-alpha.9", "1.0.0-alphabet", "2.0.0", "1.1.0", "1.0.1" }) {
+            versions.push_back(p.Parse(s));
+        }
+        CorpusProfile profile;
+        profile.prerelease_share = 0.7;
+        profile.max_major = 2;
+        profile.max_minor = 2;
+        profile.max_patch = 2;
+        CorpusGenerator gen(profile);
+        for (int i = 0; i < 300; ++i) versions.push_back(p.Parse(gen.Next()));
+
+        std::vector<Bytes> encoded;
+        for (const auto& v : versions) encoded.push_back(Encode(v));
+        for (size_t i = 0; i < versions.size(); ++i) {
+            WireVersion l(encoded[i].data(), encoded[i].size());
+            for (size_t j = 0; j < versions.size(); ++j) {
+                WireVersion r(encoded[j].data(), encoded[j].size());
+                BOOST_CHECK_EQUAL(WireVersion::Compare(l, r), c.Compare(versions[i], versions[j]));
+            }
+        }
+
+        Bytes a = Encode(p.Parse("1.0.0-rc.1")), b = Encode(p.Parse("1.0.0-rc.1+build"));
+        WireVersion wa(a.data(), a.size()), wb(b.data(), b.size());
+        BOOST_CHECK(wa == wb);
+        BOOST_CHECK(!(wa < wb));
+        BOOST_CHECK(wa <= wb && wa >= wb);
+    }
+
+    BOOST_AUTO_TEST_CASE(malformed) {
+        const Bytes valid = Encode(p.Parse("1.2.3-rc.10+b"));
+        for (size_t n = 0; n < valid.size(); ++n) {
+            BOOST_CHECK(decode_error(Bytes(valid.begin(), valid.begin() + n)) == ParseErrorReason::missing_component);
+        }
+
+        BOOST_CHECK(decode_error({ 2, 1, 2, 3, 0, 0 }) == ParseErrorReason::other);
+        BOOST_CHECK(decode_error({ 1, 0x80, 0x80, 0x80, 0x80, 0x08, 2, 3, 0, 0 }) == ParseErrorReason::overflow);
+        BOOST_CHECK(decode_error({ 1, 0xff, 0xff, 0xff, 0xff, 0x7f, 2, 3, 0, 0 }) == ParseErrorReason::overflow);
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 0xff, 0xff, 0xff, 0x7f, 0 }) == ParseErrorReason::missing_component);
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 1, 0, 0, 0 }) == ParseErrorReason::empty_identifier);
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 1, 0, 1, '.', 0 }) == ParseErrorReason::invalid_character);
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 0, 1, 1, '+' }) == ParseErrorReason::invalid_character);
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 1, 1, 2, '0', '1', 0 }) == ParseErrorReason::leading_zero);
+        // Identifier type bits must match identifiers, and unused bits must be clear.
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 1, 1, 1, 'a', 0 }) == ParseErrorReason::other);
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 1, 0, 1, '1', 0 }) == ParseErrorReason::other);
+        BOOST_CHECK(decode_error({ 1, 1, 2, 3, 1, 2, 1, 'a', 0 }) == ParseErrorReason::other);
+
+        // Build identifiers may have leading zeros.
+        Bytes build = { 1, 1, 2, 3, 0, 1, 2, '0', '1' };
+        BOOST_CHECK_EQUAL(Decode(build.data(), build.size()).build_ids.front(), "01");
+    }
+}}
@@ -0,0 +1,105 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// Write a generated corpus of version strings, one per line.
+//
+// Usage: semver_corpus [--count N] [--seed N] [--prerelease SHARE] [--prerelease-ids MIN MAX]
+//                      [--numeric SHARE] [--tags SHARE] [--id-length MIN MAX] [--build SHARE] [--sha SHARE]
+//                      [--malformed SHARE] [--max-major N] [--max-minor N] [--max-patch N] [--output FILE]
+//
+// Shares are probabilities in [0, 1]; defaults are those of vsn::semver::CorpusProfile.
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <versioning/semver/2_0_0/corpus.h>
+
+using namespace vsn::semver;
+
+namespace {
+    struct Args {
+        int argc;
+        char** argv;
+        int i;
+
+        const char* value(const std::string& option) {
+            if (i + 1 >= argc) throw std::runtime_error("missing value for " + option);
+            return argv[++i];
+        }
+    };
+}
+
+int main(int argc, char* argv[]) {
+    CorpusProfile profile;
+    unsigned long long count = 1000000;
+    std::string output;
+
+    try {
+        for (Args a{ argc, argv, 1 }; a.i < argc; ++a.i) {
+            std::string opt = argv[a.i];
+            if (opt == "--count") count = std::strtoull(a.value(opt), nullptr, 10);
+            else if (opt == "--seed") profile.seed = std::strtoull(a.value(opt), nullptr, 10);
+            else if (opt == "--prerelease") profile.prerelease_share = std::atof(a.value(opt));
+            else if (opt == "--prerelease-ids") {
+                profile.min_prerelease_ids = std::atoi(a.value(opt));
+                profile.max_prerelease_ids = std::atoi(a.value(opt));
+            }
+            else if (opt == "--numeric") profile.numeric_id_share = std::atof(a.value(opt));
+            else if (opt == "--tags") profile.common_tag_share = std::atof(a.value(opt));
+            else if (opt == "--id-length") {
+                profile.min_id_length = std::atoi(a.value(opt));
+                profile.max_id_length = std::atoi(a.value(opt));
+            }
+            else if (opt == "--build") profile.build_share = std::atof(a.value(opt));
+            else if (opt == "--sha") profile.sha_build_share = std::atof(a.value(opt));
+            else if (opt == "--malformed") profile.malformed_share = std::atof(a.value(opt));
+            else if (opt == "--max-major") profile.max_major = std::atoi(a.value(opt));
+            else if (opt == "--max-minor") profile.max_minor = std::atoi(a.value(opt));
+            else if (opt == "--max-patch") profile.max_patch = std::atoi(a.value(opt));
+            else if (opt == "--output") output = a.value(opt);
+            else throw std::runtime_error("unknown option " + opt);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    FILE* out = output.empty() ? stdout : std::fopen(output.c_str(), "wb");
+    if (!out) {
+        std::cerr << "cannot open " << output << "\n";
+        return 1;
+    }
+
+    CorpusGenerator gen(profile);
+    std::string line;
+    for (unsigned long long i = 0; i < count; ++i) {
+        gen.Next(line);
+        line += '\n';
+        std::fwrite(line.data(), 1, line.size(), out);
+    }
+    return (out == stdout ? std::fflush(out) : std::fclose(out)) == 0 ? 0 : 1;
+}
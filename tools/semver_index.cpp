@@ -0,0 +1,156 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2015 Marko Zivanovic
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+// Build a version index file, or query one.
+//
+// Usage: semver_index build [--input FILE] --output FILE [--strict]
+//        semver_index latest INDEX PACKAGE [--major N] [--prerelease]
+//        semver_index range INDEX PACKAGE LOW HIGH
+//        semver_index find INDEX PACKAGE VERSION
+//
+// Input of build has one "<package> <version>" pair per line; invalid versions are skipped with a warning,
+// or fail the build with --strict. Queries print matching versions, one per line, and exit with 1 if there
+// are none.
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <versioning/semver/2_0_0/parser.h>
+#include <versioning/semver/2_0_0/version_index.h>
+#include "../src/exceptions.h"
+
+using namespace vsn::semver;
+
+namespace {
+    struct Args {
+        int argc;
+        char** argv;
+        int i;
+
+        const char* value(const std::string& option) {
+            if (i + 1 >= argc) throw std::runtime_error("missing value for " + option);
+            return argv[++i];
+        }
+    };
+
+    int build(Args a) {
+        std::string input, output;
+        bool strict = false;
+        for (; a.i < a.argc; ++a.i) {
+            std::string opt = a.argv[a.i];
+            if (opt == "--input") input = a.value(opt);
+            else if (opt == "--output") output = a.value(opt);
+            else if (opt == "--strict") strict = true;
+            else throw std::runtime_error("unknown option " + opt);
+        }
+        if (output.empty()) throw std::runtime_error("missing --output");
+
+        std::ifstream file;
+        if (!input.empty()) {
+            file.open(input);
+            if (!file) throw std::runtime_error("cannot open " + input);
+        }
+        std::istream& in = input.empty() ? std::cin : file;
+
+        VersionIndexBuilder builder;
+        std::string line;
+        size_t line_number = 0, skipped = 0;
+        while (std::getline(in, line)) {
+            ++line_number;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+            const auto space = line.find(' ');
+            std::string error = "missing version";
+            if (space != std::string::npos) {
+                try {
+                    builder.Add(line.substr(0, space), line.substr(space + 1));
+                    continue;
+                }
+                catch (const vsn::ParseError& e) {
+                    error = e.what();
+                }
+            }
+            const std::string message = "line " + std::to_string(line_number) + ": " + error;
+            if (strict) throw std::runtime_error(message);
+            std::cerr << message << "\n";
+            ++skipped;
+        }
+
+        builder.Write(output);
+        std::cerr << builder.Size() << " versions indexed, " << skipped << " lines skipped\n";
+        return 0;
+    }
+
+    int print(const IndexedVersion& v) {
+        if (!v) return 1;
+        std::cout << v.Text() << "\n";
+        return 0;
+    }
+
+    int query(const std::string& mode, Args a) {
+        if (a.i + 2 > a.argc) throw std::runtime_error("missing index or package");
+        const VersionIndex index(a.argv[a.i]);
+        const std::string package = a.argv[a.i + 1];
+        a.i += 2;
+
+        if (mode == "latest") {
+            bool prerelease = false, in_major = false;
+            int major = 0;
+            for (; a.i < a.argc; ++a.i) {
+                std::string opt = a.argv[a.i];
+                if (opt == "--prerelease") prerelease = true;
+                else if (opt == "--major") {
+                    in_major = true;
+                    major = std::stoi(a.value(opt));
+                }
+                else throw std::runtime_error("unknown option " + opt);
+            }
+            return print(in_major ? index.LatestInMajor(package, major, prerelease)
+                                  : index.Latest(package, prerelease));
+        }
+        if (mode == "range") {
+            if (a.i + 2 != a.argc) throw std::runtime_error("expected LOW and HIGH");
+            Parser parser;
+            const auto versions = index.Range(package, parser.Parse(a.argv[a.i]), parser.Parse(a.argv[a.i + 1]));
+            for (const auto v : versions) print(v);
+            return versions.empty() ? 1 : 0;
+        }
+        if (a.i + 1 != a.argc) throw std::runtime_error("expected VERSION");
+        return print(index.Find(package, a.argv[a.i]));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) throw std::runtime_error("expected build, latest, range or find");
+        const std::string mode = argv[1];
+        if (mode == "build") return build(Args{ argc, argv, 2 });
+        if (mode == "latest" || mode == "range" || mode == "find") return query(mode, Args{ argc, argv, 2 });
+        throw std::runtime_error("unknown mode " + mode);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+}